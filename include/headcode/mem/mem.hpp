@@ -10,8 +10,16 @@
 #define HEADCODE_SPACE_MEM_MEM_HPP
 
 
+#include "mem_allocator.hpp"
+#include "mem_canonical.hpp"
+#include "mem_canonical_monitor.hpp"
+#include "mem_canonical_view.hpp"
 #include "mem_core.hpp"
+#include "mem_hex_format.hpp"
+#include "mem_hex_stream.hpp"
 #include "mem_manipulator.hpp"
+#include "mem_simd.hpp"
+#include "mem_thread_pool.hpp"
 #include "version.hpp"
 
 
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#ifndef HEADCODE_SPACE_MEM_MEM_ALLOCATOR_HPP
+#define HEADCODE_SPACE_MEM_MEM_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief   The headcode mem namespace
+ */
+namespace headcode::mem {
+
+/**
+ * @brief   An allocator which default-initializes instead of value-initializing.
+ * std::vector::resize() value-initializes the new elements, which for std::byte means zero filling memory that is
+ * about to be overwritten anyway. With this allocator resize() leaves trivial elements uninitialized, so bytes
+ * decoded into a resized vector are written exactly once:
+ * @code
+ *      headcode::mem::ByteBuffer memory;
+ *      headcode::mem::HexToMemory(memory, hex);        // no zero fill ahead of the decoding
+ * @endcode
+ * All other constructions are forwarded to the underlying allocator.
+ * @tparam  T           the type allocated
+ * @tparam  Allocator   the underlying allocator
+ */
+template <class T, class Allocator = std::allocator<T>>
+class DefaultInitAllocator : public Allocator {
+
+    using Traits = std::allocator_traits<Allocator>;       //!< @brief The traits of the underlying allocator.
+
+public:
+    /**
+     * @brief   The same allocator for another type.
+     * @tparam  U       the other type
+     */
+    template <class U>
+    struct rebind {
+        using other = DefaultInitAllocator<U, typename Traits::template rebind_alloc<U>>;  //!< @brief Rebound.
+    };
+
+    using Allocator::Allocator;
+
+    /**
+     * @brief   Default-initializes an element.
+     * @param   p       where to construct the element
+     */
+    template <class U>
+    void construct(U * p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+        ::new (static_cast<void *>(p)) U;
+    }
+
+    /**
+     * @brief   Constructs an element with arguments by the underlying allocator.
+     * @param   p       where to construct the element
+     * @param   args    the constructor arguments
+     */
+    template <class U, class... Args>
+    void construct(U * p, Args &&... args) {
+        Traits::construct(static_cast<Allocator &>(*this), p, std::forward<Args>(args)...);
+    }
+};
+
+/**
+ * @brief   A memory block which is not zero filled when it grows.
+ * This is accepted by all functions decoding into a std::vector<std::byte> passed in.
+ */
+using ByteBuffer = std::vector<std::byte, DefaultInitAllocator<std::byte>>;
+
+}
+
+
+#endif
@@ -0,0 +1,931 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#ifndef HEADCODE_SPACE_MEM_MEM_CANONICAL_HPP
+#define HEADCODE_SPACE_MEM_MEM_CANONICAL_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "mem_simd.hpp"
+
+
+/**
+ * @brief   The headcode mem namespace
+ */
+namespace headcode::mem {
+
+/**
+ * @brief   Layout of the canonical representation of memory.
+ * A canonical layout is any type with these four static constexpr members. A line shows the offset ("0x" and
+ * kOffsetDigits hex digits), kBytesPerLine bytes as hex in groups of kGroupSize bytes and optionally the same
+ * bytes as ASCII. The default layout is the one of CharArrayToCanonicalString:
+ * @code
+ *      0x0000000000000020   20 21 22 23 24 25 26 27  28 29 2a 2b 2c 2d 2e 2f   | !"#$%&' ()*+,-./|
+ * @endcode
+ * CanonicalLayout<32, 4, 8, false> gives:
+ * @code
+ *      0x00000020   20 21 22 23  24 25 26 27  28 29 2a 2b  2c 2d 2e 2f  30 31 32 33  34 35 36 37  ...
+ * @endcode
+ * @tparam  BytesPerLine    bytes per line, a multiple of 16
+ * @tparam  GroupSize       bytes per group, must divide BytesPerLine
+ * @tparam  OffsetDigits    hex digits of the offset (1-16), higher digits are cut off
+ * @tparam  Ascii           show the ASCII column
+ */
+template <std::uint64_t BytesPerLine = 16, std::uint64_t GroupSize = 8, std::uint64_t OffsetDigits = 16,
+          bool Ascii = true>
+struct CanonicalLayout {
+    static constexpr std::uint64_t kBytesPerLine = BytesPerLine;    //!< @brief Bytes per line.
+    static constexpr std::uint64_t kGroupSize = GroupSize;          //!< @brief Bytes per group.
+    static constexpr std::uint64_t kOffsetDigits = OffsetDigits;    //!< @brief Hex digits of the offset.
+    static constexpr bool kAscii = Ascii;                           //!< @brief Show the ASCII column.
+};
+
+/**
+ * @brief   The layout of CharArrayToCanonicalString: 16 bytes in 2 groups, 16 offset digits, ASCII column.
+ */
+using CanonicalLayoutDefault = CanonicalLayout<>;
+
+/**
+ * @brief   32 bytes per line in 4 groups of 8 bytes.
+ */
+using CanonicalLayout32 = CanonicalLayout<32>;
+
+/**
+ * @brief   64 bytes per line in 8 groups of 8 bytes.
+ */
+using CanonicalLayout64 = CanonicalLayout<64>;
+
+/**
+ * @brief   How the lines of two memory blocks are put next to each other in a canonical diff.
+ */
+enum class CanonicalDiffStyle : unsigned int {
+    kInterleaved = 0,   //!< @brief Differing lines of the first block ("-") followed by those of the second ("+").
+    kSideBySide = 1     //!< @brief The line of the first block, " | " if they differ, the line of the second block.
+};
+
+/**
+ * @brief   The column positions of a canonical layout, relative to the end of the indent.
+ * @tparam  Layout          the canonical layout
+ */
+template <class Layout>
+struct CanonicalGeometry {
+
+    static_assert((Layout::kBytesPerLine > 0) && (Layout::kBytesPerLine % 16 == 0),
+                  "Canonical layout bytes per line must be a multiple of 16.");
+    static_assert((Layout::kGroupSize > 0) && (Layout::kBytesPerLine % Layout::kGroupSize == 0),
+                  "Canonical layout group size must divide the bytes per line.");
+    static_assert((Layout::kOffsetDigits > 0) && (Layout::kOffsetDigits <= 16),
+                  "Canonical layout offset digits must be within 1 and 16.");
+
+    static constexpr std::uint64_t kGroups = Layout::kBytesPerLine / Layout::kGroupSize;   //!< @brief Groups.
+    static constexpr std::uint64_t kData = 2 + Layout::kOffsetDigits + 3;                  //!< @brief Hex column.
+    static constexpr std::uint64_t kHexSize = Layout::kBytesPerLine * 3 - 1 + kGroups - 1; //!< @brief Hex chars.
+    static constexpr std::uint64_t kAsciiOpen = kData + kHexSize + 3;                      //!< @brief '|'
+    static constexpr std::uint64_t kAscii = kAsciiOpen + 1;                                //!< @brief ASCII column.
+    static constexpr std::uint64_t kAsciiSize = Layout::kBytesPerLine + kGroups - 1;       //!< @brief ASCII chars.
+    static constexpr std::uint64_t kAsciiClose = kAscii + kAsciiSize;                      //!< @brief '|'
+
+    /**
+     * @brief   Size of a line (without indent) including the '\n'.
+     */
+    static constexpr std::uint64_t kLineSize = Layout::kAscii ? kAsciiClose + 2 : kData + kHexSize + 1;
+
+    /**
+     * @brief   Returns the position of the hex chars of a byte within the hex column.
+     * @param   i           the byte in the line
+     * @return  the position of the first hex char
+     */
+    static constexpr std::uint64_t HexPosition(std::uint64_t i) {
+        return i * 3 + i / Layout::kGroupSize;
+    }
+
+    /**
+     * @brief   Returns the position of the char of a byte within the ASCII column.
+     * @param   i           the byte in the line
+     * @return  the position of the ASCII char
+     */
+    static constexpr std::uint64_t AsciiPosition(std::uint64_t i) {
+        return i + i / Layout::kGroupSize;
+    }
+};
+
+/**
+ * @brief   Convert a number to a hex presentation.
+ * Each byte of the number is looked up in simd::kByteToHex, the most significant one first.
+ * @param   array       the char array to write must be a minimum of 16 bytes
+ * @param   number      the number to write
+ */
+inline void HexNumberToCharArray(char * array, std::uint64_t number) {
+    for (unsigned int i = 0; i < 8; ++i) {
+        auto const & hex = simd::kByteToHex[(number >> (56 - i * 8)) & 0xff];
+        array[i * 2] = hex[0];
+        array[i * 2 + 1] = hex[1];
+    }
+}
+
+/**
+ * @brief   Adds a value to a number written by HexNumberToCharArray and updates its hex chars.
+ * Only the digits changed by the sum are written again: the carry is followed byte by byte, so counting up line
+ * offsets rewrites the lowest 2 digits on most lines and one more pair per byte the carry runs into. The number
+ * wraps around at 16 digits.
+ * @param   array       the 16 hex chars of the number
+ * @param   number      the number the hex chars show
+ * @param   value       the value to add
+ * @return  the new number
+ */
+inline std::uint64_t AddToHexCharArray(char * array, std::uint64_t number, std::uint64_t value) {
+    auto sum = number + value;
+    auto changed = number ^ sum;
+    for (unsigned int i = 0; (i < 8) && ((changed >> (i * 8)) != 0); ++i) {
+        auto const & hex = simd::kByteToHex[(sum >> (i * 8)) & 0xff];
+        array[14 - i * 2] = hex[0];
+        array[15 - i * 2] = hex[1];
+    }
+    return sum;
+}
+
+/**
+ * @brief   Creates the template of a canonical line: indent, "0x", the delimiters and blanks.
+ * @tparam  Layout      the canonical layout
+ * @param   indent      indent of each line
+ * @return  The template line.
+ */
+template <class Layout = CanonicalLayoutDefault>
+inline std::string CanonicalLineTemplate(std::string const & indent) {
+
+    using Geometry = CanonicalGeometry<Layout>;
+
+    std::string templ(indent.size() + Geometry::kLineSize, ' ');
+    std::copy(indent.begin(), indent.end(), templ.begin());
+
+    auto line = templ.data() + indent.size();
+    line[0] = '0';
+    line[1] = 'x';
+    if constexpr (Layout::kAscii) {
+        line[Geometry::kAsciiOpen] = '|';
+        line[Geometry::kAsciiClose] = '|';
+    }
+    line[Geometry::kLineSize - 1] = '\n';
+
+    return templ;
+}
+
+/**
+ * @brief   The simd functions of the headcode mem namespace.
+ */
+namespace simd {
+
+/**
+ * @brief   Byte shuffle masks spreading the hex and ASCII chars of a line over their columns.
+ * A line is read in blocks of 16 bytes. Each block gives 2 registers of 16 hex chars and 1 register of 16 ASCII
+ * chars. A column is written in vectors of 16 chars, the last one ending flush with the column. Each vector
+ * picks its chars from 2 neighbouring registers (mask entry 0x80 yields 0) and or-s in the spaces.
+ * @tparam  Layout          the canonical layout
+ */
+template <class Layout>
+struct CanonicalShuffle {
+
+    using Geometry = CanonicalGeometry<Layout>;                                             //!< @brief Columns.
+
+    static constexpr std::uint64_t kHexRegisters = Layout::kBytesPerLine / 8;              //!< @brief Hex chars.
+    static constexpr std::uint64_t kAsciiRegisters = Layout::kBytesPerLine / 16;           //!< @brief ASCII chars.
+    static constexpr std::uint64_t kHexVectors = (Geometry::kHexSize + 15) / 16;           //!< @brief Hex column.
+    static constexpr std::uint64_t kAsciiVectors = (Geometry::kAsciiSize + 15) / 16;       //!< @brief ASCII column.
+
+    /**
+     * @brief   The masks of the vectors of a single column.
+     * @tparam  Vectors     number of vectors of the column
+     */
+    template <std::uint64_t Vectors>
+    struct Column {
+        std::array<std::uint64_t, Vectors> start{};                 //!< @brief Position of the vector.
+        std::array<std::uint64_t, Vectors> first{};                 //!< @brief First register to pick from.
+        std::array<std::array<char, 16>, Vectors> from_first{};     //!< @brief Picks from the first register.
+        std::array<std::array<char, 16>, Vectors> from_second{};    //!< @brief Picks from the next register.
+        std::array<std::array<char, 16>, Vectors> spaces{};         //!< @brief Spaces between the chars.
+
+        /**
+         * @brief   Creates the masks of a column.
+         * @param   source      the register char (16 per register) shown at each position, -1 for a space
+         * @return  the masks
+         */
+        template <std::uint64_t Size>
+        static constexpr Column Make(std::array<std::int64_t, Size> const & source) {
+            Column column;
+            for (std::uint64_t k = 0; k < Vectors; ++k) {
+                column.start[k] = std::min<std::uint64_t>(k * 16, Size - 16);
+                for (std::uint64_t j = 16; j > 0; --j) {
+                    if (source[column.start[k] + j - 1] >= 0) {
+                        column.first[k] = static_cast<std::uint64_t>(source[column.start[k] + j - 1]) / 16;
+                    }
+                }
+                for (std::uint64_t j = 0; j < 16; ++j) {
+                    auto from = source[column.start[k] + j];
+                    column.from_first[k][j] = static_cast<char>(0x80);
+                    column.from_second[k][j] = static_cast<char>(0x80);
+                    column.spaces[k][j] = (from < 0) ? ' ' : '\0';
+                    if (from >= 0) {
+                        auto & mask = (static_cast<std::uint64_t>(from) / 16 == column.first[k]) ? column.from_first
+                                                                                                 : column.from_second;
+                        mask[k][j] = static_cast<char>(from % 16);
+                    }
+                }
+            }
+            return column;
+        }
+    };
+
+    Column<kHexVectors> hex;            //!< @brief Masks of the hex column.
+    Column<kAsciiVectors> ascii;        //!< @brief Masks of the ASCII column.
+
+    /**
+     * @brief   Creates the shuffle masks.
+     * @return  The shuffle masks for the canonical layout.
+     */
+    static constexpr CanonicalShuffle Make() {
+
+        std::array<std::int64_t, Geometry::kHexSize> hex_source{};
+        std::array<std::int64_t, Geometry::kAsciiSize> ascii_source{};
+        for (auto & source : hex_source) {
+            source = -1;
+        }
+        for (auto & source : ascii_source) {
+            source = -1;
+        }
+        for (std::uint64_t i = 0; i < Layout::kBytesPerLine; ++i) {
+            hex_source[Geometry::HexPosition(i)] = static_cast<std::int64_t>(i * 2);
+            hex_source[Geometry::HexPosition(i) + 1] = static_cast<std::int64_t>(i * 2 + 1);
+            ascii_source[Geometry::AsciiPosition(i)] = static_cast<std::int64_t>(i);
+        }
+
+        CanonicalShuffle shuffle;
+        shuffle.hex = Column<kHexVectors>::Make(hex_source);
+        shuffle.ascii = Column<kAsciiVectors>::Make(ascii_source);
+        return shuffle;
+    }
+};
+
+/**
+ * @brief   The shuffle masks of a canonical layout, built at compile time.
+ * @tparam  Layout          the canonical layout
+ */
+template <class Layout>
+inline constexpr CanonicalShuffle<Layout> kCanonicalShuffle = CanonicalShuffle<Layout>::Make();
+
+/**
+ * @brief   Writes the hex and ASCII chars of a single, maybe partial canonical line (scalar version).
+ * Bytes which are not printable ASCII show as '.'. The spaces are left to the template line.
+ * @tparam  Layout          the canonical layout
+ * @param   line            the line (after the indent)
+ * @param   src             the memory to show
+ * @param   size            number of bytes to show (up to Layout::kBytesPerLine)
+ */
+template <class Layout>
+inline void CanonicalLineScalar(char * line, unsigned char const * src, std::uint64_t size) {
+
+    using Geometry = CanonicalGeometry<Layout>;
+
+    auto hex = line + Geometry::kData;
+    for (std::uint64_t i = 0; i < size; ++i) {
+        hex[Geometry::HexPosition(i)] = kByteToHex[src[i]][0];
+        hex[Geometry::HexPosition(i) + 1] = kByteToHex[src[i]][1];
+    }
+
+    if constexpr (Layout::kAscii) {
+        auto ascii = line + Geometry::kAscii;
+        for (std::uint64_t i = 0; i < size; ++i) {
+            bool printable = (src[i] >= 0x20) && (src[i] < 0x80);
+            ascii[Geometry::AsciiPosition(i)] = printable ? static_cast<char>(src[i]) : '.';
+        }
+    }
+}
+
+/**
+ * @brief   Writes the hex and ASCII columns of full canonical lines (scalar version).
+ * Line l shows src[l * Layout::kBytesPerLine, (l + 1) * Layout::kBytesPerLine) and starts at dst + l * line_size.
+ * @tparam  Layout          the canonical layout
+ * @param   dst             the first line (after the indent)
+ * @param   line_size       size of a line including the indent
+ * @param   src             the memory to show
+ * @param   lines           number of lines
+ */
+template <class Layout>
+inline void CanonicalColumnsScalar(char * dst,
+                                   std::uint64_t line_size,
+                                   unsigned char const * src,
+                                   std::uint64_t lines) {
+    for (std::uint64_t l = 0; l < lines; ++l) {
+        CanonicalLineScalar<Layout>(dst + l * line_size, src + l * Layout::kBytesPerLine, Layout::kBytesPerLine);
+    }
+}
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+
+/**
+ * @brief   Turns 16 bytes into their ASCII column chars: '.' for bytes which are not printable (SSE2).
+ * @param   v           the bytes
+ * @return  the ASCII chars
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline __m128i BytesToPrintableSSE2(__m128i v) {
+    // signed compare: bytes >= 0x80 are negative and fail as well
+    __m128i const printable = _mm_cmpgt_epi8(v, _mm_set1_epi8(0x1f));
+    return _mm_or_si128(_mm_and_si128(printable, v), _mm_andnot_si128(printable, _mm_set1_epi8('.')));
+}
+
+/**
+ * @brief   The shuffle masks of a column loaded into SSE registers.
+ * @tparam  Vectors         number of vectors of the column
+ */
+template <std::uint64_t Vectors>
+struct CanonicalColumnSSSE3 {
+    std::uint64_t start[Vectors];       //!< @brief Position of the vector.
+    std::uint64_t first[Vectors];       //!< @brief First register to pick from.
+    std::uint64_t second[Vectors];      //!< @brief Second register to pick from.
+    __m128i from_first[Vectors];        //!< @brief Picks from the first register.
+    __m128i from_second[Vectors];       //!< @brief Picks from the second register.
+    __m128i spaces[Vectors];            //!< @brief Spaces between the chars.
+};
+
+/**
+ * @brief   Loads the shuffle masks of a column (SSSE3).
+ * @param   column          the shuffle masks of the column
+ * @param   registers       number of registers the column picks from
+ * @return  the loaded masks
+ */
+template <class Column, std::uint64_t Vectors>
+HEADCODE_SPACE_MEM_TARGET("ssse3")
+inline CanonicalColumnSSSE3<Vectors> LoadCanonicalColumnSSSE3(Column const & column, std::uint64_t registers) {
+    CanonicalColumnSSSE3<Vectors> masks;
+    for (std::uint64_t k = 0; k < Vectors; ++k) {
+        masks.start[k] = column.start[k];
+        masks.first[k] = column.first[k];
+        masks.second[k] = std::min<std::uint64_t>(column.first[k] + 1, registers - 1);
+        masks.from_first[k] = _mm_loadu_si128(reinterpret_cast<__m128i const *>(column.from_first[k].data()));
+        masks.from_second[k] = _mm_loadu_si128(reinterpret_cast<__m128i const *>(column.from_second[k].data()));
+        masks.spaces[k] = _mm_loadu_si128(reinterpret_cast<__m128i const *>(column.spaces[k].data()));
+    }
+    return masks;
+}
+
+/**
+ * @brief   Spreads the chars in the registers over a column (SSSE3).
+ * @param   dst             the column
+ * @param   masks           the loaded masks of the column
+ * @param   registers       the registers holding the chars
+ */
+template <std::uint64_t Vectors>
+HEADCODE_SPACE_MEM_TARGET("ssse3")
+inline void StoreCanonicalColumnSSSE3(char * dst,
+                                      CanonicalColumnSSSE3<Vectors> const & masks,
+                                      __m128i const * registers) {
+    for (std::uint64_t k = 0; k < Vectors; ++k) {
+        __m128i chars = _mm_or_si128(_mm_shuffle_epi8(registers[masks.first[k]], masks.from_first[k]),
+                                     _mm_shuffle_epi8(registers[masks.second[k]], masks.from_second[k]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + masks.start[k]), _mm_or_si128(chars, masks.spaces[k]));
+    }
+}
+
+/**
+ * @brief   Writes the hex and ASCII columns of full canonical lines (SSSE3 version, 1 line per iteration).
+ * @tparam  Layout          the canonical layout
+ * @param   dst             the first line (after the indent)
+ * @param   line_size       size of a line including the indent
+ * @param   src             the memory to show
+ * @param   lines           number of lines
+ */
+template <class Layout>
+HEADCODE_SPACE_MEM_TARGET("ssse3")
+inline void CanonicalColumnsSSSE3(char * dst, std::uint64_t line_size, unsigned char const * src, std::uint64_t lines) {
+
+    using Geometry = CanonicalGeometry<Layout>;
+    using Shuffle = CanonicalShuffle<Layout>;
+
+    auto const hex_masks = LoadCanonicalColumnSSSE3<decltype(Shuffle::hex), Shuffle::kHexVectors>(
+            kCanonicalShuffle<Layout>.hex, Shuffle::kHexRegisters);
+    auto const ascii_masks = LoadCanonicalColumnSSSE3<decltype(Shuffle::ascii), Shuffle::kAsciiVectors>(
+            kCanonicalShuffle<Layout>.ascii, Shuffle::kAsciiRegisters);
+
+    __m128i const mask = _mm_set1_epi8(0x0f);
+    __m128i const table = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+
+    for (std::uint64_t l = 0; l < lines; ++l) {
+
+        auto line = dst + l * line_size;
+        auto bytes = src + l * Layout::kBytesPerLine;
+
+        __m128i hex[Shuffle::kHexRegisters];
+        __m128i ascii[Shuffle::kAsciiRegisters];
+        for (std::uint64_t b = 0; b < Shuffle::kAsciiRegisters; ++b) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(bytes + b * 16));
+            __m128i high_nibbles = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+            __m128i low_nibbles = _mm_shuffle_epi8(table, _mm_and_si128(v, mask));
+            hex[b * 2] = _mm_unpacklo_epi8(high_nibbles, low_nibbles);
+            hex[b * 2 + 1] = _mm_unpackhi_epi8(high_nibbles, low_nibbles);
+            ascii[b] = BytesToPrintableSSE2(v);
+        }
+
+        StoreCanonicalColumnSSSE3(line + Geometry::kData, hex_masks, hex);
+        if constexpr (Layout::kAscii) {
+            StoreCanonicalColumnSSSE3(line + Geometry::kAscii, ascii_masks, ascii);
+        }
+    }
+}
+
+/**
+ * @brief   The shuffle masks of a column loaded into both 128 bit lanes of AVX registers.
+ * @tparam  Vectors         number of vectors of the column
+ */
+template <std::uint64_t Vectors>
+struct CanonicalColumnAVX2 {
+    std::uint64_t start[Vectors];       //!< @brief Position of the vector.
+    std::uint64_t first[Vectors];       //!< @brief First register to pick from.
+    std::uint64_t second[Vectors];      //!< @brief Second register to pick from.
+    __m256i from_first[Vectors];        //!< @brief Picks from the first register.
+    __m256i from_second[Vectors];       //!< @brief Picks from the second register.
+    __m256i spaces[Vectors];            //!< @brief Spaces between the chars.
+};
+
+/**
+ * @brief   Loads the shuffle masks of a column into both 128 bit lanes (AVX2).
+ * @param   column          the shuffle masks of the column
+ * @param   registers       number of registers the column picks from
+ * @return  the loaded masks
+ */
+template <class Column, std::uint64_t Vectors>
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline CanonicalColumnAVX2<Vectors> LoadCanonicalColumnAVX2(Column const & column, std::uint64_t registers) {
+    CanonicalColumnAVX2<Vectors> masks;
+    for (std::uint64_t k = 0; k < Vectors; ++k) {
+        masks.start[k] = column.start[k];
+        masks.first[k] = column.first[k];
+        masks.second[k] = std::min<std::uint64_t>(column.first[k] + 1, registers - 1);
+        masks.from_first[k] = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<__m128i const *>(column.from_first[k].data())));
+        masks.from_second[k] = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<__m128i const *>(column.from_second[k].data())));
+        masks.spaces[k] = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<__m128i const *>(column.spaces[k].data())));
+    }
+    return masks;
+}
+
+/**
+ * @brief   Spreads the chars in the registers over a column of 2 lines, one per 128 bit lane (AVX2).
+ * @param   dst             the column of the first line
+ * @param   line_size       size of a line including the indent
+ * @param   masks           the loaded masks of the column
+ * @param   registers       the registers holding the chars
+ */
+template <std::uint64_t Vectors>
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline void StoreCanonicalColumnAVX2(char * dst,
+                                     std::uint64_t line_size,
+                                     CanonicalColumnAVX2<Vectors> const & masks,
+                                     __m256i const * registers) {
+    for (std::uint64_t k = 0; k < Vectors; ++k) {
+        __m256i chars = _mm256_or_si256(_mm256_shuffle_epi8(registers[masks.first[k]], masks.from_first[k]),
+                                        _mm256_shuffle_epi8(registers[masks.second[k]], masks.from_second[k]));
+        chars = _mm256_or_si256(chars, masks.spaces[k]);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + masks.start[k]), _mm256_castsi256_si128(chars));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + line_size + masks.start[k]),
+                         _mm256_extracti128_si256(chars, 1));
+    }
+}
+
+/**
+ * @brief   Writes the hex and ASCII columns of full canonical lines (AVX2 version, 2 lines per iteration).
+ * Each 128 bit lane works on a line of its own, so this is the SSSE3 kernel for two lines at once.
+ * @tparam  Layout          the canonical layout
+ * @param   dst             the first line (after the indent)
+ * @param   line_size       size of a line including the indent
+ * @param   src             the memory to show
+ * @param   lines           number of lines
+ */
+template <class Layout>
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline void CanonicalColumnsAVX2(char * dst, std::uint64_t line_size, unsigned char const * src, std::uint64_t lines) {
+
+    using Geometry = CanonicalGeometry<Layout>;
+    using Shuffle = CanonicalShuffle<Layout>;
+
+    auto const hex_masks = LoadCanonicalColumnAVX2<decltype(Shuffle::hex), Shuffle::kHexVectors>(
+            kCanonicalShuffle<Layout>.hex, Shuffle::kHexRegisters);
+    auto const ascii_masks = LoadCanonicalColumnAVX2<decltype(Shuffle::ascii), Shuffle::kAsciiVectors>(
+            kCanonicalShuffle<Layout>.ascii, Shuffle::kAsciiRegisters);
+
+    __m256i const mask = _mm256_set1_epi8(0x0f);
+    __m256i const table = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e',
+                                           'f', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd',
+                                           'e', 'f');
+    __m256i const dots = _mm256_set1_epi8('.');
+    __m256i const control = _mm256_set1_epi8(0x1f);
+
+    std::uint64_t l = 0;
+    for (; l + 2 <= lines; l += 2) {
+
+        auto line = dst + l * line_size;
+        auto bytes = src + l * Layout::kBytesPerLine;
+
+        __m256i hex[Shuffle::kHexRegisters];
+        __m256i ascii[Shuffle::kAsciiRegisters];
+        for (std::uint64_t b = 0; b < Shuffle::kAsciiRegisters; ++b) {
+            __m256i v = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(bytes + b * 16))),
+                    _mm_loadu_si128(reinterpret_cast<__m128i const *>(bytes + Layout::kBytesPerLine + b * 16)),
+                    1);
+            __m256i high_nibbles = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+            __m256i low_nibbles = _mm256_shuffle_epi8(table, _mm256_and_si256(v, mask));
+            hex[b * 2] = _mm256_unpacklo_epi8(high_nibbles, low_nibbles);
+            hex[b * 2 + 1] = _mm256_unpackhi_epi8(high_nibbles, low_nibbles);
+            ascii[b] = _mm256_blendv_epi8(dots, v, _mm256_cmpgt_epi8(v, control));
+        }
+
+        StoreCanonicalColumnAVX2(line + Geometry::kData, line_size, hex_masks, hex);
+        if constexpr (Layout::kAscii) {
+            StoreCanonicalColumnAVX2(line + Geometry::kAscii, line_size, ascii_masks, ascii);
+        }
+    }
+
+    CanonicalColumnsSSSE3<Layout>(dst + l * line_size, line_size, src + l * Layout::kBytesPerLine, lines - l);
+}
+
+#endif
+
+/**
+ * @brief   Writes the hex and ASCII columns of full canonical lines with the kernel of the given level.
+ * @tparam  Layout          the canonical layout
+ * @param   dst             the first line (after the indent)
+ * @param   line_size       size of a line including the indent
+ * @param   src             the memory to show, lines * Layout::kBytesPerLine bytes
+ * @param   lines           number of lines
+ * @param   level           the SimdLevel to use (capped at GetSimdLevel())
+ */
+template <class Layout>
+inline void CanonicalColumns(char * dst,
+                             std::uint64_t line_size,
+                             char const * src,
+                             std::uint64_t lines,
+                             SimdLevel level = GetSimdLevel()) {
+
+    auto source = reinterpret_cast<unsigned char const *>(src);
+    if (level > GetSimdLevel()) {
+        level = GetSimdLevel();
+    }
+
+    switch (level) {
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+        case SimdLevel::kAVX512VBMI:
+        case SimdLevel::kAVX2:
+            CanonicalColumnsAVX2<Layout>(dst, line_size, source, lines);
+            return;
+        case SimdLevel::kSSSE3:
+            CanonicalColumnsSSSE3<Layout>(dst, line_size, source, lines);
+            return;
+#endif
+        default:
+            CanonicalColumnsScalar<Layout>(dst, line_size, source, lines);
+    }
+}
+
+}
+
+/**
+ * @brief   Writes a range of canonical lines.
+ * Full lines are handed to simd::CanonicalColumns() in bulk, only a last partial line is written byte by byte.
+ * @tparam  Layout          the canonical layout
+ * @param   dst             dst to write lines * templ.size() chars
+ * @param   templ           the template line as of CanonicalLineTemplate()
+ * @param   indent_size     size of the indent in the template line
+ * @param   array           the whole char array to show
+ * @param   size            size of the whole char array
+ * @param   first_line      the first line to write
+ * @param   lines           number of lines to write
+ * @param   base_address    added to the offsets shown
+ * @param   level           the SimdLevel to use (capped at GetSimdLevel())
+ */
+template <class Layout = CanonicalLayoutDefault>
+inline void DumpCanonicalLines(char * dst,
+                               std::string const & templ,
+                               std::uint64_t indent_size,
+                               char const * array,
+                               std::uint64_t size,
+                               std::uint64_t first_line,
+                               std::uint64_t lines,
+                               std::uint64_t base_address = 0,
+                               SimdLevel level = GetSimdLevel()) {
+
+    constexpr auto bytes_per_line = Layout::kBytesPerLine;
+
+    // the offset is formatted once and then counted up line by line
+    char digits[16];
+    auto offset = base_address + first_line * bytes_per_line;
+    HexNumberToCharArray(digits, offset);
+    auto line = dst;
+    for (std::uint64_t l = 0; l < lines; ++l) {
+        std::memcpy(line, templ.data(), templ.size());
+        std::copy_n(digits + 16 - Layout::kOffsetDigits, Layout::kOffsetDigits, line + indent_size + 2);
+        offset = AddToHexCharArray(digits, offset, bytes_per_line);
+        line += templ.size();
+    }
+
+    auto full_lines = std::min(first_line + lines, size / bytes_per_line) - std::min(first_line, size / bytes_per_line);
+    simd::CanonicalColumns<Layout>(dst + indent_size, templ.size(), array + first_line * bytes_per_line, full_lines,
+                                   level);
+
+    if (full_lines < lines) {
+        auto pos = (first_line + full_lines) * bytes_per_line;
+        simd::CanonicalLineScalar<Layout>(dst + full_lines * templ.size() + indent_size,
+                                          reinterpret_cast<unsigned char const *>(array + pos),
+                                          size - pos);
+    }
+}
+
+
+/**
+ * @brief   Checks if a canonical line differs between two memory blocks.
+ * A line present in one block only, or shorter in one block, differs.
+ * @tparam  Layout          the canonical layout
+ * @param   a               the first memory block
+ * @param   a_size          size of the first memory block
+ * @param   b               the second memory block
+ * @param   b_size          size of the second memory block
+ * @param   line            the line
+ * @return  true, if the line differs
+ */
+template <class Layout>
+inline bool CanonicalLineDiffers(char const * a,
+                                 std::uint64_t a_size,
+                                 char const * b,
+                                 std::uint64_t b_size,
+                                 std::uint64_t line) {
+
+    auto pos = line * Layout::kBytesPerLine;
+    auto a_bytes = (a_size > pos) ? std::min(a_size - pos, Layout::kBytesPerLine) : 0;
+    auto b_bytes = (b_size > pos) ? std::min(b_size - pos, Layout::kBytesPerLine) : 0;
+    return (a_bytes != b_bytes) || (simd::FindMismatch(a + pos, b + pos, a_bytes) != a_bytes);
+}
+
+/**
+ * @brief   Finds the next canonical line differing between two memory blocks.
+ * Equal stretches are skipped with simd::FindMismatch() at the speed of the vector compares.
+ * @tparam  Layout          the canonical layout
+ * @param   a               the first memory block
+ * @param   a_size          size of the first memory block
+ * @param   b               the second memory block
+ * @param   b_size          size of the second memory block
+ * @param   line            the line to start the search at
+ * @return  the first differing line at or after line, the number of lines of the larger block if none
+ */
+template <class Layout>
+inline std::uint64_t NextDifferingCanonicalLine(char const * a,
+                                                std::uint64_t a_size,
+                                                char const * b,
+                                                std::uint64_t b_size,
+                                                std::uint64_t line) {
+
+    auto common = std::min(a_size, b_size);
+    auto pos = line * Layout::kBytesPerLine;
+    if (pos < common) {
+        auto mismatch = simd::FindMismatch(a + pos, b + pos, common - pos);
+        if (mismatch != common - pos) {
+            return (pos + mismatch) / Layout::kBytesPerLine;
+        }
+    }
+
+    // all common bytes from line on are equal: only a size difference is left
+    if (a_size == b_size) {
+        return (a_size + Layout::kBytesPerLine - 1) / Layout::kBytesPerLine;
+    }
+    return std::max(line, common / Layout::kBytesPerLine);
+}
+
+
+/**
+ * @brief   The column positions of a typed canonical line, relative to the end of the indent.
+ * A typed line shows the offset ("0x" and 16 hex digits) followed by the 16 bytes of the line read as values of
+ * type T, each right aligned in a field wide enough for any value of T (as od -t does). The bytes 0x10 to 0x1f
+ * as little endian std::uint32_t give:
+ * @code
+ *      0x0000000000000010    319951120  387323156  454695192  522067228
+ * @endcode
+ * @tparam  T       the type of the values: an integer type of up to 64 bits, float or double
+ */
+template <class T>
+struct TypedCanonicalGeometry {
+
+    static_assert((std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) <= 8)) ||
+                          std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "Typed canonical values must be integers of up to 64 bits, float or double.");
+    static_assert(!std::is_floating_point_v<T> || std::numeric_limits<T>::is_iec559,
+                  "Typed canonical floating point values must be IEEE 754.");
+
+    /**
+     * @brief   The unsigned integer holding the bits of a value.
+     */
+    using Bits = std::conditional_t<
+            sizeof(T) == 1,
+            std::uint8_t,
+            std::conditional_t<sizeof(T) == 2,
+                               std::uint16_t,
+                               std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+    /**
+     * @brief   Returns the width of the widest value.
+     * Floating point values are shown in their shortest round trip form, the widest being a negative number
+     * with all significant digits and the longest exponent: "-1.17549435e-38" or "-2.2250738585072014e-308".
+     * @return  the number of chars of the widest value
+     */
+    static constexpr std::uint64_t Width() {
+        if constexpr (std::is_same_v<T, float>) {
+            return 15;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return 24;
+        } else {
+            return std::numeric_limits<T>::digits10 + 1 + (std::is_signed_v<T> ? 1 : 0);
+        }
+    }
+
+    static constexpr std::uint64_t kValues = 16 / sizeof(T);                        //!< @brief Values per line.
+    static constexpr std::uint64_t kWidth = Width();                                //!< @brief Chars per value.
+    static constexpr std::uint64_t kData = 2 + 16 + 2;                              //!< @brief Value columns.
+    static constexpr std::uint64_t kLineSize = kData + kValues * (kWidth + 1) + 1;  //!< @brief Including '\n'.
+};
+
+/**
+ * @brief   Creates the table of the two decimal digits of all numbers below 100.
+ * @return  The two decimal digits of each number.
+ */
+constexpr std::array<std::array<char, 2>, 100> MakeDecimalPairTable() {
+
+    std::array<std::array<char, 2>, 100> table{};
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        table[i][0] = static_cast<char>('0' + i / 10);
+        table[i][1] = static_cast<char>('0' + i % 10);
+    }
+    return table;
+}
+
+/**
+ * @brief   The two decimal digits of all numbers below 100, built at compile time.
+ */
+inline constexpr std::array<std::array<char, 2>, 100> kDecimalPairs = MakeDecimalPairTable();
+
+/**
+ * @brief   Writes the decimal digits of a number backwards, so the number ends at a given position.
+ * Each division by 100 gives two digits looked up in kDecimalPairs.
+ * @tparam  Unsigned    the unsigned type of the number (32 bit divisions are faster than 64 bit ones)
+ * @param   end         one past the position of the last digit
+ * @param   number      the number to write
+ * @return  the position of the first digit
+ */
+template <class Unsigned>
+inline char * DecimalToCharArray(char * end, Unsigned number) {
+    while (number >= 100) {
+        auto const & pair = kDecimalPairs[number % 100];
+        number /= 100;
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+    if (number >= 10) {
+        auto const & pair = kDecimalPairs[number];
+        *--end = pair[1];
+        *--end = pair[0];
+    } else {
+        *--end = static_cast<char>('0' + number);
+    }
+    return end;
+}
+
+/**
+ * @brief   Writes a value right aligned, so it ends at a given position.
+ * Integers are written with DecimalToCharArray(), floating point values with std::to_chars() in their shortest
+ * round trip form. No locale or stream is involved.
+ * @tparam  T       the type of the value
+ * @param   end     one past the position of the last char
+ * @param   value   the value to write
+ */
+template <class T>
+inline void TypedValueToCharArray(char * end, T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        std::copy(buffer, result.ptr, end - (result.ptr - buffer));
+    } else {
+        using Unsigned = std::conditional_t<sizeof(T) <= 4, std::uint32_t, std::uint64_t>;
+        if constexpr (std::is_signed_v<T>) {
+            if (value < 0) {
+                auto first = DecimalToCharArray(end, static_cast<Unsigned>(Unsigned{0} - static_cast<Unsigned>(value)));
+                *--first = '-';
+                return;
+            }
+        }
+        DecimalToCharArray(end, static_cast<Unsigned>(value));
+    }
+}
+
+/**
+ * @brief   Creates the template of a typed canonical line: indent, "0x", blanks and the '\n'.
+ * @tparam  T           the type of the values
+ * @param   indent      indent of each line
+ * @return  The template line.
+ */
+template <class T>
+inline std::string TypedCanonicalLineTemplate(std::string const & indent) {
+
+    using Geometry = TypedCanonicalGeometry<T>;
+
+    std::string templ(indent.size() + Geometry::kLineSize, ' ');
+    std::copy(indent.begin(), indent.end(), templ.begin());
+
+    auto line = templ.data() + indent.size();
+    line[0] = '0';
+    line[1] = 'x';
+    line[Geometry::kLineSize - 1] = '\n';
+
+    return templ;
+}
+
+/**
+ * @brief   Writes a range of typed canonical lines.
+ * Values are read unaligned in the given byte order. A value cut off by the end of the array is padded with
+ * zero bytes, a last partial line shows only the values it has.
+ * @tparam  T               the type of the values
+ * @param   dst             dst to write lines * templ.size() chars
+ * @param   templ           the template line as of TypedCanonicalLineTemplate()
+ * @param   indent_size     size of the indent in the template line
+ * @param   array           the whole char array to show
+ * @param   size            size of the whole char array
+ * @param   first_line      the first line to write
+ * @param   lines           number of lines to write (all within the array)
+ * @param   endian          byte order of the values in the array
+ * @param   base_address    added to the offsets shown
+ */
+template <class T>
+inline void DumpTypedCanonicalLines(char * dst,
+                                    std::string const & templ,
+                                    std::uint64_t indent_size,
+                                    char const * array,
+                                    std::uint64_t size,
+                                    std::uint64_t first_line,
+                                    std::uint64_t lines,
+                                    Endian endian = Endian::kNative,
+                                    std::uint64_t base_address = 0) {
+
+    using Geometry = TypedCanonicalGeometry<T>;
+    using Bits = typename Geometry::Bits;
+
+    bool swap = endian != Endian::kNative;
+
+    // the offset is formatted once and then counted up line by line
+    char digits[16];
+    auto offset = base_address + first_line * 16;
+    HexNumberToCharArray(digits, offset);
+    auto line = dst;
+    for (std::uint64_t l = 0; l < lines; ++l) {
+        std::memcpy(line, templ.data(), templ.size());
+        std::copy_n(digits, 16, line + indent_size + 2);
+        offset = AddToHexCharArray(digits, offset, 16);
+
+        auto pos = (first_line + l) * 16;
+        auto src = array + pos;
+        auto values = std::min<std::uint64_t>(Geometry::kValues, (size - pos + sizeof(T) - 1) / sizeof(T));
+        auto field = line + indent_size + Geometry::kData;
+        for (std::uint64_t v = 0; v < values; ++v) {
+            Bits bits = 0;
+            auto value_pos = v * sizeof(T);
+            if (pos + value_pos + sizeof(T) <= size) {
+                std::copy_n(src + value_pos, sizeof(T), reinterpret_cast<char *>(&bits));
+            } else {
+                std::copy_n(src + value_pos, size - pos - value_pos, reinterpret_cast<char *>(&bits));
+            }
+            if (swap) {
+                bits = simd::ByteSwap(bits);
+            }
+            T value;
+            std::copy_n(reinterpret_cast<char const *>(&bits), sizeof(T), reinterpret_cast<char *>(&value));
+            field += Geometry::kWidth + 1;
+            TypedValueToCharArray(field, value);
+        }
+
+        line += templ.size();
+    }
+}
+
+}
+
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#ifndef HEADCODE_SPACE_MEM_MEM_CANONICAL_MONITOR_HPP
+#define HEADCODE_SPACE_MEM_MEM_CANONICAL_MONITOR_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mem_allocator.hpp"
+#include "mem_canonical.hpp"
+
+
+/**
+ * @brief   The headcode mem namespace
+ */
+namespace headcode::mem {
+
+/**
+ * @brief   Keeps the canonical representation of a memory region up to date between polls.
+ * The monitor keeps a snapshot of the memory and its canonical representation. Refresh() compares the memory
+ * with the snapshot using vector compares and formats only the lines which changed, so the formatting cost
+ * scales with the amount of change rather than with the size of the region:
+ * @code
+ *      headcode::mem::CanonicalMonitor monitor;
+ *      while (polling) {
+ *          for (auto line : monitor.Refresh(shared, size)) {
+ *              show(line, monitor.GetLine(line));
+ *          }
+ *      }
+ * @endcode
+ * @tparam  Layout          the canonical layout
+ */
+template <class Layout = CanonicalLayoutDefault>
+class BasicCanonicalMonitor {
+
+    std::vector<char, DefaultInitAllocator<char>> snapshot_;    //!< @brief The memory as of the last refresh.
+    std::string canonical_;                                     //!< @brief The snapshot in canonical form.
+    std::string templ_;                                         //!< @brief The template line.
+    std::uint64_t indent_size_ = 0;                             //!< @brief Size of the indent.
+    std::uint64_t base_address_ = 0;                            //!< @brief Offset shown for the first byte.
+    std::vector<std::uint64_t> changed_lines_;                  //!< @brief Lines changed by the last refresh.
+
+public:
+    /**
+     * @brief   Constructor
+     * @param   indent          indent of each line
+     * @param   base_address    offset shown for the first byte
+     */
+    explicit BasicCanonicalMonitor(std::string const & indent = {}, std::uint64_t base_address = 0)
+            : templ_{CanonicalLineTemplate<Layout>(indent)}, indent_size_{indent.size()}, base_address_{base_address} {
+    }
+
+    /**
+     * @brief   Returns the canonical representation of the memory as of the last refresh.
+     * @return  The canonical representation, as CharArrayToCanonicalString would give it.
+     */
+    std::string const & GetCanonical() const {
+        return canonical_;
+    }
+
+    /**
+     * @brief   Returns the lines changed by the last refresh.
+     * @return  The changed lines in ascending order, including lines dropped because the memory shrank.
+     */
+    std::vector<std::uint64_t> const & GetChangedLines() const {
+        return changed_lines_;
+    }
+
+    /**
+     * @brief   Returns a single line of the canonical representation.
+     * The line stays valid until the next refresh.
+     * @param   line        the line
+     * @return  The line including the '\n', empty if there is no such line.
+     */
+    std::string_view GetLine(std::uint64_t line) const {
+        if (line >= GetLineCount()) {
+            return {};
+        }
+        return std::string_view{canonical_}.substr(line * templ_.size(), templ_.size());
+    }
+
+    /**
+     * @brief   Returns the number of lines.
+     * @return  The number of lines.
+     */
+    std::uint64_t GetLineCount() const {
+        return canonical_.size() / templ_.size();
+    }
+
+    /**
+     * @brief   Returns the size of each line (including the indent and the '\n').
+     * @return  The size of each line.
+     */
+    std::uint64_t GetLineSize() const {
+        return templ_.size();
+    }
+
+    /**
+     * @brief   Compares the memory with the snapshot and formats the lines which changed.
+     * The first refresh formats all lines. The size of the memory may change between refreshes.
+     * @param   memory      the memory
+     * @param   size        size of the memory
+     * @return  The changed lines, see GetChangedLines().
+     */
+    std::vector<std::uint64_t> const & Refresh(char const * memory, std::uint64_t size) {
+
+        constexpr auto bytes_per_line = Layout::kBytesPerLine;
+
+        changed_lines_.clear();
+        auto lines = (size + bytes_per_line - 1) / bytes_per_line;
+        auto all_lines = std::max(lines, GetLineCount());
+        canonical_.resize(lines * templ_.size());
+
+        // changed lines are formatted in runs of adjacent lines
+        std::uint64_t run_start = 0;
+        std::uint64_t run_lines = 0;
+        auto format_run = [&]() {
+            auto count = std::min(run_start + run_lines, lines) - std::min(run_start, lines);
+            if (count > 0) {
+                DumpCanonicalLines<Layout>(canonical_.data() + run_start * templ_.size(),
+                                           templ_,
+                                           indent_size_,
+                                           memory,
+                                           size,
+                                           run_start,
+                                           count,
+                                           base_address_);
+            }
+        };
+
+        auto line = NextDifferingCanonicalLine<Layout>(snapshot_.data(), snapshot_.size(), memory, size, 0);
+        while (line < all_lines) {
+            changed_lines_.push_back(line);
+            if (line != run_start + run_lines) {
+                format_run();
+                run_start = line;
+                run_lines = 0;
+            }
+            ++run_lines;
+            line = NextDifferingCanonicalLine<Layout>(snapshot_.data(), snapshot_.size(), memory, size, line + 1);
+        }
+        format_run();
+
+        // only the changed lines of the snapshot are updated
+        snapshot_.resize(size);
+        for (auto changed : changed_lines_) {
+            auto pos = changed * bytes_per_line;
+            if (pos < size) {
+                std::copy_n(memory + pos, std::min(bytes_per_line, size - pos), snapshot_.data() + pos);
+            }
+        }
+
+        return changed_lines_;
+    }
+
+    /**
+     * @brief   Compares the memory with the snapshot and formats the lines which changed.
+     * @param   memory      the memory
+     * @return  The changed lines, see GetChangedLines().
+     */
+    std::vector<std::uint64_t> const & Refresh(std::vector<std::byte> const & memory) {
+        return Refresh(reinterpret_cast<char const *>(memory.data()), memory.size());
+    }
+
+    /**
+     * @brief   Drops the snapshot: the next refresh formats all lines again.
+     */
+    void Reset() {
+        snapshot_.clear();
+        canonical_.clear();
+        changed_lines_.clear();
+    }
+};
+
+/**
+ * @brief   A monitor in the layout of CharArrayToCanonicalString.
+ */
+using CanonicalMonitor = BasicCanonicalMonitor<>;
+
+}
+
+
+#endif
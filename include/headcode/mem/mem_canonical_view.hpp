@@ -0,0 +1,298 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#ifndef HEADCODE_SPACE_MEM_MEM_CANONICAL_VIEW_HPP
+#define HEADCODE_SPACE_MEM_MEM_CANONICAL_VIEW_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mem_canonical.hpp"
+
+
+/**
+ * @brief   The headcode mem namespace
+ */
+namespace headcode::mem {
+
+/**
+ * @brief   A non-owning view of the canonical representation of memory, formatting lines on demand.
+ * Lines have a fixed width, so any line is found in O(1) and only the lines asked for are formatted. The lines
+ * are the same as those of CharArrayToCanonicalString with the same layout, indent and base address:
+ * @code
+ *      headcode::mem::CanonicalView view{data, size};
+ *      std::cout << view.GetLine(10'000'000);
+ *      for (auto line : view) {
+ *          std::cout << line;
+ *      }
+ * @endcode
+ * The memory must outlive the view. GetLine() formats into a buffer of the view, so a view must not be shared
+ * between threads; iterators have a buffer of their own.
+ * @tparam  Layout          the canonical layout
+ */
+template <class Layout = CanonicalLayoutDefault>
+class BasicCanonicalView {
+
+    char const * memory_ = nullptr;         //!< @brief The memory shown.
+    std::uint64_t size_ = 0;                //!< @brief Size of the memory shown.
+    std::uint64_t indent_size_ = 0;         //!< @brief Size of the indent.
+    std::uint64_t base_address_ = 0;        //!< @brief Offset shown for the first byte.
+    std::string templ_;                     //!< @brief The template line.
+    mutable std::string line_;              //!< @brief Buffer of the last line returned by GetLine().
+
+public:
+    /**
+     * @brief   Iterates over the lines of a view, formatting each line when it is dereferenced.
+     * The line returned stays valid until the iterator is dereferenced again or destroyed.
+     */
+    class Iterator {
+
+        BasicCanonicalView const * view_ = nullptr;     //!< @brief The view.
+        std::uint64_t line_ = 0;                        //!< @brief The current line.
+        mutable std::string buffer_;                    //!< @brief Buffer of the current line.
+
+    public:
+        using iterator_category = std::input_iterator_tag;      //!< @brief Lines are formatted on the fly.
+        using value_type = std::string_view;                    //!< @brief A line.
+        using difference_type = std::int64_t;                   //!< @brief Distance of lines.
+        using pointer = std::string_view const *;               //!< @brief Unused.
+        using reference = std::string_view;                     //!< @brief A line.
+
+        /**
+         * @brief   Constructor
+         */
+        Iterator() = default;
+
+        /**
+         * @brief   Constructor
+         * @param   view        the view
+         * @param   line        the line
+         */
+        Iterator(BasicCanonicalView const * view, std::uint64_t line) : view_{view}, line_{line} {
+        }
+
+        /**
+         * @brief   Returns the line number the iterator is at.
+         * @return  The line number.
+         */
+        std::uint64_t GetLine() const {
+            return line_;
+        }
+
+        /**
+         * @brief   Formats the current line.
+         * @return  The line including the '\n'.
+         */
+        std::string_view operator*() const {
+            buffer_.resize(view_->GetLineSize());
+            view_->WriteLines(buffer_.data(), line_, 1);
+            return buffer_;
+        }
+
+        /**
+         * @brief   Advances to the next line.
+         * @return  this
+         */
+        Iterator & operator++() {
+            ++line_;
+            return *this;
+        }
+
+        /**
+         * @brief   Advances to the next line.
+         * @return  the iterator before advancing.
+         */
+        Iterator operator++(int) {
+            Iterator previous{view_, line_};
+            ++line_;
+            return previous;
+        }
+
+        /**
+         * @brief   Skips lines.
+         * @param   lines       number of lines to skip (may be negative)
+         * @return  this
+         */
+        Iterator & operator+=(difference_type lines) {
+            line_ += static_cast<std::uint64_t>(lines);
+            return *this;
+        }
+
+        /**
+         * @brief   Equality
+         * @param   rhs         the other iterator
+         * @return  true, if both iterators are at the same line of the same view.
+         */
+        bool operator==(Iterator const & rhs) const {
+            return (view_ == rhs.view_) && (line_ == rhs.line_);
+        }
+
+        /**
+         * @brief   Inequality
+         * @param   rhs         the other iterator
+         * @return  true, if the iterators are at different lines or views.
+         */
+        bool operator!=(Iterator const & rhs) const {
+            return !(*this == rhs);
+        }
+    };
+
+    /**
+     * @brief   Constructor
+     */
+    BasicCanonicalView() : templ_{CanonicalLineTemplate<Layout>({})} {
+    }
+
+    /**
+     * @brief   Constructor
+     * @param   memory          the memory to show
+     * @param   size            size of the memory
+     * @param   indent          indent of each line
+     * @param   base_address    offset shown for the first byte
+     */
+    BasicCanonicalView(char const * memory,
+                       std::uint64_t size,
+                       std::string const & indent = {},
+                       std::uint64_t base_address = 0)
+            : memory_{memory},
+              size_{size},
+              indent_size_{indent.size()},
+              base_address_{base_address},
+              templ_{CanonicalLineTemplate<Layout>(indent)} {
+    }
+
+    /**
+     * @brief   Constructor
+     * @param   memory          the memory to show
+     * @param   indent          indent of each line
+     * @param   base_address    offset shown for the first byte
+     */
+    explicit BasicCanonicalView(std::vector<std::byte> const & memory,
+                                std::string const & indent = {},
+                                std::uint64_t base_address = 0)
+            : BasicCanonicalView{reinterpret_cast<char const *>(memory.data()), memory.size(), indent, base_address} {
+    }
+
+    /**
+     * @brief   Returns an iterator at the first line.
+     * @return  An iterator at the first line.
+     */
+    Iterator begin() const {
+        return Iterator{this, 0};
+    }
+
+    /**
+     * @brief   Returns an iterator past the last line.
+     * @return  An iterator past the last line.
+     */
+    Iterator end() const {
+        return Iterator{this, GetLineCount()};
+    }
+
+    /**
+     * @brief   Returns the offset shown for the first byte.
+     * @return  The base address.
+     */
+    std::uint64_t GetBaseAddress() const {
+        return base_address_;
+    }
+
+    /**
+     * @brief   Formats a single line.
+     * The line returned stays valid until the next call to GetLine().
+     * @param   line        the line (less than GetLineCount())
+     * @return  The line including the '\n', empty if there is no such line.
+     */
+    std::string_view GetLine(std::uint64_t line) const {
+        line_.resize(templ_.size());
+        return std::string_view{line_.data(), WriteLines(line_.data(), line, 1)};
+    }
+
+    /**
+     * @brief   Returns the number of lines.
+     * @return  The number of lines.
+     */
+    std::uint64_t GetLineCount() const {
+        return (size_ + Layout::kBytesPerLine - 1) / Layout::kBytesPerLine;
+    }
+
+    /**
+     * @brief   Returns the line showing a byte.
+     * @param   offset      offset of the byte in the memory (not including the base address)
+     * @return  The line showing the byte.
+     */
+    std::uint64_t GetLineOf(std::uint64_t offset) const {
+        return offset / Layout::kBytesPerLine;
+    }
+
+    /**
+     * @brief   Returns the size of each line (including the indent and the '\n').
+     * @return  The size of each line.
+     */
+    std::uint64_t GetLineSize() const {
+        return templ_.size();
+    }
+
+    /**
+     * @brief   Returns the memory shown.
+     * @return  The memory shown.
+     */
+    char const * GetMemory() const {
+        return memory_;
+    }
+
+    /**
+     * @brief   Returns the size of the memory shown.
+     * @return  The size of the memory shown.
+     */
+    std::uint64_t GetSize() const {
+        return size_;
+    }
+
+    /**
+     * @brief   Formats a range of lines.
+     * Lines past the last one are left out.
+     * @param   dst         dst to write up to count * GetLineSize() chars
+     * @param   first       the first line
+     * @param   count       number of lines
+     * @return  Number of chars written.
+     */
+    std::uint64_t WriteLines(char * dst, std::uint64_t first, std::uint64_t count) const {
+        auto lines = GetLineCount();
+        if (first >= lines) {
+            return 0;
+        }
+        count = std::min(count, lines - first);
+        DumpCanonicalLines<Layout>(dst, templ_, indent_size_, memory_, size_, first, count, base_address_);
+        return count * templ_.size();
+    }
+
+    /**
+     * @brief   Formats a single line.
+     * @param   line        the line
+     * @return  The line including the '\n', see GetLine().
+     */
+    std::string_view operator[](std::uint64_t line) const {
+        return GetLine(line);
+    }
+};
+
+/**
+ * @brief   A view of the canonical representation in the layout of CharArrayToCanonicalString.
+ */
+using CanonicalView = BasicCanonicalView<>;
+
+}
+
+
+#endif
@@ -10,15 +10,120 @@
 #define HEADCODE_SPACE_MEM_MEM_CORE_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "mem_allocator.hpp"
+#include "mem_canonical.hpp"
+#include "mem_simd.hpp"
+#include "mem_thread_pool.hpp"
+
 
 /**
  * @brief   The headcode mem namespace
  */
 namespace headcode::mem {
 
+/**
+ * @brief   Converts an Ascii85 string to a memory, rejecting anything not strictly Ascii85.
+ * Each group of 5 chars in '!' to 'u' yields 4 bytes, a 'z' in place of a group yields 4 zero bytes.
+ * A last group of 2 to 4 chars yields 1 char less bytes, as written by MemoryToAscii85.
+ * The "<~" and "~>" delimiters and whitespace are not part of the string.
+ * @tparam  Allocator           the allocator of the memory block (see ByteBuffer)
+ * @param   ascii85             the Ascii85 string describing a memory.
+ * @param   memory              receives the memory block (cleared on failure).
+ * @param   invalid_position    if not nullptr, receives the offset of the first invalid character on failure
+ *                              (the start of a group exceeding 32 bits) or the size of the string if it ends early.
+ * @return  true, if the Ascii85 string has been valid and converted.
+ */
+template <class Allocator>
+inline bool Ascii85ToMemory(std::string const & ascii85,
+                            std::vector<std::byte, Allocator> & memory,
+                            std::uint64_t * invalid_position = nullptr);
+
+/**
+ * @brief   Converts a Base64 string to a memory, rejecting anything not strictly Base64.
+ * The string must consist of chars of the alphabet only, with the last group of 4 chars padded by
+ * up to two '=' and unused bits of the last char being 0. With Base64Alphabet::kUrl the padding is
+ * optional.
+ * @tparam  Allocator           the allocator of the memory block (see ByteBuffer)
+ * @param   base64              the Base64 string describing a memory.
+ * @param   memory              receives the memory block (cleared on failure).
+ * @param   alphabet            the Base64 alphabet.
+ * @param   invalid_position    if not nullptr, receives the offset of the first invalid character on failure
+ *                              or the size of the string if it ends early.
+ * @return  true, if the Base64 string has been valid and converted.
+ */
+template <class Allocator>
+inline bool Base64ToMemory(std::string const & base64,
+                           std::vector<std::byte, Allocator> & memory,
+                           Base64Alphabet alphabet = Base64Alphabet::kStandard,
+                           std::uint64_t * invalid_position = nullptr);
+
+/**
+ * @brief   Converts a canonical representation back to the memory, e.g. the output of MemoryToCanonicalString.
+ * The indent is taken from the first line (whatever precedes its "0x") and must prefix all lines. The hex
+ * columns are read at their fixed positions and decoded in batches of lines with the SIMD hex decoder;
+ * the ASCII column is ignored. A "*" line repeats the line before it up to the offset of the line after it.
+ * The first line gives the base address; every other line must continue at the offset following the line
+ * before it. Only the last line may be partial; it may lack its trailing blanks and its '\n'.
+ * @tparam  Layout              the canonical layout of the representation
+ * @tparam  Allocator           the allocator of the memory block (see ByteBuffer)
+ * @param   canonical           the canonical representation
+ * @param   memory              receives the memory block (cleared on failure).
+ * @param   base_address        if not nullptr, receives the offset of the first line.
+ * @param   invalid_position    if not nullptr, receives the offset of the first invalid character on failure
+ *                              or the start of the first malformed line.
+ * @return  true, if the canonical representation has been valid and converted.
+ */
+template <class Layout = CanonicalLayoutDefault, class Allocator = std::allocator<std::byte>>
+inline bool CanonicalStringToMemory(std::string_view canonical,
+                                    std::vector<std::byte, Allocator> & memory,
+                                    std::uint64_t * base_address = nullptr,
+                                    std::uint64_t * invalid_position = nullptr);
+
+/**
+ * @brief   Gives the canonical representation of only those lines in which two memory blocks differ.
+ * Differing lines are found with vector compares of the blocks, equal stretches in between cost no formatting.
+ * Each run of differing lines is shown with up to context equal lines around it; runs closer than 2 * context
+ * lines are joined. Skipped lines show as "*". In the interleaved style equal lines start with "  ", lines of
+ * the first block with "- " and lines of the second block with "+ ":
+ * @code
+ *      *
+ *        0x0000000000000100   41 41 41 41 41 41 41 41  41 41 41 41 41 41 41 41   |AAAAAAAA AAAAAAAA|
+ *      - 0x0000000000000110   41 41 41 41 41 41 41 41  41 41 41 41 41 41 41 41   |AAAAAAAA AAAAAAAA|
+ *      + 0x0000000000000110   41 41 41 41 42 41 41 41  41 41 41 41 41 41 41 41   |AAAABAAA AAAAAAAA|
+ *        0x0000000000000120   41 41 41 41 41 41 41 41  41 41 41 41 41 41 41 41   |AAAAAAAA AAAAAAAA|
+ *      *
+ * @endcode
+ * In the side by side style each line shows the line of the first block, " | " if they differ (blanks
+ * otherwise) and the line of the second block. Lines beyond the end of a block are left blank.
+ * Equal blocks give an empty string.
+ * @tparam  Layout          the canonical layout
+ * @param   a               the first memory block
+ * @param   a_size          size of the first memory block
+ * @param   b               the second memory block
+ * @param   b_size          size of the second memory block
+ * @param   style           interleaved or side by side
+ * @param   context         number of equal lines shown around differing lines
+ * @param   indent          indent of each line
+ * @return  the canonical representation of the differing lines.
+ */
+template <class Layout = CanonicalLayoutDefault>
+inline std::string CharArrayDiffToCanonicalString(char const * a,
+                                                  std::uint64_t a_size,
+                                                  char const * b,
+                                                  std::uint64_t b_size,
+                                                  CanonicalDiffStyle style = CanonicalDiffStyle::kInterleaved,
+                                                  std::uint64_t context = 3,
+                                                  std::string const & indent = {});
+
 /**
  * @brief   Convenient function to quickly convert a char array to a memory block.
  * @param   array       the char array
@@ -27,6 +132,110 @@ namespace headcode::mem {
  */
 inline std::vector<std::byte> CharArrayToMemory(char const * array, std::uint64_t size);
 
+/**
+ * @brief   Streams the canonical representation of the memory to a sink.
+ * Other than CharArrayToCanonicalString this does not materialize the whole representation: whole lines are
+ * formatted into a reusable buffer of about buffer_size bytes, which is handed to the sink whenever it is full.
+ * Peak memory is constant and the output starts right away. The sink returns false to abort.
+ * If squeeze is set, runs of lines equal to the line before are replaced by a single "*" line like hexdump does.
+ * A run reaching the end of the memory ends with its last line, so the size stays visible:
+ * @code
+ *       0x0000000000000000   00 00 00 00 00 00 00 00  00 00 00 00 00 00 00 00   |........ ........|
+ *       *
+ *       0x0000000000001000   41 41 41 41 41 41 41 41  41 41 41 41 41 41 41 41   |AAAAAAAA AAAAAAAA|
+ *       *
+ *       0x0000000000002ff0   41 41 41 41 41 41 41 41  41 41 41 41 41 41 41 41   |AAAAAAAA AAAAAAAA|
+ * @endcode
+ * Runs are found with vector compares of the memory against itself shifted by a line, so squeezed runs
+ * cost hardly more than reading them.
+ * @code
+ *      headcode::mem::CharArrayToCanonicalStream(data, size, [](char const * lines, std::uint64_t size) {
+ *          return send(lines, size);
+ *      });
+ * @endcode
+ * The layout of the lines (bytes per line, grouping, offset digits, ASCII column) is set at compile time with
+ * the Layout parameter, see CanonicalLayout. The offsets shown start at base_address:
+ * @code
+ *      headcode::mem::CharArrayToCanonicalStream<headcode::mem::CanonicalLayout<32, 4, 8, false>>(
+ *              data, size, std::cout, {}, false, 0x40000000);
+ * @endcode
+ * @tparam  Layout          the canonical layout
+ * @param   array           the char array to show.
+ * @param   size            size of the char array.
+ * @param   sink            receives the canonical lines chunk by chunk.
+ * @param   indent          indent of each line
+ * @param   buffer_size     size of the line buffer (holds at least one line)
+ * @param   squeeze         replace runs of repeated lines by "*"
+ * @param   base_address    offset shown for the first byte
+ * @return  true, if all lines have been handed to the sink.
+ */
+template <class Layout = CanonicalLayoutDefault>
+inline bool CharArrayToCanonicalStream(char const * array,
+                                       std::uint64_t size,
+                                       std::function<bool(char const *, std::uint64_t)> const & sink,
+                                       std::string const & indent = {},
+                                       std::uint64_t buffer_size = 64 * 1024,
+                                       bool squeeze = false,
+                                       std::uint64_t base_address = 0);
+
+/**
+ * @brief   Streams the canonical representation of the memory to an output stream.
+ * @tparam  Layout          the canonical layout
+ * @param   array           the char array to show.
+ * @param   size            size of the char array.
+ * @param   out             the output stream.
+ * @param   indent          indent of each line
+ * @param   squeeze         replace runs of repeated lines by "*"
+ * @param   base_address    offset shown for the first byte
+ * @return  true, if all lines have been written.
+ */
+template <class Layout = CanonicalLayoutDefault>
+inline bool CharArrayToCanonicalStream(char const * array,
+                                       std::uint64_t size,
+                                       std::ostream & out,
+                                       std::string const & indent = {},
+                                       bool squeeze = false,
+                                       std::uint64_t base_address = 0);
+
+/**
+ * @brief   Streams the canonical representation of the memory to a C file.
+ * @tparam  Layout          the canonical layout
+ * @param   array           the char array to show.
+ * @param   size            size of the char array.
+ * @param   file            the file.
+ * @param   indent          indent of each line
+ * @param   squeeze         replace runs of repeated lines by "*"
+ * @param   base_address    offset shown for the first byte
+ * @return  true, if all lines have been written.
+ */
+template <class Layout = CanonicalLayoutDefault>
+inline bool CharArrayToCanonicalStream(char const * array,
+                                       std::uint64_t size,
+                                       std::FILE * file,
+                                       std::string const & indent = {},
+                                       bool squeeze = false,
+                                       std::uint64_t base_address = 0);
+
+/**
+ * @brief   Streams the canonical representation of the memory to a file descriptor.
+ * Partial writes are continued, so this works for pipes and sockets too.
+ * @tparam  Layout          the canonical layout
+ * @param   array           the char array to show.
+ * @param   size            size of the char array.
+ * @param   fd              the file descriptor.
+ * @param   indent          indent of each line
+ * @param   squeeze         replace runs of repeated lines by "*"
+ * @param   base_address    offset shown for the first byte
+ * @return  true, if all lines have been written.
+ */
+template <class Layout = CanonicalLayoutDefault>
+inline bool CharArrayToCanonicalStream(char const * array,
+                                       std::uint64_t size,
+                                       int fd,
+                                       std::string const & indent = {},
+                                       bool squeeze = false,
+                                       std::uint64_t base_address = 0);
+
 /**
  * @brief   Gives a canonical representation of the memory.
  * The canonical representation is separated in different columns.
@@ -39,12 +248,91 @@ inline std::vector<std::byte> CharArrayToMemory(char const * array, std::uint64_
  *       0x0000000000000020   20 21 22 23 24 25 26 27  28 29 2a 2b 2c 2d 2e 2f   | !"#$%&' ()*+,-./|
  *       ...
  * @endcode
- * @param   array       the char array to show.
- * @param   size        size of the char array.
- * @param   indent      indent of each line
+ * With squeeze set runs of repeated lines are replaced by "*" as in CharArrayToCanonicalStream(). Other layouts
+ * are picked with the Layout parameter, see CanonicalLayout.
+ * @tparam  Layout          the canonical layout
+ * @param   array           the char array to show.
+ * @param   size            size of the char array.
+ * @param   indent          indent of each line
+ * @param   squeeze         replace runs of repeated lines by "*"
+ * @param   base_address    offset shown for the first byte
+ * @return  a string containing the canonical representation of the memory.
+ */
+template <class Layout = CanonicalLayoutDefault>
+inline std::string CharArrayToCanonicalString(char const * array,
+                                              std::uint64_t size,
+                                              std::string const & indent = {},
+                                              bool squeeze = false,
+                                              std::uint64_t base_address = 0);
+
+/**
+ * @brief   Gives a canonical representation of the memory using several threads.
+ * Lines have a fixed width, so the line range is split into chunks of kParallelChunkSize bytes which are
+ * formatted concurrently straight into the result. If the result is larger than the last level cache, the
+ * lines are formatted into a small cache resident buffer and then written with non-temporal stores instead.
+ * Memory smaller than kParallelMinSize is converted on the calling thread.
+ * @tparam  Layout          the canonical layout
+ * @param   array           the char array to show.
+ * @param   size            size of the char array.
+ * @param   indent          indent of each line
+ * @param   base_address    offset shown for the first byte
+ * @param   pool            the threads to use.
  * @return  a string containing the canonical representation of the memory.
  */
-inline std::string CharArrayToCanonicalString(char const * array, std::uint64_t size, std::string const & indent = {});
+template <class Layout = CanonicalLayoutDefault>
+inline std::string CharArrayToCanonicalStringParallel(char const * array,
+                                                      std::uint64_t size,
+                                                      std::string const & indent = {},
+                                                      std::uint64_t base_address = 0,
+                                                      ThreadPool & pool = GetDefaultThreadPool());
+
+/**
+ * @brief   Gives a typed canonical representation of the memory, like od -t does.
+ * Each line shows the offset and the 16 bytes of the line read as values of type T in the given byte order,
+ * right aligned in fields of equal width. Reading 0x00 to 0x2f as big endian std::uint16_t gives:
+ * @code
+ *      0x0000000000000000       1   515  1029  1543  2057  2571  3085  3599
+ *      0x0000000000000010    4113  4627  5141  5655  6169  6683  7197  7711
+ *      0x0000000000000020    8225  8739  9253  9767 10281 10795 11309 11823
+ * @endcode
+ * T may be any integer type of up to 64 bits (signed values are shown with a "-"), float or double (shown in
+ * their shortest round trip form). Numbers are formatted without iostreams, see TypedValueToCharArray(). A
+ * value cut off by the end of the memory is padded with zero bytes.
+ * @tparam  T               the type of the values
+ * @param   array           the char array to show.
+ * @param   size            size of the char array.
+ * @param   endian          byte order of the values
+ * @param   indent          indent of each line
+ * @param   base_address    offset shown for the first byte
+ * @return  a string containing the typed canonical representation of the memory.
+ */
+template <class T>
+inline std::string CharArrayToTypedCanonicalString(char const * array,
+                                                   std::uint64_t size,
+                                                   Endian endian = Endian::kNative,
+                                                   std::string const & indent = {},
+                                                   std::uint64_t base_address = 0);
+
+/**
+ * @brief   Finds the offset of the first byte in which two memory blocks differ.
+ * This is a single vector compare pass without any formatting.
+ * @param   a           the first memory block
+ * @param   a_size      size of the first memory block
+ * @param   b           the second memory block
+ * @param   b_size      size of the second memory block
+ * @return  the offset of the first differing byte, the size of the shorter block if it is a prefix of the
+ *          other one (so equal blocks give their size).
+ */
+inline std::uint64_t FindFirstDifference(char const * a, std::uint64_t a_size, char const * b, std::uint64_t b_size);
+
+/**
+ * @brief   Finds the offset of the first byte in which two memory blocks differ.
+ * @param   a           the first memory block
+ * @param   b           the second memory block
+ * @return  the offset of the first differing byte, the size of the shorter block if it is a prefix of the
+ *          other one (so equal blocks give their size).
+ */
+inline std::uint64_t FindFirstDifference(std::vector<std::byte> const & a, std::vector<std::byte> const & b);
 
 /**
  * @brief   Converts a hex string to a memory.
@@ -56,6 +344,109 @@ inline std::string CharArrayToCanonicalString(char const * array, std::uint64_t
  */
 inline std::vector<std::byte> HexToMemory(std::string const & hex);
 
+/**
+ * @brief   Converts a hex string to a memory into a caller supplied buffer.
+ * Other than that this behaves like HexToMemory(std::string const &) and does not allocate.
+ * If the buffer is too small, only the first capacity bytes are converted.
+ * @param   memory      the buffer to write to.
+ * @param   capacity    size of the buffer in bytes.
+ * @param   hex         the hex string describing a memory.
+ * @return  Number of bytes written.
+ */
+inline std::uint64_t HexToMemory(std::byte * memory, std::uint64_t capacity, std::string_view hex);
+
+/**
+ * @brief   Converts a hex string to a memory and appends it to an existing memory.
+ * Reusing the memory across calls avoids any allocation once its capacity suffices.
+ * @tparam  Allocator   the allocator of the memory (see ByteBuffer)
+ * @param   memory      the memory to append to.
+ * @param   hex         the hex string describing a memory.
+ * @return  Number of bytes appended.
+ */
+template <class Allocator>
+inline std::uint64_t HexToMemory(std::vector<std::byte, Allocator> & memory, std::string_view hex);
+
+/**
+ * @brief   Converts a hex string to a memory using several threads.
+ * The hex string is split into chunks of 2 * kParallelChunkSize characters which are converted concurrently
+ * straight into the result. Hex strings shorter than 2 * kParallelMinSize are converted on the calling thread.
+ * The result equals HexToMemory(hex).
+ * @param   hex         the hex string describing a memory.
+ * @param   pool        the threads to use.
+ * @return  A memory block based on this hex string.
+ */
+inline std::vector<std::byte> HexToMemoryParallel(std::string const & hex, ThreadPool & pool = GetDefaultThreadPool());
+
+/**
+ * @brief   Converts a hex string to a memory, rejecting any invalid character.
+ * Other than HexToMemory this stops at the first character not in [0-9a-fA-F].
+ * A hex string with an odd number of characters is invalid at its last character.
+ * @tparam  Allocator           the allocator of the memory block (see ByteBuffer)
+ * @param   hex                 the hex string describing a memory.
+ * @param   memory              receives the memory block (cleared on failure).
+ * @param   invalid_position    if not nullptr, receives the offset of the first invalid character on failure.
+ * @return  true, if the hex string has been valid and converted.
+ */
+template <class Allocator>
+inline bool HexToMemoryStrict(std::string const & hex,
+                              std::vector<std::byte, Allocator> & memory,
+                              std::uint64_t * invalid_position = nullptr);
+
+/**
+ * @brief   Gives the canonical representation of only those lines in which two memory blocks differ.
+ * See CharArrayDiffToCanonicalString().
+ * @tparam  Layout          the canonical layout
+ * @param   a               the first memory block
+ * @param   b               the second memory block
+ * @param   style           interleaved or side by side
+ * @param   context         number of equal lines shown around differing lines
+ * @param   indent          indent of each line
+ * @return  the canonical representation of the differing lines.
+ */
+template <class Layout = CanonicalLayoutDefault>
+inline std::string MemoryDiffToCanonicalString(std::vector<std::byte> const & a,
+                                               std::vector<std::byte> const & b,
+                                               CanonicalDiffStyle style = CanonicalDiffStyle::kInterleaved,
+                                               std::uint64_t context = 3,
+                                               std::string const & indent = {});
+
+/**
+ * @brief   Converts a memory area to an Ascii85 string.
+ * Each 4 bytes take 5 chars in '!' to 'u'. A last group of 1 to 3 bytes takes 1 char more than it has
+ * bytes. No "<~" "~>" delimiters are added and zero groups are not abbreviated with 'z'.
+ * @param   memory      the memory to convert.
+ * @return  A string holding the Ascii85 representation.
+ */
+inline std::string MemoryToAscii85(std::vector<std::byte> const & memory);
+
+/**
+ * @brief   Converts a memory area to an Ascii85 string.
+ * @param   memory      the memory to convert.
+ * @param   size        size of the memory to convert.
+ * @return  A string holding the Ascii85 representation.
+ */
+inline std::string MemoryToAscii85(char const * memory, std::uint64_t size);
+
+/**
+ * @brief   Converts a memory area to a Base64 string (RFC 4648).
+ * @param   memory      the memory to convert.
+ * @param   alphabet    the Base64 alphabet, kStandard output is padded with '=', kUrl output is not.
+ * @return  A string holding the Base64 representation.
+ */
+inline std::string MemoryToBase64(std::vector<std::byte> const & memory,
+                                  Base64Alphabet alphabet = Base64Alphabet::kStandard);
+
+/**
+ * @brief   Converts a memory area to a Base64 string (RFC 4648).
+ * @param   memory      the memory to convert.
+ * @param   size        size of the memory to convert.
+ * @param   alphabet    the Base64 alphabet, kStandard output is padded with '=', kUrl output is not.
+ * @return  A string holding the Base64 representation.
+ */
+inline std::string MemoryToBase64(char const * memory,
+                                  std::uint64_t size,
+                                  Base64Alphabet alphabet = Base64Alphabet::kStandard);
+
 /**
  * @brief   Gives a canonical representation of the memory.
  * The canonical representation is separated in different columns.
@@ -68,11 +459,36 @@ inline std::vector<std::byte> HexToMemory(std::string const & hex);
  *       0x0000000000000020   20 21 22 23 24 25 26 27  28 29 2a 2b 2c 2d 2e 2f   | !"#$%&' ()*+,-./|
  *       ...
  * @endcode
- * @param   memory      the memory to show.
- * @param   indent      indent of each line
+ * With squeeze set runs of repeated lines are replaced by "*" as in CharArrayToCanonicalStream(). Other layouts
+ * are picked with the Layout parameter, see CanonicalLayout.
+ * @tparam  Layout          the canonical layout
+ * @param   memory          the memory to show.
+ * @param   indent          indent of each line
+ * @param   squeeze         replace runs of repeated lines by "*"
+ * @param   base_address    offset shown for the first byte
  * @return  a string containing the canonical representation of the memory.
  */
-inline std::string MemoryToCanonicalString(std::vector<std::byte> const & memory, std::string const & indent = {});
+template <class Layout = CanonicalLayoutDefault>
+inline std::string MemoryToCanonicalString(std::vector<std::byte> const & memory,
+                                           std::string const & indent = {},
+                                           bool squeeze = false,
+                                           std::uint64_t base_address = 0);
+
+/**
+ * @brief   Gives a canonical representation of the memory using several threads.
+ * See CharArrayToCanonicalStringParallel().
+ * @tparam  Layout          the canonical layout
+ * @param   memory          the memory to show.
+ * @param   indent          indent of each line
+ * @param   base_address    offset shown for the first byte
+ * @param   pool            the threads to use.
+ * @return  a string containing the canonical representation of the memory.
+ */
+template <class Layout = CanonicalLayoutDefault>
+inline std::string MemoryToCanonicalStringParallel(std::vector<std::byte> const & memory,
+                                                   std::string const & indent = {},
+                                                   std::uint64_t base_address = 0,
+                                                   ThreadPool & pool = GetDefaultThreadPool());
 
 /**
  * @brief   Converts a memory area to a hex-string.
@@ -89,6 +505,84 @@ inline std::string MemoryToHex(std::vector<std::byte> const & memory);
  */
 inline std::string MemoryToHex(char const * memory, std::uint64_t size);
 
+/**
+ * @brief   Converts a memory area to hex into a caller supplied buffer.
+ * If the buffer is too small, only the first capacity / 2 bytes are converted.
+ * @param   hex         the buffer to write to.
+ * @param   capacity    size of the buffer in chars.
+ * @param   memory      the memory to convert.
+ * @param   size        size of the memory to convert.
+ * @return  Number of chars written.
+ */
+inline std::uint64_t MemoryToHex(char * hex, std::uint64_t capacity, char const * memory, std::uint64_t size);
+
+/**
+ * @brief   Converts a memory area to hex and appends it to an existing string.
+ * Reusing the string across calls avoids any allocation once its capacity suffices.
+ * @param   hex         the string to append to.
+ * @param   memory      the memory to convert.
+ * @param   size        size of the memory to convert.
+ * @return  Number of chars appended.
+ */
+inline std::uint64_t MemoryToHex(std::string & hex, char const * memory, std::uint64_t size);
+
+/**
+ * @brief   Converts a memory area to a hex-string using several threads.
+ * The memory is split into chunks of kParallelChunkSize bytes which are converted concurrently straight
+ * into the result. Memory smaller than kParallelMinSize is converted on the calling thread.
+ * @param   memory      the memory to convert.
+ * @param   pool        the threads to use.
+ * @return  A hex string representing this memory.
+ */
+inline std::string MemoryToHexParallel(std::vector<std::byte> const & memory,
+                                       ThreadPool & pool = GetDefaultThreadPool());
+
+/**
+ * @brief   Converts a memory area to a hex-string using several threads.
+ * The memory is split into chunks of kParallelChunkSize bytes which are converted concurrently straight
+ * into the result. Memory smaller than kParallelMinSize is converted on the calling thread.
+ * @param   memory      the memory to convert.
+ * @param   size        size of the memory to convert.
+ * @param   pool        the threads to use.
+ * @return  A hex string representing this memory.
+ */
+inline std::string MemoryToHexParallel(char const * memory,
+                                       std::uint64_t size,
+                                       ThreadPool & pool = GetDefaultThreadPool());
+
+/**
+ * @brief   Gives a typed canonical representation of the memory, like od -t does.
+ * See CharArrayToTypedCanonicalString().
+ * @tparam  T               the type of the values
+ * @param   memory          the memory to show.
+ * @param   endian          byte order of the values
+ * @param   indent          indent of each line
+ * @param   base_address    offset shown for the first byte
+ * @return  a string containing the typed canonical representation of the memory.
+ */
+template <class T>
+inline std::string MemoryToTypedCanonicalString(std::vector<std::byte> const & memory,
+                                                Endian endian = Endian::kNative,
+                                                std::string const & indent = {},
+                                                std::uint64_t base_address = 0);
+
+/**
+ * @brief   Converts a memory area to a Z85 string (ZeroMQ RFC 32).
+ * Each 4 bytes take 5 chars, which are safe within JSON strings and source code. Other than RFC 32
+ * any size is accepted: a last group of 1 to 3 bytes takes 1 char more than it has bytes.
+ * @param   memory      the memory to convert.
+ * @return  A string holding the Z85 representation.
+ */
+inline std::string MemoryToZ85(std::vector<std::byte> const & memory);
+
+/**
+ * @brief   Converts a memory area to a Z85 string (ZeroMQ RFC 32).
+ * @param   memory      the memory to convert.
+ * @param   size        size of the memory to convert.
+ * @return  A string holding the Z85 representation.
+ */
+inline std::string MemoryToZ85(char const * memory, std::uint64_t size);
+
 /**
  * @brief   Convenient function to quickly convert a string to a memory block.
  * @param   str         the string to convert
@@ -96,6 +590,22 @@ inline std::string MemoryToHex(char const * memory, std::uint64_t size);
  */
 inline std::vector<std::byte> StringToMemory(std::string const & str);
 
+/**
+ * @brief   Converts a Z85 string to a memory, rejecting anything not strictly Z85.
+ * Each group of 5 chars yields 4 bytes. A last group of 2 to 4 chars yields 1 char less bytes,
+ * as written by MemoryToZ85.
+ * @tparam  Allocator           the allocator of the memory block (see ByteBuffer)
+ * @param   z85                 the Z85 string describing a memory.
+ * @param   memory              receives the memory block (cleared on failure).
+ * @param   invalid_position    if not nullptr, receives the offset of the first invalid character on failure
+ *                              (the start of a group exceeding 32 bits) or the size of the string if it ends early.
+ * @return  true, if the Z85 string has been valid and converted.
+ */
+template <class Allocator>
+inline bool Z85ToMemory(std::string const & z85,
+                        std::vector<std::byte, Allocator> & memory,
+                        std::uint64_t * invalid_position = nullptr);
+
 }
 
 
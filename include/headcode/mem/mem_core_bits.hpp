@@ -13,48 +13,84 @@
 #error "Do not include this file directly."
 #endif
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
 #include <cstddef>
 #include <cstring>
 #include <iomanip>
-#include <map>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include <unistd.h>
+
+#include "mem_allocator.hpp"
+#include "mem_canonical.hpp"
+#include "mem_simd.hpp"
+
 
 /**
  * @brief   The headcode mem namespace
  */
 namespace headcode::mem {
 
+/**
+ * @brief   Converts a single byte to its two hex chars.
+ * This does not allocate and is safe to call from any thread at any time.
+ * @param   c       The char to convert.
+ * @return  The two hex chars of this byte.
+ */
+constexpr std::array<char, 2> CharToHexChars(unsigned char c) {
+    return simd::kByteToHex[c];
+}
+
+/**
+ * @brief   Converts a single byte to its two hex chars.
+ * This does not allocate and is safe to call from any thread at any time.
+ * @param   b       The Byte.
+ * @return  The two hex chars of this byte.
+ */
+constexpr std::array<char, 2> ByteToHexChars(std::byte b) {
+    return simd::kByteToHex[static_cast<unsigned char>(b)];
+}
+
 /**
  * @brief   Converts a single byte to its hex representation.
  * @param   c       The char to convert.
  * @return  The hex value of this byte.
  */
 inline std::string CharToHex(unsigned char c) {
+    return std::string{simd::kByteToHex[c].data(), 2};
+}
 
-    static bool initialized = false;
-    static std::array<std::string, 256> table;
-    if (!initialized) {
-
-        auto CharToHexString = [](unsigned char c) -> std::string {
-            std::string res{"00"};
-            static char const * field = "0123456789abcdef";
-            res[0] = field[c >> 4u];
-            res[1] = field[c & 0x0fu];
-            return res;
-        };
-
-        for (int i = 0; i < 256; ++i) {
-            table[i] = CharToHexString(static_cast<unsigned char>(i));
-        }
-
-        initialized = true;
+/**
+ * @brief   Writes the hex representation of a single byte into a buffer.
+ * @param   hex         the buffer to write to.
+ * @param   capacity    size of the buffer.
+ * @param   c           The char to convert.
+ * @return  Number of chars written: 2 or 0 if the buffer is too small.
+ */
+inline std::uint64_t CharToHex(char * hex, std::uint64_t capacity, unsigned char c) {
+    if (capacity < 2) {
+        return 0;
     }
+    hex[0] = simd::kByteToHex[c][0];
+    hex[1] = simd::kByteToHex[c][1];
+    return 2;
+}
 
-    return table[c];
+/**
+ * @brief   Appends the hex representation of a single byte to a string.
+ * @param   hex         the string to append to.
+ * @param   c           The char to convert.
+ * @return  Number of chars appended.
+ */
+inline std::uint64_t CharToHex(std::string & hex, unsigned char c) {
+    hex.append(simd::kByteToHex[c].data(), 2);
+    return 2;
 }
 
 /**
@@ -66,6 +102,27 @@ inline std::string ByteToHex(std::byte b) {
     return CharToHex(static_cast<unsigned char>(b));
 }
 
+/**
+ * @brief   Writes the hex representation of a single byte into a buffer.
+ * @param   hex         the buffer to write to.
+ * @param   capacity    size of the buffer.
+ * @param   b           The Byte.
+ * @return  Number of chars written: 2 or 0 if the buffer is too small.
+ */
+inline std::uint64_t ByteToHex(char * hex, std::uint64_t capacity, std::byte b) {
+    return CharToHex(hex, capacity, static_cast<unsigned char>(b));
+}
+
+/**
+ * @brief   Appends the hex representation of a single byte to a string.
+ * @param   hex         the string to append to.
+ * @param   b           The Byte.
+ * @return  Number of chars appended.
+ */
+inline std::uint64_t ByteToHex(std::string & hex, std::byte b) {
+    return CharToHex(hex, static_cast<unsigned char>(b));
+}
+
 /**
  * @brief   Convert a hex string to a byte.
  * @param   sv      the string view
@@ -73,223 +130,962 @@ inline std::string ByteToHex(std::byte b) {
  */
 inline std::byte HexToByte(std::string_view const & sv) {
 
-    static std::map<char, unsigned char> const hex_to_byte{
-            {'0', 0x0}, {'1', 0x1}, {'2', 0x2}, {'3', 0x3}, {'4', 0x4}, {'5', 0x5}, {'6', 0x6}, {'7', 0x7},
-            {'8', 0x8}, {'9', 0x9}, {'a', 0xa}, {'b', 0xb}, {'c', 0xc}, {'d', 0xd}, {'e', 0xe}, {'f', 0xf},
-            {'A', 0xa}, {'B', 0xb}, {'C', 0xc}, {'D', 0xd}, {'F', 0xe}, {'F', 0xf}};
-
     if (sv.size() < 2) {
         return static_cast<std::byte>(0);
     }
 
     unsigned char value{0};
+    simd::HexDecodeScalar(&value, sv.data(), 2, false);
+    return static_cast<std::byte>(value);
+}
 
-    auto iter_first = hex_to_byte.find(sv[0]);
-    if (iter_first != hex_to_byte.end()) {
-        value = iter_first->second << 4u;
-    }
+/**
+ * @brief   Appends bytes produced by a writer to a memory block, writing each byte of the memory block once.
+ * Growing a std::vector<std::byte> by resize() zero fills the bytes about to be overwritten. So the writer fills a
+ * cache resident block which is then appended by a copy; only a ByteBuffer is resized and written to directly.
+ * The capacity grows geometrically, so appending in many calls stays amortized O(1) per byte.
+ * @tparam  Allocator   the allocator of the memory block
+ * @tparam  Writer      std::uint64_t (unsigned char * dst, std::uint64_t offset, std::uint64_t count): writes up to
+ *                      count bytes starting at byte offset of the bytes appended, returns the number written; less
+ *                      than count stops the append
+ * @param   memory      the memory block to append to
+ * @param   size        the number of bytes to append
+ * @param   writer      the writer
+ * @return  the number of bytes appended
+ */
+template <class Allocator, class Writer>
+inline std::uint64_t AppendToMemory(std::vector<std::byte, Allocator> & memory, std::uint64_t size, Writer writer) {
 
-    auto iter_second = hex_to_byte.find(sv[1]);
-    if (iter_second != hex_to_byte.end()) {
-        value = value | iter_second->second;
+    auto old_size = memory.size();
+    if (memory.capacity() < old_size + size) {
+        memory.reserve(std::max<std::uint64_t>(old_size + size, memory.capacity() * 2));
     }
 
-    return static_cast<std::byte>(value);
+    if constexpr (std::is_same_v<Allocator, DefaultInitAllocator<std::byte>>) {
+        memory.resize(old_size + size);
+        auto written = writer(reinterpret_cast<unsigned char *>(memory.data() + old_size), 0, size);
+        memory.resize(old_size + written);
+        return written;
+    } else {
+        // a multiple of 3 and 4 bytes, so Base64 and Base85 groups are not split
+        constexpr std::uint64_t block_size = 12 * 1024;
+        unsigned char block[block_size];
+        std::uint64_t offset = 0;
+        while (offset < size) {
+            auto count = std::min(block_size, size - offset);
+            auto written = writer(block, offset, count);
+            auto first = reinterpret_cast<std::byte const *>(block);
+            memory.insert(memory.end(), first, first + written);
+            offset += written;
+            if (written < count) {
+                break;
+            }
+        }
+        return offset;
+    }
 }
 
 /**
- * @brief   Write a single line of memory as ascii
- * Writes a memory line like:
- *      The quic k brown
- * @param   dst             dst to write at least 16 bytes + gap_size large
- * @param   src             the memory to write
- * @param   src_size        size of memory to write
- * @param   gap_size        size of the gap
+ * @brief   Converts a Base85 string to a memory.
+ * @tparam  Allocator           the allocator of the memory block
+ * @param   text                the Base85 string
+ * @param   memory              receives the memory block (cleared on failure)
+ * @param   alphabet            the Base85 alphabet, kAscii85 accepts 'z' for a zero group
+ * @param   invalid_position    if not nullptr, receives the offset of the first invalid character on failure
+ * @return  true, if the Base85 string has been valid and converted.
  */
-inline void DumpAsciiLine(char * dst, char const * src, std::uint64_t src_size, std::uint64_t gap_size) {
+template <class Allocator>
+inline bool Base85ToMemory(std::string const & text,
+                           std::vector<std::byte, Allocator> & memory,
+                           Base85Alphabet alphabet,
+                           std::uint64_t * invalid_position) {
+
+    auto fail = [&](std::uint64_t position) {
+        memory.clear();
+        if (invalid_position) {
+            *invalid_position = position;
+        }
+        return false;
+    };
+
+    auto size = text.size();
+    bool ascii85 = alphabet == Base85Alphabet::kAscii85;
+    std::uint64_t zeros = ascii85 ? static_cast<std::uint64_t>(std::count(text.begin(), text.end(), 'z')) : 0;
+    auto chars = size - zeros;
+    memory.clear();
+    memory.reserve(chars / 5 * 4 + (chars % 5 > 1 ? chars % 5 - 1 : 0) + zeros * 4);
 
     std::uint64_t pos = 0;
-    for (std::uint64_t i = 0; i < src_size; ++i) {
+    while (pos < size) {
+
+        if (ascii85 && (text[pos] == 'z')) {
+            memory.insert(memory.end(), 4, std::byte{0});
+            ++pos;
+            continue;
+        }
+
+        auto groups = (size - pos) / 5 * 5;
+        if (groups == 0) {
+            break;
+        }
+        auto src = text.data() + pos;
+        std::uint64_t invalid = groups;
+        auto written = AppendToMemory(memory, groups / 5 * 4, [&](unsigned char * dst, auto offset, auto count) {
+            auto decoded = simd::Base85Decode(dst, src + offset / 4 * 5, count / 4 * 5, alphabet);
+            if (decoded != count / 4 * 5) {
+                invalid = offset / 4 * 5 + decoded;
+            }
+            return decoded / 5 * 4;
+        });
+        pos += written / 4 * 5;
+        if ((invalid != groups) && !(ascii85 && (invalid % 5 == 0) && (text[pos] == 'z'))) {
+            return fail(pos + invalid % 5);
+        }
+    }
 
-        bool printable = ((src[i] & 0x80) == 0x00) && (src[i] >= 0x20);
-        dst[pos] = printable ? src[i] : '.';
-        pos++;
+    // a last partial group is padded with the highest digit and must be just as MemoryToZ85 writes it
+    auto tail = size - pos;
+    if (tail == 1) {
+        return fail(size);
+    }
+    if (tail > 1) {
+        auto const & table = simd::kBase85ToDigit[static_cast<unsigned int>(alphabet)];
+        std::uint64_t value = 0;
+        for (std::uint64_t i = 0; i < 5; ++i) {
+            auto digit = i < tail ? table[static_cast<unsigned char>(text[pos + i])] : 84;
+            if (digit == 0xff) {
+                return fail(pos + i);
+            }
+            value = value * 85 + digit;
+        }
+        if (value > 0xffffffffu) {
+            return fail(pos);
+        }
 
-        if (i == 7) {
-            pos += gap_size;
+        char group[5];
+        simd::Base85EncodeGroup(group,
+                                static_cast<std::uint32_t>(value) & (0xffffffffu << (8u * (5u - tail))),
+                                simd::kBase85Chars[static_cast<unsigned int>(alphabet)].data());
+        for (std::uint64_t i = 0; i < tail; ++i) {
+            if (group[i] != text[pos + i]) {
+                return fail(pos + i);
+            }
+        }
+        for (std::uint64_t i = 0; i + 1 < tail; ++i) {
+            memory.push_back(static_cast<std::byte>(value >> (24u - 8u * i)));
         }
     }
+
+    return true;
 }
 
+}
 
-/**
- * @brief   Write a single line of memory
- * Writes a memory line like:
- *      20 21 22 23 24 25 26 27  28 29 2a 2b 2c 2d 2e 2f
- * @param   dst             dst to write at least 46 bytes + gap_size large
- * @param   src             the memory to write
- * @param   src_size        size of memory to write
- * @param   gap_size        size of the gap
- */
-inline void DumpHexLine(char * dst, char const * src, std::uint64_t src_size, std::uint64_t gap_size) {
+template <class Allocator>
+inline bool headcode::mem::Ascii85ToMemory(std::string const & ascii85,
+                                           std::vector<std::byte, Allocator> & memory,
+                                           std::uint64_t * invalid_position) {
+    return Base85ToMemory(ascii85, memory, Base85Alphabet::kAscii85, invalid_position);
+}
 
-    static char const * table = "0123456789abcdef";
 
-    // places in the dst to write chars to (2 bytes each) including a space in between
-    std::uint64_t pos[16] = {0x00, 0x03, 0x06, 0x09, 0x0c, 0x0f, 0x12, 0x15,
-                             0x17, 0x1a, 0x1d, 0x20, 0x23, 0x26, 0x29, 0x2c};
+template <class Allocator>
+inline bool headcode::mem::Base64ToMemory(std::string const & base64,
+                                          std::vector<std::byte, Allocator> & memory,
+                                          Base64Alphabet alphabet,
+                                          std::uint64_t * invalid_position) {
 
-    // add gap between the words
-    if (src_size > 8) {
-        for (std::uint64_t i = 8; i < 16; ++i) {
-            pos[i] += gap_size;
+    auto fail = [&](std::uint64_t position) {
+        memory.clear();
+        if (invalid_position) {
+            *invalid_position = position;
         }
+        return false;
+    };
+
+    // split into complete groups of 4 chars and the data chars of a last padded or partial group
+    auto size = base64.size();
+    std::uint64_t body = size;
+    std::uint64_t tail = 0;
+    if (size % 4 != 0) {
+        if ((alphabet != Base64Alphabet::kUrl) || (size % 4 == 1)) {
+            return fail(size);
+        }
+        body = size - size % 4;
+        tail = size % 4;
+    } else if ((size > 0) && (base64[size - 1] == '=')) {
+        body = size - 4;
+        tail = base64[size - 2] == '=' ? 2 : 3;
     }
 
-    for (std::uint64_t i = 0; i < src_size; ++i) {
-        dst[pos[i]] = table[(src[i] & 0xf0) >> 4];
-        dst[pos[i] + 1] = table[src[i] & 0x0f];
+    memory.clear();
+    memory.reserve(body / 4 * 3 + (tail > 0 ? tail - 1 : 0));
+    std::uint64_t invalid = body;
+    AppendToMemory(memory, body / 4 * 3, [&](unsigned char * dst, auto offset, auto count) {
+        auto decoded = simd::Base64Decode(dst, base64.data() + offset / 3 * 4, count / 3 * 4, alphabet);
+        if (decoded != count / 3 * 4) {
+            invalid = offset / 3 * 4 + decoded;
+        }
+        return decoded / 4 * 3;
+    });
+    if (invalid != body) {
+        return fail(invalid);
     }
+
+    if (tail > 0) {
+        auto const & table = simd::kBase64ToSextet[static_cast<unsigned int>(alphabet)];
+        std::uint32_t v = 0;
+        for (std::uint64_t i = 0; i < tail; ++i) {
+            auto sextet = table[static_cast<unsigned char>(base64[body + i])];
+            if (sextet & 0xc0u) {
+                return fail(body + i);
+            }
+            v |= std::uint32_t{sextet} << (18u - 6u * i);
+        }
+        // the bits of the last char beyond the last byte must be 0
+        if ((tail == 2 ? v & 0xffffu : v & 0xffu) != 0) {
+            return fail(body + tail - 1);
+        }
+        memory.push_back(static_cast<std::byte>(v >> 16u));
+        if (tail == 3) {
+            memory.push_back(static_cast<std::byte>(v >> 8u));
+        }
+    }
+
+    return true;
 }
 
-/**
- * @brief   Convert a number to a hex presentation.
- * @param   array       the char array to write must be a minimum of 16 bytes
- * @param   number      the number to write
- */
-inline void HexNumberToCharArray(char * array, std::uint64_t number) {
-    array[0xf] = static_cast<char>(number & 0x000000000000000ful) + '0';
-    array[0xe] = static_cast<char>((number & 0x00000000000000f0ul) >> 4) + '0';
-    array[0xd] = static_cast<char>((number & 0x0000000000000f00ul) >> 8) + '0';
-    array[0xc] = static_cast<char>((number & 0x000000000000f000ul) >> 12) + '0';
-    array[0xb] = static_cast<char>((number & 0x00000000000f0000ul) >> 16) + '0';
-    array[0xa] = static_cast<char>((number & 0x0000000000f00000ul) >> 20) + '0';
-    array[0x9] = static_cast<char>((number & 0x000000000f000000ul) >> 24) + '0';
-    array[0x8] = static_cast<char>((number & 0x00000000f0000000ul) >> 28) + '0';
-    array[0x7] = static_cast<char>((number & 0x0000000f00000000ul) >> 32) + '0';
-    array[0x6] = static_cast<char>((number & 0x000000f000000000ul) >> 34) + '0';
-    array[0x5] = static_cast<char>((number & 0x00000f0000000000ul) >> 38) + '0';
-    array[0x4] = static_cast<char>((number & 0x0000f00000000000ul) >> 42) + '0';
-    array[0x3] = static_cast<char>((number & 0x000f000000000000ul) >> 46) + '0';
-    array[0x2] = static_cast<char>((number & 0x00f0000000000000ul) >> 50) + '0';
-    array[0x1] = static_cast<char>((number & 0x0f00000000000000ul) >> 54) + '0';
-    array[0x0] = static_cast<char>((number & 0xf000000000000000ul) >> 60) + '0';
+
+template <class Layout, class Allocator>
+inline bool headcode::mem::CanonicalStringToMemory(std::string_view canonical,
+                                                   std::vector<std::byte, Allocator> & memory,
+                                                   std::uint64_t * base_address,
+                                                   std::uint64_t * invalid_position) {
+
+    using Geometry = CanonicalGeometry<Layout>;
+    constexpr auto bytes_per_line = Layout::kBytesPerLine;
+    constexpr std::uint64_t lines_per_batch = 4096;
+    constexpr std::uint64_t offset_mask =
+            (Layout::kOffsetDigits == 16) ? ~0ul : (1ul << (Layout::kOffsetDigits * 4)) - 1;
+
+    memory.clear();
+    if (base_address) {
+        *base_address = 0;
+    }
+    auto fail = [&](std::uint64_t position) {
+        memory.clear();
+        if (invalid_position) {
+            *invalid_position = position;
+        }
+        return false;
+    };
+    if (canonical.empty()) {
+        return true;
+    }
+
+    // the indent is whatever precedes the "0x" of the first line
+    auto indent_size = canonical.substr(0, canonical.find('\n')).find("0x");
+    if (indent_size == std::string_view::npos) {
+        return fail(0);
+    }
+    auto indent = canonical.substr(0, indent_size);
+    auto line_size = indent_size + Geometry::kLineSize;
+
+    // checks the indent and the "0x" of a line with enough chars
+    auto is_line = [&](char const * line) {
+        return (std::memcmp(line, indent.data(), indent_size) == 0) && (line[indent_size] == '0') &&
+               (line[indent_size + 1] == 'x');
+    };
+
+    // reads the offset of a line, returns the position of an invalid digit or 0
+    auto read_offset = [&](std::uint64_t position, std::uint64_t & offset) -> std::uint64_t {
+        offset = 0;
+        for (std::uint64_t i = 0; i < Layout::kOffsetDigits; ++i) {
+            auto digit = position + indent_size + 2 + i;
+            auto nibble = simd::kHexToNibble[static_cast<unsigned char>(canonical[digit])];
+            if (nibble & 0xf0) {
+                return digit;
+            }
+            offset = (offset << 4) | nibble;
+        }
+        return 0;
+    };
+
+    // full lines are gathered into a batch of hex chars at their fixed positions and decoded at once
+    std::vector<char> hex(lines_per_batch * bytes_per_line * 2);
+    std::uint64_t batch_start = 0;
+    std::uint64_t batch_lines = 0;
+    std::uint64_t invalid = 0;
+    auto decode = [&](std::uint64_t lines, std::uint64_t bytes) {
+        std::uint64_t decoded = bytes * 2;
+        AppendToMemory(memory, bytes, [&](unsigned char * dst, auto first, auto count) {
+            auto result = simd::HexDecode(dst, hex.data() + first * 2, count * 2, true);
+            if (result != count * 2) {
+                decoded = first * 2 + result;
+            }
+            return result / 2;
+        });
+        if (decoded != bytes * 2) {
+            auto line = decoded / (bytes_per_line * 2);
+            auto in_line = decoded % (bytes_per_line * 2);
+            invalid = batch_start + line * line_size + indent_size + Geometry::kData +
+                      Geometry::HexPosition(in_line / 2) + in_line % 2;
+            return false;
+        }
+        batch_lines -= lines;
+        return true;
+    };
+    auto gather = [&](char const * line, std::uint64_t bytes) {
+        auto src = line + indent_size + Geometry::kData;
+        auto dst = hex.data() + batch_lines * bytes_per_line * 2;
+        for (std::uint64_t i = 0; i < bytes; ++i) {
+            dst[i * 2] = src[Geometry::HexPosition(i)];
+            dst[i * 2 + 1] = src[Geometry::HexPosition(i) + 1];
+        }
+        ++batch_lines;
+    };
+
+    std::uint64_t offset = 0;
+    if (canonical.size() < indent_size + 2 + Layout::kOffsetDigits) {
+        return fail(0);
+    }
+    if (auto digit = read_offset(0, offset); digit != 0) {
+        return fail(digit);
+    }
+    if (base_address) {
+        *base_address = offset;
+    }
+    offset -= bytes_per_line;
+
+    std::uint64_t position = 0;
+    std::string padded;
+    while (position < canonical.size()) {
+
+        auto end = std::min(canonical.find('\n', position), canonical.size());
+        auto line = canonical.data() + position;
+        auto length = end - position;
+
+        if ((length == indent_size + 1) && (line[indent_size] == '*') &&
+            (std::memcmp(line, indent.data(), indent_size) == 0)) {
+
+            // repeat the last line up to the offset of the next line
+            if ((batch_lines > 0) && !decode(batch_lines, batch_lines * bytes_per_line)) {
+                return fail(invalid);
+            }
+            position = end + 1;
+            if ((memory.empty()) || (memory.size() % bytes_per_line != 0) ||
+                (position + indent_size + 2 + Layout::kOffsetDigits > canonical.size()) ||
+                !is_line(canonical.data() + position)) {
+                return fail(position);
+            }
+            std::uint64_t next_offset = 0;
+            if (auto digit = read_offset(position, next_offset); digit != 0) {
+                return fail(digit);
+            }
+            auto distance = (next_offset - offset) & offset_mask;
+            if ((distance % bytes_per_line != 0) || (distance < 2 * bytes_per_line)) {
+                return fail(position + indent_size + 2);
+            }
+            auto repeats = distance / bytes_per_line - 1;
+            std::array<unsigned char, bytes_per_line> last_line;
+            std::copy_n(reinterpret_cast<unsigned char const *>(memory.data() + memory.size() - bytes_per_line),
+                        bytes_per_line,
+                        last_line.data());
+            AppendToMemory(memory, repeats * bytes_per_line, [&](unsigned char * dst, auto first, auto count) {
+                for (std::uint64_t i = 0; i < count;) {
+                    auto in_line = (first + i) % bytes_per_line;
+                    auto n = std::min(bytes_per_line - in_line, count - i);
+                    std::copy_n(last_line.data() + in_line, n, dst + i);
+                    i += n;
+                }
+                return count;
+            });
+            offset += repeats * bytes_per_line;
+            continue;
+        }
+
+        // the last line may lack its trailing blanks
+        if ((end == canonical.size()) && (length < line_size - 1) && (length >= indent_size + Geometry::kData + 2)) {
+            padded.assign(line, length);
+            padded.resize(line_size - 1, ' ');
+            line = padded.data();
+            length = line_size - 1;
+        }
+        if ((length != line_size - 1) || !is_line(line)) {
+            return fail(position);
+        }
+
+        // each line must continue at the offset following the previous one
+        std::uint64_t line_offset = 0;
+        if (auto digit = read_offset(position, line_offset); digit != 0) {
+            return fail(digit);
+        }
+        auto expected = (offset + bytes_per_line) & offset_mask;
+        if (line_offset != expected) {
+            std::uint64_t i = 0;
+            for (auto shift = (Layout::kOffsetDigits - 1) * 4;
+                 ((line_offset >> shift) & 0x0f) == ((expected >> shift) & 0x0f);
+                 shift -= 4) {
+                ++i;
+            }
+            return fail(position + indent_size + 2 + i);
+        }
+
+        if (batch_lines == 0) {
+            batch_start = position;
+        }
+        if (line[indent_size + Geometry::kData + Geometry::HexPosition(bytes_per_line - 1)] != ' ') {
+            gather(line, bytes_per_line);
+            if ((batch_lines == lines_per_batch) && !decode(batch_lines, batch_lines * bytes_per_line)) {
+                return fail(invalid);
+            }
+        } else {
+            // a partial line ends the memory
+            if (end + 1 < canonical.size()) {
+                return fail(position);
+            }
+            std::uint64_t bytes = 0;
+            while (line[indent_size + Geometry::kData + Geometry::HexPosition(bytes)] != ' ') {
+                ++bytes;
+            }
+            if (bytes == 0) {
+                return fail(position);
+            }
+            gather(line, bytes);
+            if (!decode(batch_lines, (batch_lines - 1) * bytes_per_line + bytes)) {
+                return fail(invalid);
+            }
+        }
+        offset += bytes_per_line;
+        position = end + 1;
+    }
+
+    if ((batch_lines > 0) && !decode(batch_lines, batch_lines * bytes_per_line)) {
+        return fail(invalid);
+    }
+    return true;
 }
 
+
+template <class Layout>
+inline std::string headcode::mem::CharArrayDiffToCanonicalString(char const * a,
+                                                                 std::uint64_t a_size,
+                                                                 char const * b,
+                                                                 std::uint64_t b_size,
+                                                                 CanonicalDiffStyle style,
+                                                                 std::uint64_t context,
+                                                                 std::string const & indent) {
+
+    constexpr auto bytes_per_line = Layout::kBytesPerLine;
+
+    auto lines = (std::max(a_size, b_size) + bytes_per_line - 1) / bytes_per_line;
+    auto templ = CanonicalLineTemplate<Layout>({});
+    auto width = templ.size() - 1;
+    std::string a_line(templ.size(), '\0');
+    std::string b_line(templ.size(), '\0');
+
+    std::string res;
+    auto write_line = [&](std::uint64_t line) {
+
+        bool in_a = line * bytes_per_line < a_size;
+        bool in_b = line * bytes_per_line < b_size;
+        bool differs = CanonicalLineDiffers<Layout>(a, a_size, b, b_size, line);
+        if (in_a) {
+            DumpCanonicalLines<Layout>(a_line.data(), templ, 0, a, a_size, line, 1);
+        }
+        if (in_b) {
+            DumpCanonicalLines<Layout>(b_line.data(), templ, 0, b, b_size, line, 1);
+        }
+
+        if (style == CanonicalDiffStyle::kSideBySide) {
+            res += indent;
+            if (in_a) {
+                res.append(a_line.data(), width);
+            } else {
+                res.append(width, ' ');
+            }
+            res += differs ? " |" : "  ";
+            if (in_b) {
+                res += ' ';
+                res.append(b_line.data(), width);
+            }
+            res += '\n';
+            return;
+        }
+
+        if (!differs) {
+            res += indent + "  " + a_line;
+            return;
+        }
+        if (in_a) {
+            res += indent + "- " + a_line;
+        }
+        if (in_b) {
+            res += indent + "+ " + b_line;
+        }
+    };
+
+    std::uint64_t written = 0;
+    auto line = NextDifferingCanonicalLine<Layout>(a, a_size, b, b_size, 0);
+    while (line < lines) {
+
+        // join the following differing lines as long as the equal lines in between fit into the context
+        auto last = line;
+        auto next = NextDifferingCanonicalLine<Layout>(a, a_size, b, b_size, last + 1);
+        while ((next < lines) && (next - last - 1 <= 2 * context)) {
+            last = next;
+            next = NextDifferingCanonicalLine<Layout>(a, a_size, b, b_size, last + 1);
+        }
+
+        auto first = line - std::min(line, context);
+        auto end = std::min(lines, last + 1 + context);
+        if (first > written) {
+            res += indent + "*\n";
+        }
+        for (auto l = first; l < end; ++l) {
+            write_line(l);
+        }
+        written = end;
+        line = next;
+    }
+    if ((written > 0) && (written < lines)) {
+        res += indent + "*\n";
+    }
+
+    return res;
 }
 
+
 inline std::vector<std::byte> headcode::mem::CharArrayToMemory(char const * array, std::uint64_t size) {
 
-    std::vector<std::byte> res{size};
-    if (array) {
-        std::memcpy(res.data(), array, size);
+    if (!array || (size == 0)) {
+        return std::vector<std::byte>(size);
     }
-    return res;
+    auto first = reinterpret_cast<std::byte const *>(array);
+    return std::vector<std::byte>(first, first + size);
+}
+
+
+template <class Layout>
+inline bool headcode::mem::CharArrayToCanonicalStream(char const * array,
+                                                     std::uint64_t size,
+                                                     std::function<bool(char const *, std::uint64_t)> const & sink,
+                                                     std::string const & indent,
+                                                     std::uint64_t buffer_size,
+                                                     bool squeeze,
+                                                     std::uint64_t base_address) {
+
+    constexpr auto bytes_per_line = Layout::kBytesPerLine;
+
+    auto templ = CanonicalLineTemplate<Layout>(indent);
+    auto lines = (size + bytes_per_line - 1) / bytes_per_line;
+    auto full_lines = size / bytes_per_line;
+    auto lines_per_buffer = std::max<std::uint64_t>(buffer_size / templ.size(), 1);
+
+    std::vector<char> buffer(std::min(lines, lines_per_buffer) * templ.size());
+    std::uint64_t used = 0;
+
+    auto flush = [&]() {
+        bool flushed = (used == 0) || sink(buffer.data(), used);
+        used = 0;
+        return flushed;
+    };
+
+    auto write_lines = [&](std::uint64_t first_line, std::uint64_t count) {
+        while (count > 0) {
+            auto fitting = std::min(count, (buffer.size() - used) / templ.size());
+            if (fitting == 0) {
+                if (!flush()) {
+                    return false;
+                }
+                continue;
+            }
+            DumpCanonicalLines<Layout>(
+                    buffer.data() + used, templ, indent.size(), array, size, first_line, fitting, base_address);
+            used += fitting * templ.size();
+            first_line += fitting;
+            count -= fitting;
+        }
+        return true;
+    };
+
+    auto write_squeeze = [&]() {
+        if ((buffer.size() - used < indent.size() + 2) && !flush()) {
+            return false;
+        }
+        std::copy(indent.begin(), indent.end(), buffer.data() + used);
+        used += indent.size();
+        buffer[used++] = '*';
+        buffer[used++] = '\n';
+        return true;
+    };
+
+    if (!squeeze) {
+        return write_lines(0, lines) && flush();
+    }
+
+    std::uint64_t l = 0;
+    while (l < lines) {
+
+        // lines up to the first one repeated by its successor are written as they are
+        auto last = l;
+        while ((last + 1 < full_lines) &&
+               (simd::FindMismatch(array + (last + 1) * bytes_per_line, array + last * bytes_per_line,
+                                   bytes_per_line) != bytes_per_line)) {
+            ++last;
+        }
+        if (last + 1 >= full_lines) {
+            return write_lines(l, lines - l) && flush();
+        }
+        if (!write_lines(l, last - l + 1)) {
+            return false;
+        }
+
+        // skip the whole run at once: it ends where the memory differs from itself shifted by a line
+        auto run_start = last * bytes_per_line;
+        auto run_size = full_lines * bytes_per_line - run_start - bytes_per_line;
+        auto run_end = last + simd::FindMismatch(array + run_start + bytes_per_line, array + run_start, run_size) /
+                                      bytes_per_line;
+
+        // a run reaching the end of the memory ends with its last line, so the size stays visible,
+        // and a "*" is written only if it stands for at least one line
+        if (run_end + 1 == lines) {
+            if ((run_end > last + 1) && !write_squeeze()) {
+                return false;
+            }
+            return write_lines(run_end, 1) && flush();
+        }
+        if (!write_squeeze()) {
+            return false;
+        }
+        l = run_end + 1;
+    }
+
+    return flush();
 }
 
 
-inline std::string headcode::mem::CharArrayToCanonicalString(char const * array, std::uint64_t size,
-                                                             std::string const & indent) {
+template <class Layout>
+inline bool headcode::mem::CharArrayToCanonicalStream(char const * array,
+                                                     std::uint64_t size,
+                                                     std::ostream & out,
+                                                     std::string const & indent,
+                                                     bool squeeze,
+                                                     std::uint64_t base_address) {
+    return CharArrayToCanonicalStream<Layout>(
+            array,
+            size,
+            [&](char const * data, std::uint64_t data_size) {
+                out.write(data, static_cast<std::streamsize>(data_size));
+                return static_cast<bool>(out);
+            },
+            indent,
+            64 * 1024,
+            squeeze,
+            base_address);
+}
 
-    // structure of a single line:
-    // e.g.
-    //   0x0123456789012345   20 21 22 23 24 25 26 27  28 29 2a 2b 2c 2d 2e 2f   | !"#$%&' ()*+,-./|
-    //
-    // from left to right
 
-    static std::uint64_t const offset_size = std::string{"0x"}.size() + 16;
-    static std::string const gap_to_data{"   "};
-    static unsigned int const word_size = 8 * 2 + 7;
-    static std::string const word_gap{"  "};
-    static std::string const gap_to_ascii{"   "};
-    static std::string const ascii_gap{" "};
-    static unsigned int const ascii_size = 8;
-    static std::string const ascii_delimiter{"|"};
-    static std::string const new_line{"\n"};
+template <class Layout>
+inline bool headcode::mem::CharArrayToCanonicalStream(char const * array,
+                                                     std::uint64_t size,
+                                                     std::FILE * file,
+                                                     std::string const & indent,
+                                                     bool squeeze,
+                                                     std::uint64_t base_address) {
+    return CharArrayToCanonicalStream<Layout>(
+            array,
+            size,
+            [&](char const * data, std::uint64_t data_size) {
+                return std::fwrite(data, 1, data_size, file) == data_size;
+            },
+            indent,
+            64 * 1024,
+            squeeze,
+            base_address);
+}
 
-    // construct total length of single line
-    std::uint64_t static_length_of_line = offset_size + gap_to_data.size() + word_size + word_gap.size() + word_size +
-                                          gap_to_ascii.size() + ascii_delimiter.size() + ascii_size + ascii_gap.size() +
-                                          ascii_size + ascii_delimiter.size() + new_line.size();
 
-    auto length_of_full_line = indent.size() + static_length_of_line;
+template <class Layout>
+inline bool headcode::mem::CharArrayToCanonicalStream(char const * array,
+                                                     std::uint64_t size,
+                                                     int fd,
+                                                     std::string const & indent,
+                                                     bool squeeze,
+                                                     std::uint64_t base_address) {
+    return CharArrayToCanonicalStream<Layout>(
+            array,
+            size,
+            [&](char const * data, std::uint64_t data_size) {
+                while (data_size > 0) {
+                    auto written = ::write(fd, data, data_size);
+                    if (written < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        return false;
+                    }
+                    if (written == 0) {
+                        return false;
+                    }
+                    data += written;
+                    data_size -= static_cast<std::uint64_t>(written);
+                }
+                return true;
+            },
+            indent,
+            64 * 1024,
+            squeeze,
+            base_address);
+}
+
+
+template <class Layout>
+inline std::string headcode::mem::CharArrayToCanonicalString(char const * array,
+                                                             std::uint64_t size,
+                                                             std::string const & indent,
+                                                             bool squeeze,
+                                                             std::uint64_t base_address) {
 
     std::string res;
-    auto lines = (size + 0x0ful) >> 4;
-    res.resize(lines * length_of_full_line);
-
-    // prepare a template for each line
-    std::string templ;
-    templ.resize(length_of_full_line);
-    auto templ_pointer = templ.data();
-    std::memset(templ_pointer, ' ', length_of_full_line);
-
-    if (!indent.empty()) {
-        std::memcpy(templ_pointer, indent.c_str(), indent.size());
-        templ_pointer += indent.size();
+    if (squeeze) {
+        CharArrayToCanonicalStream<Layout>(
+                array,
+                size,
+                [&](char const * data, std::uint64_t data_size) {
+                    res.append(data, data_size);
+                    return true;
+                },
+                indent,
+                64 * 1024,
+                true,
+                base_address);
+        return res;
     }
 
-    templ_pointer[0] = '0';
-    templ_pointer[1] = 'x';
-    templ_pointer += offset_size;
-
-    std::memcpy(templ_pointer, gap_to_data.data(), gap_to_data.size());
-    templ_pointer += gap_to_data.size();
-    templ_pointer += word_size;
-    std::memcpy(templ_pointer, word_gap.data(), word_gap.size());
-    templ_pointer += word_gap.size();
-    templ_pointer += word_size;
-    std::memcpy(templ_pointer, gap_to_ascii.data(), gap_to_ascii.size());
-    templ_pointer += gap_to_ascii.size();
-    std::memcpy(templ_pointer, ascii_delimiter.data(), ascii_delimiter.size());
-    templ_pointer += ascii_delimiter.size();
-    templ_pointer += ascii_size;
-    std::memcpy(templ_pointer, ascii_gap.data(), ascii_gap.size());
-    templ_pointer += ascii_gap.size();
-    templ_pointer += ascii_size;
-    std::memcpy(templ_pointer, ascii_delimiter.data(), ascii_delimiter.size());
-    templ_pointer += ascii_delimiter.size();
-    *templ_pointer = '\n';
-
-    for (std::uint64_t l = 0; l < lines; ++l) {
-
-        auto dst = res.data() + length_of_full_line * l;
-        std::memcpy(dst, templ.data(), length_of_full_line);
-
-        auto to_offset = dst + indent.size();
-        auto to_data = to_offset + offset_size + gap_to_data.size();
-        auto to_ascii = to_data + word_size + word_gap.size() + word_size;
-        to_ascii += gap_to_ascii.size() + ascii_delimiter.size();
-
-        std::uint64_t pos = (l << 4);
-        HexNumberToCharArray(to_offset + 2, pos);
-        DumpHexLine(to_data, array + pos, std::min<std::uint64_t>(16, size - pos), word_gap.size());
-        DumpAsciiLine(to_ascii, array + pos, std::min<std::uint64_t>(16, size - pos), ascii_gap.size());
+    auto templ = CanonicalLineTemplate<Layout>(indent);
+    auto lines = (size + Layout::kBytesPerLine - 1) / Layout::kBytesPerLine;
+    res.resize(lines * templ.size());
+    DumpCanonicalLines<Layout>(res.data(), templ, indent.size(), array, size, 0, lines, base_address);
+
+    return res;
+}
+
+
+template <class Layout>
+inline std::string headcode::mem::CharArrayToCanonicalStringParallel(char const * array,
+                                                                     std::uint64_t size,
+                                                                     std::string const & indent,
+                                                                     std::uint64_t base_address,
+                                                                     ThreadPool & pool) {
+
+    if ((size < kParallelMinSize) || (pool.GetThreads() == 1)) {
+        return CharArrayToCanonicalString<Layout>(array, size, indent, false, base_address);
     }
 
+    auto templ = CanonicalLineTemplate<Layout>(indent);
+    auto lines = (size + Layout::kBytesPerLine - 1) / Layout::kBytesPerLine;
+
+    std::string res;
+    res.resize(lines * templ.size());
+    auto dst = res.data();
+    bool non_temporal = res.size() > GetLastLevelCacheSize();
+
+    auto lines_per_chunk = kParallelChunkSize / Layout::kBytesPerLine;
+    auto chunks = (lines + lines_per_chunk - 1) / lines_per_chunk;
+    pool.Run(chunks, [&](std::uint64_t chunk) {
+
+        auto first_line = chunk * lines_per_chunk;
+        auto chunk_lines = std::min(lines_per_chunk, lines - first_line);
+        auto chunk_dst = dst + first_line * templ.size();
+        if (!non_temporal) {
+            DumpCanonicalLines<Layout>(
+                    chunk_dst, templ, indent.size(), array, size, first_line, chunk_lines, base_address);
+            return;
+        }
+
+        // format in cache and stream out, so the result does not evict the input and the templates
+        auto lines_per_buffer = std::max<std::uint64_t>((64 * 1024) / templ.size(), 1);
+        std::vector<char> buffer(std::min(chunk_lines, lines_per_buffer) * templ.size());
+        for (std::uint64_t l = 0; l < chunk_lines; l += lines_per_buffer) {
+            auto count = std::min(lines_per_buffer, chunk_lines - l);
+            DumpCanonicalLines<Layout>(
+                    buffer.data(), templ, indent.size(), array, size, first_line + l, count, base_address);
+            simd::CopyNonTemporal(chunk_dst + l * templ.size(), buffer.data(), count * templ.size());
+        }
+    });
+
     return res;
 }
 
 
+template <class T>
+inline std::string headcode::mem::CharArrayToTypedCanonicalString(char const * array,
+                                                                  std::uint64_t size,
+                                                                  Endian endian,
+                                                                  std::string const & indent,
+                                                                  std::uint64_t base_address) {
+
+    auto templ = TypedCanonicalLineTemplate<T>(indent);
+    auto lines = (size + 15) / 16;
+
+    std::string res;
+    res.resize(lines * templ.size());
+    DumpTypedCanonicalLines<T>(res.data(), templ, indent.size(), array, size, 0, lines, endian, base_address);
+
+    return res;
+}
+
+
+inline std::uint64_t headcode::mem::FindFirstDifference(char const * a,
+                                                       std::uint64_t a_size,
+                                                       char const * b,
+                                                       std::uint64_t b_size) {
+    return simd::FindMismatch(a, b, std::min(a_size, b_size));
+}
+
+
+inline std::uint64_t headcode::mem::FindFirstDifference(std::vector<std::byte> const & a,
+                                                       std::vector<std::byte> const & b) {
+    return FindFirstDifference(
+            reinterpret_cast<char const *>(a.data()), a.size(), reinterpret_cast<char const *>(b.data()), b.size());
+}
+
+
 inline std::vector<std::byte> headcode::mem::HexToMemory(std::string const & hex) {
 
     if (hex.empty()) {
         return {};
     }
 
-    std::vector<std::byte> res{hex.size() / 2};
-    for (size_t i = 0; i < hex.size() / 2; ++i) {
-        res[i] = HexToByte(std::string_view{hex.data() + i * 2, 2});
+    std::vector<std::byte> res;
+    HexToMemory(res, hex);
+    return res;
+}
+
+
+inline std::uint64_t headcode::mem::HexToMemory(std::byte * memory, std::uint64_t capacity, std::string_view hex) {
+
+    auto size = std::min<std::uint64_t>(hex.size() / 2, capacity);
+    simd::HexDecode(reinterpret_cast<unsigned char *>(memory), hex.data(), size * 2, false);
+    return size;
+}
+
+
+template <class Allocator>
+inline std::uint64_t headcode::mem::HexToMemory(std::vector<std::byte, Allocator> & memory, std::string_view hex) {
+    return AppendToMemory(memory, hex.size() / 2, [&](unsigned char * dst, auto offset, auto count) {
+        simd::HexDecode(dst, hex.data() + offset * 2, count * 2, false);
+        return count;
+    });
+}
+
+
+template <class Allocator>
+inline bool headcode::mem::HexToMemoryStrict(std::string const & hex,
+                                             std::vector<std::byte, Allocator> & memory,
+                                             std::uint64_t * invalid_position) {
+
+    memory.clear();
+    auto decoded = hex.size() / 2 * 2;
+    auto invalid = decoded;
+    AppendToMemory(memory, hex.size() / 2, [&](unsigned char * dst, auto offset, auto count) {
+        auto result = simd::HexDecode(dst, hex.data() + offset * 2, count * 2, true);
+        if (result != count * 2) {
+            invalid = offset * 2 + result;
+        }
+        return result / 2;
+    });
+    if ((invalid == decoded) && (decoded == hex.size())) {
+        return true;
     }
 
+    memory.clear();
+    if (invalid_position) {
+        *invalid_position = invalid;
+    }
+    return false;
+}
+
+
+inline std::vector<std::byte> headcode::mem::HexToMemoryParallel(std::string const & hex, ThreadPool & pool) {
+
+    if ((hex.size() < 2 * kParallelMinSize) || (pool.GetThreads() == 1)) {
+        return HexToMemory(hex);
+    }
+
+    std::vector<std::byte> res{hex.size() / 2};
+    auto dst = reinterpret_cast<unsigned char *>(res.data());
+    auto size = res.size();
+    auto chunks = (size + kParallelChunkSize - 1) / kParallelChunkSize;
+    pool.Run(chunks, [&](std::uint64_t chunk) {
+        auto offset = chunk * kParallelChunkSize;
+        auto bytes = std::min<std::uint64_t>(kParallelChunkSize, size - offset);
+        simd::HexDecode(dst + offset, hex.data() + offset * 2, bytes * 2, false);
+    });
+
+    return res;
+}
+
+
+template <class Layout>
+inline std::string headcode::mem::MemoryDiffToCanonicalString(std::vector<std::byte> const & a,
+                                                              std::vector<std::byte> const & b,
+                                                              CanonicalDiffStyle style,
+                                                              std::uint64_t context,
+                                                              std::string const & indent) {
+    return CharArrayDiffToCanonicalString<Layout>(reinterpret_cast<char const *>(a.data()),
+                                                  a.size(),
+                                                  reinterpret_cast<char const *>(b.data()),
+                                                  b.size(),
+                                                  style,
+                                                  context,
+                                                  indent);
+}
+
+
+inline std::string headcode::mem::MemoryToAscii85(std::vector<std::byte> const & memory) {
+    return MemoryToAscii85(reinterpret_cast<char const *>(memory.data()), memory.size());
+}
+
+
+inline std::string headcode::mem::MemoryToAscii85(char const * memory, std::uint64_t size) {
+    std::string res(simd::Base85EncodedSize(size), '\0');
+    simd::Base85Encode(res.data(), memory, size, Base85Alphabet::kAscii85);
     return res;
 }
 
 
+inline std::string headcode::mem::MemoryToBase64(std::vector<std::byte> const & memory, Base64Alphabet alphabet) {
+    return MemoryToBase64(reinterpret_cast<char const *>(memory.data()), memory.size(), alphabet);
+}
+
+
+inline std::string headcode::mem::MemoryToBase64(char const * memory, std::uint64_t size, Base64Alphabet alphabet) {
+    std::string res(simd::Base64EncodedSize(size, alphabet), '\0');
+    simd::Base64Encode(res.data(), memory, size, alphabet);
+    return res;
+}
+
+
+template <class Layout>
 inline std::string headcode::mem::MemoryToCanonicalString(std::vector<std::byte> const & memory,
-                                                          std::string const & indent) {
+                                                          std::string const & indent,
+                                                          bool squeeze,
+                                                          std::uint64_t base_address) {
+
+    return CharArrayToCanonicalString<Layout>(
+            reinterpret_cast<char const *>(memory.data()), memory.size(), indent, squeeze, base_address);
+}
+
 
-    return CharArrayToCanonicalString(reinterpret_cast<char const *>(memory.data()), memory.size(), indent);
+template <class Layout>
+inline std::string headcode::mem::MemoryToCanonicalStringParallel(std::vector<std::byte> const & memory,
+                                                                  std::string const & indent,
+                                                                  std::uint64_t base_address,
+                                                                  ThreadPool & pool) {
+    return CharArrayToCanonicalStringParallel<Layout>(
+            reinterpret_cast<char const *>(memory.data()), memory.size(), indent, base_address, pool);
 }
 
 
@@ -300,54 +1096,90 @@ inline std::string headcode::mem::MemoryToHex(std::vector<std::byte> const & mem
 
 inline std::string headcode::mem::MemoryToHex(char const * memory, std::uint64_t size) {
 
-    static char char_to_hex[256][2] = {
-            {'0', '0'}, {'0', '1'}, {'0', '2'}, {'0', '3'}, {'0', '4'}, {'0', '5'}, {'0', '6'}, {'0', '7'}, {'0', '8'},
-            {'0', '9'}, {'0', 'a'}, {'0', 'b'}, {'0', 'c'}, {'0', 'd'}, {'0', 'e'}, {'0', 'f'}, {'1', '0'}, {'1', '1'},
-            {'1', '2'}, {'1', '3'}, {'1', '4'}, {'1', '5'}, {'1', '6'}, {'1', '7'}, {'1', '8'}, {'1', '9'}, {'1', 'a'},
-            {'1', 'b'}, {'1', 'c'}, {'1', 'd'}, {'1', 'e'}, {'1', 'f'}, {'2', '0'}, {'2', '1'}, {'2', '2'}, {'2', '3'},
-            {'2', '4'}, {'2', '5'}, {'2', '6'}, {'2', '7'}, {'2', '8'}, {'2', '9'}, {'2', 'a'}, {'2', 'b'}, {'2', 'c'},
-            {'2', 'd'}, {'2', 'e'}, {'2', 'f'}, {'3', '0'}, {'3', '1'}, {'3', '2'}, {'3', '3'}, {'3', '4'}, {'3', '5'},
-            {'3', '6'}, {'3', '7'}, {'3', '8'}, {'3', '9'}, {'3', 'a'}, {'3', 'b'}, {'3', 'c'}, {'3', 'd'}, {'3', 'e'},
-            {'3', 'f'}, {'4', '0'}, {'4', '1'}, {'4', '2'}, {'4', '3'}, {'4', '4'}, {'4', '5'}, {'4', '6'}, {'4', '7'},
-            {'4', '8'}, {'4', '9'}, {'4', 'a'}, {'4', 'b'}, {'4', 'c'}, {'4', 'd'}, {'4', 'e'}, {'4', 'f'}, {'5', '0'},
-            {'5', '1'}, {'5', '2'}, {'5', '3'}, {'5', '4'}, {'5', '5'}, {'5', '6'}, {'5', '7'}, {'5', '8'}, {'5', '9'},
-            {'5', 'a'}, {'5', 'b'}, {'5', 'c'}, {'5', 'd'}, {'5', 'e'}, {'5', 'f'}, {'6', '0'}, {'6', '1'}, {'6', '2'},
-            {'6', '3'}, {'6', '4'}, {'6', '5'}, {'6', '6'}, {'6', '7'}, {'6', '8'}, {'6', '9'}, {'6', 'a'}, {'6', 'b'},
-            {'6', 'c'}, {'6', 'd'}, {'6', 'e'}, {'6', 'f'}, {'7', '0'}, {'7', '1'}, {'7', '2'}, {'7', '3'}, {'7', '4'},
-            {'7', '5'}, {'7', '6'}, {'7', '7'}, {'7', '8'}, {'7', '9'}, {'7', 'a'}, {'7', 'b'}, {'7', 'c'}, {'7', 'd'},
-            {'7', 'e'}, {'7', 'f'}, {'8', '0'}, {'8', '1'}, {'8', '2'}, {'8', '3'}, {'8', '4'}, {'8', '5'}, {'8', '6'},
-            {'8', '7'}, {'8', '8'}, {'8', '9'}, {'8', 'a'}, {'8', 'b'}, {'8', 'c'}, {'8', 'd'}, {'8', 'e'}, {'8', 'f'},
-            {'9', '0'}, {'9', '1'}, {'9', '2'}, {'9', '3'}, {'9', '4'}, {'9', '5'}, {'9', '6'}, {'9', '7'}, {'9', '8'},
-            {'9', '9'}, {'9', 'a'}, {'9', 'b'}, {'9', 'c'}, {'9', 'd'}, {'9', 'e'}, {'9', 'f'}, {'a', '0'}, {'a', '1'},
-            {'a', '2'}, {'a', '3'}, {'a', '4'}, {'a', '5'}, {'a', '6'}, {'a', '7'}, {'a', '8'}, {'a', '9'}, {'a', 'a'},
-            {'a', 'b'}, {'a', 'c'}, {'a', 'd'}, {'a', 'e'}, {'a', 'f'}, {'b', '0'}, {'b', '1'}, {'b', '2'}, {'b', '3'},
-            {'b', '4'}, {'b', '5'}, {'b', '6'}, {'b', '7'}, {'b', '8'}, {'b', '9'}, {'b', 'a'}, {'b', 'b'}, {'b', 'c'},
-            {'b', 'd'}, {'b', 'e'}, {'b', 'f'}, {'c', '0'}, {'c', '1'}, {'c', '2'}, {'c', '3'}, {'c', '4'}, {'c', '5'},
-            {'c', '6'}, {'c', '7'}, {'c', '8'}, {'c', '9'}, {'c', 'a'}, {'c', 'b'}, {'c', 'c'}, {'c', 'd'}, {'c', 'e'},
-            {'c', 'f'}, {'d', '0'}, {'d', '1'}, {'d', '2'}, {'d', '3'}, {'d', '4'}, {'d', '5'}, {'d', '6'}, {'d', '7'},
-            {'d', '8'}, {'d', '9'}, {'d', 'a'}, {'d', 'b'}, {'d', 'c'}, {'d', 'd'}, {'d', 'e'}, {'d', 'f'}, {'e', '0'},
-            {'e', '1'}, {'e', '2'}, {'e', '3'}, {'e', '4'}, {'e', '5'}, {'e', '6'}, {'e', '7'}, {'e', '8'}, {'e', '9'},
-            {'e', 'a'}, {'e', 'b'}, {'e', 'c'}, {'e', 'd'}, {'e', 'e'}, {'e', 'f'}, {'f', '0'}, {'f', '1'}, {'f', '2'},
-            {'f', '3'}, {'f', '4'}, {'f', '5'}, {'f', '6'}, {'f', '7'}, {'f', '8'}, {'f', '9'}, {'f', 'a'}, {'f', 'b'},
-            {'f', 'c'}, {'f', 'd'}, {'f', 'e'}, {'f', 'f'}};
+    std::string res;
+    MemoryToHex(res, memory, size);
+    return res;
+}
+
+
+inline std::uint64_t headcode::mem::MemoryToHex(char * hex,
+                                                std::uint64_t capacity,
+                                                char const * memory,
+                                                std::uint64_t size) {
+
+    auto bytes = std::min<std::uint64_t>(size, capacity / 2);
+    simd::HexEncode(hex, memory, bytes);
+    return bytes * 2;
+}
+
+
+inline std::uint64_t headcode::mem::MemoryToHex(std::string & hex, char const * memory, std::uint64_t size) {
+
+    auto offset = hex.size();
+    hex.resize(offset + size * 2);
+    return MemoryToHex(hex.data() + offset, hex.size() - offset, memory, size);
+}
+
+
+inline std::string headcode::mem::MemoryToHexParallel(std::vector<std::byte> const & memory, ThreadPool & pool) {
+    return MemoryToHexParallel(reinterpret_cast<char const *>(memory.data()), memory.size(), pool);
+}
+
+
+inline std::string headcode::mem::MemoryToHexParallel(char const * memory, std::uint64_t size, ThreadPool & pool) {
+
+    if ((size < kParallelMinSize) || (pool.GetThreads() == 1)) {
+        return MemoryToHex(memory, size);
+    }
 
     std::string res;
     res.resize(size * 2);
-    for (std::uint64_t i = 0; i < size; ++i) {
-        int value = static_cast<unsigned char>(memory[i]);
-        res[i * 2] = char_to_hex[value][0];
-        res[i * 2 + 1] = char_to_hex[value][1];
-    }
+    auto dst = res.data();
+    auto chunks = (size + kParallelChunkSize - 1) / kParallelChunkSize;
+    pool.Run(chunks, [&](std::uint64_t chunk) {
+        auto offset = chunk * kParallelChunkSize;
+        auto bytes = std::min<std::uint64_t>(kParallelChunkSize, size - offset);
+        simd::HexEncode(dst + offset * 2, memory + offset, bytes);
+    });
 
     return res;
 }
 
 
-inline std::vector<std::byte> headcode::mem::StringToMemory(std::string const & str) {
-    std::vector<std::byte> res{str.size()};
-    std::memcpy(res.data(), str.data(), res.size());
+template <class T>
+inline std::string headcode::mem::MemoryToTypedCanonicalString(std::vector<std::byte> const & memory,
+                                                               Endian endian,
+                                                               std::string const & indent,
+                                                               std::uint64_t base_address) {
+    return CharArrayToTypedCanonicalString<T>(
+            reinterpret_cast<char const *>(memory.data()), memory.size(), endian, indent, base_address);
+}
+
+
+inline std::string headcode::mem::MemoryToZ85(std::vector<std::byte> const & memory) {
+    return MemoryToZ85(reinterpret_cast<char const *>(memory.data()), memory.size());
+}
+
+
+inline std::string headcode::mem::MemoryToZ85(char const * memory, std::uint64_t size) {
+    std::string res(simd::Base85EncodedSize(size), '\0');
+    simd::Base85Encode(res.data(), memory, size, Base85Alphabet::kZ85);
     return res;
 }
 
 
+inline std::vector<std::byte> headcode::mem::StringToMemory(std::string const & str) {
+    auto first = reinterpret_cast<std::byte const *>(str.data());
+    return std::vector<std::byte>(first, first + str.size());
+}
+
+
+template <class Allocator>
+inline bool headcode::mem::Z85ToMemory(std::string const & z85,
+                                       std::vector<std::byte, Allocator> & memory,
+                                       std::uint64_t * invalid_position) {
+    return Base85ToMemory(z85, memory, Base85Alphabet::kZ85, invalid_position);
+}
+
+
 #endif
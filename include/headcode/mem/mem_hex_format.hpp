@@ -0,0 +1,352 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#ifndef HEADCODE_SPACE_MEM_MEM_HEX_FORMAT_HPP
+#define HEADCODE_SPACE_MEM_MEM_HEX_FORMAT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mem_simd.hpp"
+
+
+/**
+ * @brief   The headcode mem namespace
+ */
+namespace headcode::mem {
+
+/**
+ * @brief   Plain lower case hex, the same as MemoryToHex: "deadbeef".
+ * A hex format is any type with these four static constexpr members. Bytes are written in groups of
+ * kGroupSize bytes, each group starts with kPrefix and groups are separated by kSeparator:
+ * @code
+ *      struct MyFormat {
+ *          static constexpr bool kUpperCase = true;
+ *          static constexpr std::uint64_t kGroupSize = 2;
+ *          static constexpr std::string_view kPrefix{"#"};
+ *          static constexpr std::string_view kSeparator{"-"};
+ *      };
+ *      auto hex = headcode::mem::MemoryToFormattedHex<MyFormat>(data, 4);     // "#DEAD-#BEEF"
+ * @endcode
+ */
+struct HexFormatPacked {
+    static constexpr bool kUpperCase = false;                   //!< @brief Use 'A'-'F' instead of 'a'-'f'.
+    static constexpr std::uint64_t kGroupSize = 1;              //!< @brief Bytes per group.
+    static constexpr std::string_view kPrefix{};                //!< @brief Written before each group.
+    static constexpr std::string_view kSeparator{};             //!< @brief Written between two groups.
+};
+
+/**
+ * @brief   Plain upper case hex: "DEADBEEF".
+ */
+struct HexFormatPackedUpper : HexFormatPacked {
+    static constexpr bool kUpperCase = true;                    //!< @brief Use 'A'-'F' instead of 'a'-'f'.
+};
+
+/**
+ * @brief   Colon separated bytes as in MAC addresses or fingerprints: "de:ad:be:ef".
+ */
+struct HexFormatColon : HexFormatPacked {
+    static constexpr std::string_view kSeparator{":"};          //!< @brief Written between two groups.
+};
+
+/**
+ * @brief   Bytes as C array initializer: "0xde, 0xad, 0xbe, 0xef".
+ */
+struct HexFormatCArray : HexFormatPacked {
+    static constexpr std::string_view kPrefix{"0x"};            //!< @brief Written before each group.
+    static constexpr std::string_view kSeparator{", "};         //!< @brief Written between two groups.
+};
+
+/**
+ * @brief   Space separated groups of bytes, e.g. for GroupSize 4: "deadbeef cafebabe".
+ * @tparam  GroupSize       bytes per group
+ * @tparam  UpperCase       use 'A'-'F' instead of 'a'-'f'
+ */
+template <std::uint64_t GroupSize, bool UpperCase = false>
+struct HexFormatGrouped : HexFormatPacked {
+    static constexpr bool kUpperCase = UpperCase;               //!< @brief Use 'A'-'F' instead of 'a'-'f'.
+    static constexpr std::uint64_t kGroupSize = GroupSize;      //!< @brief Bytes per group.
+    static constexpr std::string_view kSeparator{" "};          //!< @brief Written between two groups.
+};
+
+/**
+ * @brief   Returns the number of chars a memory area of the given size has in a hex format.
+ * @tparam  Format          the hex format
+ * @param   size            size of the memory area
+ * @return  The length of the formatted hex string.
+ */
+template <class Format>
+constexpr std::uint64_t FormattedHexSize(std::uint64_t size) {
+    static_assert(Format::kGroupSize > 0, "Hex format group size must not be 0.");
+    if (size == 0) {
+        return 0;
+    }
+    auto groups = (size + Format::kGroupSize - 1) / Format::kGroupSize;
+    return groups * (Format::kPrefix.size() + Format::kSeparator.size()) - Format::kSeparator.size() + size * 2;
+}
+
+/**
+ * @brief   The simd functions of the headcode mem namespace.
+ */
+namespace simd {
+
+/**
+ * @brief   Byte shuffle masks placing 16 bytes of hex digits into their formatted positions.
+ * Formatted output of a block of 16 bytes is built vector by vector: the high and low hex digits are
+ * shuffled into place (mask entry 0x80 yields 0) and or-ed with the fixed prefix and separator chars.
+ * Only usable if 16 is a multiple of the group size.
+ * @tparam  Format          the hex format
+ */
+template <class Format>
+struct HexFormatShuffle {
+
+    /**
+     * @brief   Chars a group takes including the separator to the next group.
+     */
+    static constexpr std::uint64_t kGroupWidth =
+            Format::kPrefix.size() + Format::kGroupSize * 2 + Format::kSeparator.size();
+
+    /**
+     * @brief   Chars of a formatted block of 16 bytes.
+     */
+    static constexpr std::uint64_t kBlockChars = 16 / Format::kGroupSize * kGroupWidth;
+
+    /**
+     * @brief   Vectors to store for a block of 16 bytes (the last one may spill into the next block).
+     */
+    static constexpr std::uint64_t kVectors = (kBlockChars + 15) / 16;
+
+    std::array<char, kVectors * 16> hi{};           //!< @brief Shuffle mask for the high hex digits.
+    std::array<char, kVectors * 16> lo{};           //!< @brief Shuffle mask for the low hex digits.
+    std::array<char, kVectors * 16> fixed{};        //!< @brief Prefix and separator chars.
+
+    /**
+     * @brief   Creates the shuffle masks.
+     * @return  The shuffle masks for the hex format.
+     */
+    static constexpr HexFormatShuffle Make() {
+
+        constexpr auto prefix_size = Format::kPrefix.size();
+        constexpr auto digits_size = Format::kGroupSize * 2;
+        constexpr char zero = static_cast<char>(0x80);
+
+        HexFormatShuffle shuffle;
+        for (std::uint64_t i = 0; i < kVectors * 16; ++i) {
+
+            auto group = (i % kBlockChars) / kGroupWidth;
+            auto offset = (i % kBlockChars) % kGroupWidth;
+            shuffle.hi[i] = zero;
+            shuffle.lo[i] = zero;
+
+            if (offset < prefix_size) {
+                shuffle.fixed[i] = Format::kPrefix[offset];
+            } else if (offset < prefix_size + digits_size) {
+                auto digit = offset - prefix_size;
+                auto byte = static_cast<char>(group * Format::kGroupSize + digit / 2);
+                if (digit % 2 == 0) {
+                    shuffle.hi[i] = byte;
+                } else {
+                    shuffle.lo[i] = byte;
+                }
+            } else {
+                shuffle.fixed[i] = Format::kSeparator[offset - prefix_size - digits_size];
+            }
+        }
+        return shuffle;
+    }
+};
+
+/**
+ * @brief   The shuffle masks of a hex format, built at compile time.
+ * @tparam  Format          the hex format
+ */
+template <class Format>
+inline constexpr HexFormatShuffle<Format> kHexFormatShuffle = HexFormatShuffle<Format>::Make();
+
+/**
+ * @brief   Writes memory in a hex format (scalar version).
+ * @tparam  Format          the hex format
+ * @param   dst             destination, must hold FormattedHexSize<Format>(size) chars
+ * @param   src             the memory to convert
+ * @param   size            size of the memory to convert
+ */
+template <class Format>
+inline void HexFormatScalar(char * dst, unsigned char const * src, std::uint64_t size) {
+
+    auto const & table = Format::kUpperCase ? kByteToHexUpper : kByteToHex;
+    for (std::uint64_t i = 0; i < size; i += Format::kGroupSize) {
+
+        if (i > 0) {
+            for (auto c : Format::kSeparator) {
+                *dst++ = c;
+            }
+        }
+        for (auto c : Format::kPrefix) {
+            *dst++ = c;
+        }
+
+        auto group_end = std::min<std::uint64_t>(i + Format::kGroupSize, size);
+        for (auto j = i; j < group_end; ++j) {
+            dst[0] = table[src[j]][0];
+            dst[1] = table[src[j]][1];
+            dst += 2;
+        }
+    }
+}
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+
+/**
+ * @brief   Writes memory in a hex format (SSSE3 version, 16 bytes per iteration).
+ * Each block is written including the separator after its last group. The kernel stops one block
+ * early, so the last vector may spill into the output of the next block. The caller formats the rest.
+ * @tparam  Format          the hex format, 16 must be a multiple of its group size
+ * @param   dst             destination, must hold FormattedHexSize<Format>(size) chars
+ * @param   src             the memory to convert
+ * @param   size            size of the memory to convert
+ * @return  Number of bytes converted (a multiple of 16).
+ */
+template <class Format>
+HEADCODE_SPACE_MEM_TARGET("ssse3")
+inline std::uint64_t HexFormatSSSE3(char * dst, unsigned char const * src, std::uint64_t size) {
+
+    static_assert(16 % Format::kGroupSize == 0, "SSSE3 hex format kernel needs groups dividing 16 bytes.");
+    using Shuffle = HexFormatShuffle<Format>;
+    auto const & shuffle = kHexFormatShuffle<Format>;
+
+    char const * digits = Format::kUpperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+    __m128i const mask = _mm_set1_epi8(0x0f);
+    __m128i const table = _mm_loadu_si128(reinterpret_cast<__m128i const *>(digits));
+
+    std::uint64_t i = 0;
+    for (; i + 32 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+        __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(v, mask));
+        for (std::uint64_t j = 0; j < Shuffle::kVectors; ++j) {
+            auto hi_mask = _mm_loadu_si128(reinterpret_cast<__m128i const *>(shuffle.hi.data() + j * 16));
+            auto lo_mask = _mm_loadu_si128(reinterpret_cast<__m128i const *>(shuffle.lo.data() + j * 16));
+            auto fixed = _mm_loadu_si128(reinterpret_cast<__m128i const *>(shuffle.fixed.data() + j * 16));
+            auto out = _mm_or_si128(_mm_shuffle_epi8(hi, hi_mask), _mm_shuffle_epi8(lo, lo_mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j * 16), _mm_or_si128(out, fixed));
+        }
+        dst += Shuffle::kBlockChars;
+    }
+
+    return i;
+}
+
+#endif
+
+/**
+ * @brief   Writes memory in a hex format with the best kernel available.
+ * Packed lower case hex goes to HexEncode. Other formats with groups dividing 16 bytes use the SSSE3
+ * shuffle kernel, all others the scalar version.
+ * @tparam  Format          the hex format
+ * @param   dst             destination, must hold FormattedHexSize<Format>(size) chars
+ * @param   src             the memory to convert
+ * @param   size            size of the memory to convert
+ * @param   level           the highest SimdLevel to use (capped at GetSimdLevel())
+ */
+template <class Format>
+inline void HexFormat(char * dst, char const * src, std::uint64_t size, SimdLevel level = GetSimdLevel()) {
+
+    if constexpr (!Format::kUpperCase && (Format::kGroupSize == 1) && Format::kPrefix.empty() &&
+                  Format::kSeparator.empty()) {
+        HexEncode(dst, src, size, level);
+        return;
+    }
+
+    auto source = reinterpret_cast<unsigned char const *>(src);
+    std::uint64_t done = 0;
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+    if constexpr (16 % Format::kGroupSize == 0) {
+        if ((level >= SimdLevel::kSSSE3) && (GetSimdLevel() >= SimdLevel::kSSSE3)) {
+            done = HexFormatSSSE3<Format>(dst, source, size);
+            dst += done / 16 * HexFormatShuffle<Format>::kBlockChars;
+        }
+    }
+#endif
+
+    HexFormatScalar<Format>(dst, source + done, size - done);
+}
+
+}
+
+/**
+ * @brief   Converts a memory area to hex in the given format.
+ * @code
+ *      auto hex = headcode::mem::MemoryToFormattedHex<headcode::mem::HexFormatCArray>(data, size);
+ * @endcode
+ * @tparam  Format          the hex format
+ * @param   memory          the memory to convert
+ * @param   size            size of the memory to convert
+ * @return  The memory in the hex format.
+ */
+template <class Format>
+inline std::string MemoryToFormattedHex(char const * memory, std::uint64_t size) {
+    std::string hex(FormattedHexSize<Format>(size), '\0');
+    simd::HexFormat<Format>(hex.data(), memory, size);
+    return hex;
+}
+
+/**
+ * @brief   Converts a memory area to hex in the given format.
+ * @tparam  Format          the hex format
+ * @param   memory          the memory to convert
+ * @return  The memory in the hex format.
+ */
+template <class Format>
+inline std::string MemoryToFormattedHex(std::vector<std::byte> const & memory) {
+    return MemoryToFormattedHex<Format>(reinterpret_cast<char const *>(memory.data()), memory.size());
+}
+
+/**
+ * @brief   Converts a memory area to hex in the given format into a caller supplied buffer.
+ * Converts as many bytes as fit completely into the buffer. Nothing is allocated and no terminating
+ * '\0' is written.
+ * @tparam  Format          the hex format
+ * @param   hex             the buffer receiving the formatted hex chars
+ * @param   capacity        size of the buffer in chars
+ * @param   memory          the memory to convert
+ * @param   size            size of the memory to convert
+ * @return  The number of bytes converted.
+ */
+template <class Format>
+inline std::uint64_t MemoryToFormattedHex(char * hex,
+                                          std::uint64_t capacity,
+                                          char const * memory,
+                                          std::uint64_t size) {
+
+    if (FormattedHexSize<Format>(size) > capacity) {
+
+        // whole groups fitting followed by the digits of a partial group
+        constexpr auto separator_size = Format::kSeparator.size();
+        constexpr auto group_width = Format::kPrefix.size() + Format::kGroupSize * 2 + separator_size;
+        auto groups = (capacity + separator_size) / group_width;
+        auto rest = groups > 0 ? capacity + separator_size - groups * group_width : capacity;
+        auto overhead = (groups > 0 ? separator_size : 0) + Format::kPrefix.size();
+        auto digits = rest >= overhead ? (rest - overhead) / 2 : 0;
+        size = std::min<std::uint64_t>(size, groups * Format::kGroupSize + digits);
+    }
+
+    simd::HexFormat<Format>(hex, memory, size);
+    return size;
+}
+
+}
+
+
+#endif
@@ -0,0 +1,385 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#ifndef HEADCODE_SPACE_MEM_MEM_HEX_STREAM_HPP
+#define HEADCODE_SPACE_MEM_MEM_HEX_STREAM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "mem_simd.hpp"
+
+
+/**
+ * @brief   The headcode mem namespace
+ */
+namespace headcode::mem {
+
+/**
+ * @brief   Converts memory to hex chunk by chunk into a fixed size output window.
+ * The encoder consumes as much input as fits into the free window. The caller drains the window and
+ * feeds the rest. Memory use is constant regardless of the input size:
+ * @code
+ *      headcode::mem::HexEncoder encoder;
+ *      while (size > 0) {
+ *          auto consumed = encoder.Encode(data, size);
+ *          data += consumed;
+ *          size -= consumed;
+ *          if (encoder.GetFree() < 2) {
+ *              std::cout.write(encoder.GetOutput(), encoder.GetOutputSize());
+ *              encoder.ClearOutput();
+ *          }
+ *      }
+ *      std::cout.write(encoder.GetOutput(), encoder.GetOutputSize());
+ * @endcode
+ */
+class HexEncoder {
+
+    std::vector<char> window_;          //!< @brief The output window.
+    std::uint64_t used_ = 0;            //!< @brief Number of chars in the output window.
+    std::uint64_t position_ = 0;        //!< @brief Total number of bytes consumed.
+
+public:
+    /**
+     * @brief   Constructor
+     * @param   window_size         size of the output window in chars (at least 2)
+     */
+    explicit HexEncoder(std::uint64_t window_size = 64 * 1024) : window_(std::max<std::uint64_t>(window_size, 2)) {
+    }
+
+    /**
+     * @brief   Empties the output window.
+     */
+    void ClearOutput() {
+        used_ = 0;
+    }
+
+    /**
+     * @brief   Encodes the next chunk of memory.
+     * @param   memory      the memory chunk
+     * @param   size        size of the memory chunk
+     * @return  number of bytes consumed, less than size if the window ran full
+     */
+    std::uint64_t Encode(char const * memory, std::uint64_t size) {
+        auto bytes = std::min<std::uint64_t>(size, GetFree() / 2);
+        simd::HexEncode(window_.data() + used_, memory, bytes);
+        used_ += bytes * 2;
+        position_ += bytes;
+        return bytes;
+    }
+
+    /**
+     * @brief   Returns the free space left in the output window.
+     * @return  Number of chars still free.
+     */
+    std::uint64_t GetFree() const {
+        return window_.size() - used_;
+    }
+
+    /**
+     * @brief   Returns the hex chars in the output window.
+     * @return  The start of the output window.
+     */
+    char const * GetOutput() const {
+        return window_.data();
+    }
+
+    /**
+     * @brief   Returns the number of hex chars in the output window.
+     * @return  Number of chars in the output window.
+     */
+    std::uint64_t GetOutputSize() const {
+        return used_;
+    }
+
+    /**
+     * @brief   Returns the total number of bytes encoded so far.
+     * @return  Number of bytes encoded.
+     */
+    std::uint64_t GetPosition() const {
+        return position_;
+    }
+
+    /**
+     * @brief   Returns the size of the output window.
+     * @return  The size of the output window in chars.
+     */
+    std::uint64_t GetWindowSize() const {
+        return window_.size();
+    }
+
+    /**
+     * @brief   Starts a new stream: empties the output window and resets the position.
+     */
+    void Reset() {
+        used_ = 0;
+        position_ = 0;
+    }
+};
+
+
+/**
+ * @brief   Converts hex to memory chunk by chunk into a fixed size output window.
+ * Chunks may have any size: a dangling hex char at the end of a chunk is carried into the next one.
+ * Like HexToMemory invalid chars decode as 0, unless the decoder is strict. A strict decoder stops
+ * consuming at the first invalid char. Call Finish() at the end of the stream:
+ * @code
+ *      headcode::mem::HexDecoder decoder{64 * 1024, true};
+ *      std::vector<std::byte> memory;
+ *      for (auto const & chunk : chunks) {
+ *          std::string_view rest{chunk};
+ *          while (!rest.empty()) {
+ *              auto consumed = decoder.Decode(rest);
+ *              rest.remove_prefix(consumed);
+ *              memory.insert(memory.end(), decoder.GetOutput(), decoder.GetOutput() + decoder.GetOutputSize());
+ *              decoder.ClearOutput();
+ *              if (!decoder.IsValid()) {
+ *                  ...     // invalid hex at decoder.GetInvalidPosition()
+ *              }
+ *          }
+ *      }
+ *      bool ok = decoder.Finish();
+ * @endcode
+ */
+class HexDecoder {
+
+    std::vector<std::byte> window_;             //!< @brief The output window.
+    std::uint64_t used_ = 0;                    //!< @brief Number of bytes in the output window.
+    std::uint64_t position_ = 0;                //!< @brief Total number of hex chars consumed.
+    bool strict_ = false;                       //!< @brief Stop at the first invalid char.
+    bool pending_ = false;                      //!< @brief Dangling hex char carried over.
+    char pending_char_ = '\0';                  //!< @brief The dangling hex char.
+    bool valid_ = true;                         //!< @brief All hex chars seen so far are valid.
+    std::uint64_t invalid_position_ = 0;        //!< @brief Offset of the first invalid char.
+
+public:
+    /**
+     * @brief   Constructor
+     * @param   window_size         size of the output window in bytes (at least 1)
+     * @param   strict              stop at the first invalid char
+     */
+    explicit HexDecoder(std::uint64_t window_size = 64 * 1024, bool strict = false)
+            : window_(std::max<std::uint64_t>(window_size, 1)), strict_{strict} {
+    }
+
+    /**
+     * @brief   Empties the output window.
+     */
+    void ClearOutput() {
+        used_ = 0;
+    }
+
+    /**
+     * @brief   Decodes the next chunk of hex chars.
+     * @param   hex         the hex chars
+     * @param   size        number of hex chars
+     * @return  number of chars consumed, less than size if the window ran full or a strict decoder failed
+     */
+    std::uint64_t Decode(char const * hex, std::uint64_t size) {
+
+        if (!CanContinue() || (size == 0)) {
+            return 0;
+        }
+
+        std::uint64_t consumed = 0;
+        if (pending_) {
+            if (GetFree() == 0) {
+                return 0;
+            }
+            char const pair[2] = {pending_char_, hex[0]};
+            if (DecodeChars(pair, 2, position_ - 1) == 0) {
+                return 0;
+            }
+            pending_ = false;
+            consumed = 1;
+        }
+
+        auto pairs = std::min<std::uint64_t>((size - consumed) / 2, GetFree());
+        auto decoded = DecodeChars(hex + consumed, pairs * 2, position_ + consumed);
+        consumed += decoded;
+
+        if ((decoded == pairs * 2) && (size - consumed == 1) && CanCarry(hex[consumed], position_ + consumed)) {
+            pending_ = true;
+            pending_char_ = hex[consumed];
+            consumed += 1;
+        }
+
+        position_ += consumed;
+        return consumed;
+    }
+
+    /**
+     * @brief   Decodes the next chunk of hex chars.
+     * @param   hex         the hex chars
+     * @return  number of chars consumed, less than hex.size() if the window ran full or a strict decoder failed
+     */
+    std::uint64_t Decode(std::string_view hex) {
+        return Decode(hex.data(), hex.size());
+    }
+
+    /**
+     * @brief   Ends the stream.
+     * A dangling hex char left over is dropped and counts as invalid, since the total input had an odd length.
+     * @return  true, if all hex chars of the stream have been valid and of even number.
+     */
+    bool Finish() {
+        if (pending_) {
+            pending_ = false;
+            Invalidate(position_ - 1);
+        }
+        return valid_;
+    }
+
+    /**
+     * @brief   Returns the free space left in the output window.
+     * @return  Number of bytes still free.
+     */
+    std::uint64_t GetFree() const {
+        return window_.size() - used_;
+    }
+
+    /**
+     * @brief   Returns the offset of the first invalid char in the stream.
+     * Only meaningful if IsValid() is false.
+     * @return  The offset of the first invalid char.
+     */
+    std::uint64_t GetInvalidPosition() const {
+        return invalid_position_;
+    }
+
+    /**
+     * @brief   Returns the bytes in the output window.
+     * @return  The start of the output window.
+     */
+    std::byte const * GetOutput() const {
+        return window_.data();
+    }
+
+    /**
+     * @brief   Returns the number of bytes in the output window.
+     * @return  Number of bytes in the output window.
+     */
+    std::uint64_t GetOutputSize() const {
+        return used_;
+    }
+
+    /**
+     * @brief   Returns the total number of hex chars consumed so far (including a dangling one).
+     * @return  Number of hex chars consumed.
+     */
+    std::uint64_t GetPosition() const {
+        return position_;
+    }
+
+    /**
+     * @brief   Returns the size of the output window.
+     * @return  The size of the output window in bytes.
+     */
+    std::uint64_t GetWindowSize() const {
+        return window_.size();
+    }
+
+    /**
+     * @brief   Checks if a dangling hex char waits for its partner in the next chunk.
+     * @return  true, if a hex char is carried over.
+     */
+    bool HasPending() const {
+        return pending_;
+    }
+
+    /**
+     * @brief   Checks if this decoder stops at invalid chars.
+     * @return  true, if this decoder is strict.
+     */
+    bool IsStrict() const {
+        return strict_;
+    }
+
+    /**
+     * @brief   Checks if all hex chars seen so far are valid.
+     * @return  true, if no invalid hex char has been seen.
+     */
+    bool IsValid() const {
+        return valid_;
+    }
+
+    /**
+     * @brief   Starts a new stream: empties the output window and resets position, validity and carry.
+     */
+    void Reset() {
+        used_ = 0;
+        position_ = 0;
+        pending_ = false;
+        valid_ = true;
+        invalid_position_ = 0;
+    }
+
+private:
+    /**
+     * @brief   Checks if more input can be consumed.
+     * @return  false, if a strict decoder has seen an invalid char.
+     */
+    bool CanContinue() const {
+        return valid_ || !strict_;
+    }
+
+    /**
+     * @brief   Checks if the last hex char of a chunk may be carried into the next chunk.
+     * A strict decoder refuses an invalid hex char right away.
+     * @param   c           the dangling hex char
+     * @param   offset      stream offset of the dangling hex char
+     * @return  true, if the hex char can be carried over
+     */
+    bool CanCarry(char c, std::uint64_t offset) {
+        if (strict_ && (simd::kHexToNibble[static_cast<unsigned char>(c)] & 0xf0)) {
+            Invalidate(offset);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Decodes an even number of hex chars into the output window.
+     * @param   hex         the hex chars
+     * @param   size        number of hex chars
+     * @param   offset      stream offset of the first hex char
+     * @return  number of hex chars consumed: size or less if a strict decoder hit an invalid char
+     */
+    std::uint64_t DecodeChars(char const * hex, std::uint64_t size, std::uint64_t offset) {
+
+        auto dst = reinterpret_cast<unsigned char *>(window_.data() + used_);
+        auto invalid = simd::HexDecode(dst, hex, size, strict_);
+        if (invalid != size) {
+            Invalidate(offset + invalid);
+            if (strict_) {
+                size = invalid / 2 * 2;
+            }
+        }
+        used_ += size / 2;
+        return size;
+    }
+
+    /**
+     * @brief   Records an invalid hex char.
+     * @param   offset      stream offset of the invalid hex char
+     */
+    void Invalidate(std::uint64_t offset) {
+        if (valid_) {
+            valid_ = false;
+            invalid_position_ = offset;
+        }
+    }
+};
+
+}
+
+
+#endif
@@ -9,16 +9,21 @@
 #ifndef HEADCODE_SPACE_MEM_MEM_MANIPULATOR_HPP
 #define HEADCODE_SPACE_MEM_MEM_MANIPULATOR_HPP
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <functional>
 #include <list>
 #include <map>
 #include <set>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-#include <endian.h>
+#include "mem_simd.hpp"
 
 
 /**
@@ -26,6 +31,194 @@
  */
 namespace headcode::mem {
 
+/**
+ * @brief   Decides how much capacity a MemoryManipulator reserves when a write exceeds its memory.
+ * The default grows geometrically by a factor of 2, so appending N small values costs amortized O(N) copying:
+ * @code
+ *      headcode::mem::MemoryManipulator buffer{blob};                                          // factor 2
+ *      headcode::mem::MemoryManipulator packets{blob, GrowthPolicy::Chunk(64 * 1024)};         // 64 KiB steps
+ *      headcode::mem::MemoryManipulator exact{blob, GrowthPolicy::Exact()};                    // no slack
+ *      headcode::mem::MemoryManipulator custom{blob, GrowthPolicy::Custom(
+ *              [](std::uint64_t capacity, std::uint64_t required) { return required + capacity / 4; })};
+ * @endcode
+ * Policies only affect the capacity, never the size of the memory.
+ */
+class GrowthPolicy {
+
+public:
+    /**
+     * @brief   A caller supplied policy: maps the current capacity and the required size to the new capacity.
+     */
+    using Function = std::function<std::uint64_t(std::uint64_t capacity, std::uint64_t required)>;
+
+private:
+    /**
+     * @brief   The kinds of policies.
+     */
+    enum class Kind : unsigned int {
+        kGeometric = 0,     //!< @brief capacity * factor
+        kChunk = 1,         //!< @brief required rounded up to a multiple of the chunk size
+        kExact = 2,         //!< @brief exactly the required size
+        kCustom = 3         //!< @brief a caller supplied function
+    };
+
+    Kind kind_ = Kind::kGeometric;      //!< @brief The kind of policy.
+    double factor_ = 2.0;               //!< @brief Growth factor of geometric growth.
+    std::uint64_t chunk_size_ = 0;      //!< @brief Chunk size of chunked growth.
+    Function function_;                 //!< @brief The caller supplied policy.
+
+public:
+    /**
+     * @brief   Constructor: geometric growth by a factor of 2.
+     */
+    GrowthPolicy() = default;
+
+    /**
+     * @brief   Grows to the next multiple of a chunk size.
+     * This gives linear growth: appending N bytes costs O(N^2 / chunk_size) copying.
+     * @param   chunk_size      the chunk size (a chunk size of 0 gives exact growth)
+     * @return  The policy.
+     */
+    static GrowthPolicy Chunk(std::uint64_t chunk_size) {
+        GrowthPolicy policy;
+        policy.kind_ = chunk_size ? Kind::kChunk : Kind::kExact;
+        policy.chunk_size_ = chunk_size;
+        return policy;
+    }
+
+    /**
+     * @brief   Grows by a caller supplied function.
+     * A result less than the required size is raised to the required size.
+     * @param   function        the function giving the new capacity (an empty function gives exact growth)
+     * @return  The policy.
+     */
+    static GrowthPolicy Custom(Function function) {
+        GrowthPolicy policy;
+        policy.kind_ = function ? Kind::kCustom : Kind::kExact;
+        policy.function_ = std::move(function);
+        return policy;
+    }
+
+    /**
+     * @brief   Grows to exactly the required size, as std::vector::reserve does.
+     * This keeps the memory tight but makes appending N small values cost O(N^2) copying.
+     * @return  The policy.
+     */
+    static GrowthPolicy Exact() {
+        GrowthPolicy policy;
+        policy.kind_ = Kind::kExact;
+        return policy;
+    }
+
+    /**
+     * @brief   Grows the capacity by a factor.
+     * @param   factor          the growth factor (a factor of 1 or less gives exact growth)
+     * @return  The policy.
+     */
+    static GrowthPolicy Geometric(double factor = 2.0) {
+        GrowthPolicy policy;
+        policy.kind_ = (factor > 1.0) ? Kind::kGeometric : Kind::kExact;
+        policy.factor_ = factor;
+        return policy;
+    }
+
+    /**
+     * @brief   Computes the new capacity.
+     * @param   capacity        the current capacity
+     * @param   required        the size required (greater than capacity)
+     * @return  The new capacity, at least required.
+     */
+    std::uint64_t GetCapacity(std::uint64_t capacity, std::uint64_t required) const {
+
+        std::uint64_t new_capacity = required;
+        switch (kind_) {
+            case Kind::kGeometric:
+                new_capacity = static_cast<std::uint64_t>(static_cast<double>(capacity) * factor_);
+                break;
+            case Kind::kChunk:
+                new_capacity = (required + chunk_size_ - 1) / chunk_size_ * chunk_size_;
+                break;
+            case Kind::kCustom:
+                new_capacity = function_(capacity, required);
+                break;
+            default:
+                break;
+        }
+        return std::max(new_capacity, required);
+    }
+};
+
+/**
+ * @brief   Tells if a type is a std::array.
+ * @tparam  T       the type
+ */
+template <class T>
+struct IsStdArray : std::false_type {};
+
+/**
+ * @brief   Tells if a type is a std::array.
+ * @tparam  T       the type of the items
+ * @tparam  N       the number of items
+ */
+template <class T, std::size_t N>
+struct IsStdArray<std::array<T, N>> : std::true_type {};
+
+/**
+ * @brief   Tells if a MemoryManipulator converts the byte order of a type when it is endian aware.
+ * @tparam  T       the type
+ */
+template <class T>
+inline constexpr bool kIsManipulatorNumber =
+        std::is_same_v<T, std::int16_t> || std::is_same_v<T, std::uint16_t> || std::is_same_v<T, std::int32_t> ||
+        std::is_same_v<T, std::uint32_t> || std::is_same_v<T, std::int64_t> || std::is_same_v<T, std::uint64_t> ||
+        std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/**
+ * @brief   Opt-in for classes a MemoryManipulator writes as they are in memory.
+ * No class is written raw unless this is specialized for it:
+ * @code
+ *      namespace headcode::mem {
+ *      template <>
+ *      struct IsManipulatorRaw<Point> : std::true_type {};
+ *      }
+ * @endcode
+ * The bytes are taken as they are: padding included and without endian conversion, so only opt in plain structs
+ * without pointers whose layout is the wire format.
+ * @tparam  T       the type
+ */
+template <class T>
+struct IsManipulatorRaw : std::false_type {};
+
+/**
+ * @brief   Tells if a MemoryManipulator writes a class as it is in memory.
+ * These are the trivially copyable classes opted in with IsManipulatorRaw.
+ * @tparam  T       the type
+ */
+template <class T>
+inline constexpr bool kIsManipulatorRawClass =
+        std::is_class_v<T> && std::is_trivially_copyable_v<T> && IsManipulatorRaw<T>::value;
+
+/**
+ * @brief   Tells if a MemoryManipulator moves ranges of a type in one copy.
+ * These are the types whose bytes are written as they are in memory (apart from the byte order of numbers), so a
+ * whole container of them is a single copy followed by an in-place byte swap at most.
+ * @tparam  T       the type
+ */
+template <class T>
+inline constexpr bool kIsManipulatorBulk = std::is_same_v<T, bool> || std::is_same_v<T, std::byte> ||
+                                           std::is_same_v<T, char> || std::is_same_v<T, unsigned char> ||
+                                           kIsManipulatorNumber<T> || kIsManipulatorRawClass<T>;
+
+/**
+ * @brief   The byte order in which a BasicMemoryManipulator puts numbers into memory.
+ */
+enum class ManipulatorEndian : unsigned int {
+    kRuntime = 0,       //!< @brief Big endian if set endian aware at runtime, native otherwise.
+    kNative = 1,        //!< @brief The byte order of the CPU.
+    kBig = 2,           //!< @brief Big endian (network byte order).
+    kLittle = 3         //!< @brief Little endian.
+};
+
 /**
  * @brief   This is a read/write mechanism of arbitrary data on a memory area which can handle endian encoding.
  * The MemoryManipulator **does not take ownership** of the memory area managed. It works like this:
@@ -38,19 +231,33 @@ namespace headcode::mem {
  *      }
  *      std::cout << blob.size() << std::end;       // yields 19 = 8 (size of uint64_t) + 3 ('foo') + 8 (size of ul)
  * @endcode
+ * Vectors, std::arrays and C arrays of numbers and bytes (see kIsManipulatorBulk) are moved in a single copy instead of
+ * item by item. Plain structs are written as they are in memory only when opted in with IsManipulatorRaw.
+ *
+ * The byte order of numbers is either chosen at runtime with SetEndianAware() (MemoryManipulator) or fixed at
+ * compile time. A fixed byte order removes the check on each number and allows little endian formats too:
+ * @code
+ *      headcode::mem::BasicMemoryManipulator<headcode::mem::ManipulatorEndian::kBig> network{blob};
+ *      headcode::mem::BasicMemoryManipulator<headcode::mem::ManipulatorEndian::kLittle> file{blob};
+ * @endcode
+ * @tparam  Order       the byte order of numbers in the memory
  */
-class MemoryManipulator {
+template <ManipulatorEndian Order>
+class BasicMemoryManipulator {
 
     bool endian_aware_ = false;                 //!< @brief Enforces endian conversion on POD input.
     mutable std::uint64_t position_ = 0;        //!< @brief read/write position.
     std::vector<std::byte> & memory_;           //!< @brief The memory we work on.
+    GrowthPolicy growth_policy_;                //!< @brief How the capacity of the memory grows.
 
 public:
     /**
      * @brief   Constructor
      * @param   memory              the memory managed.
+     * @param   growth_policy       how the capacity of the memory grows on writes beyond its end.
      */
-    explicit MemoryManipulator(std::vector<std::byte> & memory) : memory_{memory} {
+    explicit BasicMemoryManipulator(std::vector<std::byte> & memory, GrowthPolicy growth_policy = {})
+            : memory_{memory}, growth_policy_{std::move(growth_policy)} {
     }
 
     /**
@@ -58,29 +265,33 @@ public:
      * This is a deep copy but with rw position set to 0.
      * @param   rhs         right hand side manipulator
      */
-    MemoryManipulator(MemoryManipulator const & rhs)
-            : endian_aware_(rhs.endian_aware_), position_(0), memory_{rhs.memory_} {
+    BasicMemoryManipulator(BasicMemoryManipulator const & rhs)
+            : endian_aware_(rhs.endian_aware_),
+              position_(0),
+              memory_{rhs.memory_},
+              growth_policy_{rhs.growth_policy_} {
     }
 
     /**
      * @brief   Move constructor.
      */
-    MemoryManipulator(MemoryManipulator &&) = default;
+    BasicMemoryManipulator(BasicMemoryManipulator &&) = default;
 
     /**
      * @brief   Destructor
      */
-    virtual ~MemoryManipulator() = default;
+    virtual ~BasicMemoryManipulator() = default;
 
     /**
      * @brief   Assignment.
      * @param   rhs         right hand side manipulator
      * @return  this
      */
-    MemoryManipulator & operator=(MemoryManipulator const & rhs) {
+    BasicMemoryManipulator & operator=(BasicMemoryManipulator const & rhs) {
         endian_aware_ = rhs.endian_aware_;
         position_ = 0;
         memory_ = rhs.memory_;
+        growth_policy_ = rhs.growth_policy_;
         return *this;
     }
 
@@ -88,7 +299,7 @@ public:
      * @brief   Move Assignment.
      * @return  this
      */
-    MemoryManipulator & operator=(MemoryManipulator &&) = delete;
+    BasicMemoryManipulator & operator=(BasicMemoryManipulator &&) = delete;
 
     /**
      * @brief   Puts another data particle on top of the manipulator at the read/write position.
@@ -97,11 +308,17 @@ public:
      * @return  new position index value after add
      */
     std::uint64_t Add(void const * data, std::uint64_t size) {
-        Grow(size);
-        if (GetFree() >= size) {
-            std::memcpy(GetPositionPointer(), data, size);
-            position_ += size;
+        if (size == 0) {
+            return position_;
         }
+
+        // bytes within the memory are overwritten, those beyond are appended without zero filling them first
+        Grow(size);
+        auto src = static_cast<std::byte const *>(data);
+        auto overwrite = std::min(size, GetFree());
+        std::memcpy(GetPositionPointer(), src, overwrite);
+        memory_.insert(memory_.end(), src + overwrite, src + size);
+        position_ += size;
         return position_;
     }
 
@@ -128,6 +345,14 @@ public:
         return memory_.size() - position_;
     }
 
+    /**
+     * @brief   Returns the policy by which the capacity of the memory grows.
+     * @return  The growth policy.
+     */
+    GrowthPolicy const & GetGrowthPolicy() const {
+        return growth_policy_;
+    }
+
     /**
      * @brief   Gets the current read/write position.
      * @return  the current read/write position
@@ -154,10 +379,15 @@ public:
 
     /**
      * @brief   Checks if this manipulator does endian conversion.
+     * Manipulators with a byte order fixed at compile time do, if that order differs from the one of the host.
      * @return  true, if it does
      */
     bool IsEndianAware() const {
-        return endian_aware_;
+        if constexpr (Order == ManipulatorEndian::kRuntime) {
+            return endian_aware_;
+        } else {
+            return SwapsBytes();
+        }
     }
 
     /**
@@ -227,8 +457,8 @@ public:
      */
     std::int16_t const & Read(std::int16_t & i) const {
         Pick(&i, sizeof(i));
-        if (IsEndianAware()) {
-            i = be16toh(static_cast<std::uint16_t>(i));
+        if (SwapsBytes()) {
+            i = simd::ByteSwap(static_cast<std::uint16_t>(i));
         }
         return i;
     }
@@ -240,8 +470,8 @@ public:
      */
     std::uint16_t const & Read(std::uint16_t & u) const {
         Pick(&u, sizeof(u));
-        if (IsEndianAware()) {
-            u = be16toh(u);
+        if (SwapsBytes()) {
+            u = simd::ByteSwap(u);
         }
         return u;
     }
@@ -253,8 +483,8 @@ public:
      */
     std::int32_t const & Read(int32_t & i) const {
         Pick(&i, sizeof(i));
-        if (IsEndianAware()) {
-            i = be32toh(static_cast<std::uint32_t>(i));
+        if (SwapsBytes()) {
+            i = simd::ByteSwap(static_cast<std::uint32_t>(i));
         }
         return i;
     }
@@ -266,8 +496,8 @@ public:
      */
     std::uint32_t const & Read(std::uint32_t & u) const {
         Pick(&u, sizeof(u));
-        if (IsEndianAware()) {
-            u = be32toh(u);
+        if (SwapsBytes()) {
+            u = simd::ByteSwap(u);
         }
         return u;
     }
@@ -279,8 +509,8 @@ public:
      */
     std::int64_t const & Read(std::int64_t & i) const {
         Pick(&i, sizeof(i));
-        if (IsEndianAware()) {
-            i = be64toh(static_cast<std::uint64_t>(i));
+        if (SwapsBytes()) {
+            i = simd::ByteSwap(static_cast<std::uint64_t>(i));
         }
         return i;
     }
@@ -292,8 +522,8 @@ public:
      */
     std::uint64_t const & Read(std::uint64_t & u) const {
         Pick(&u, sizeof(u));
-        if (IsEndianAware()) {
-            u = be64toh(u);
+        if (SwapsBytes()) {
+            u = simd::ByteSwap(u);
         }
         return u;
     }
@@ -305,10 +535,10 @@ public:
      */
     float const & Read(float & f) const {
         Pick(&f, sizeof(f));
-        if (IsEndianAware()) {
+        if (SwapsBytes()) {
             std::uint32_t v;
             std::memcpy(&v, &f, sizeof(v));
-            v = be32toh(v);
+            v = simd::ByteSwap(v);
             std::memcpy(&f, &v, sizeof(f));
         }
         return f;
@@ -321,10 +551,10 @@ public:
      */
     double const & Read(double & d) const {
         Pick(&d, sizeof(d));
-        if (IsEndianAware()) {
+        if (SwapsBytes()) {
             std::uint64_t v;
             std::memcpy(&v, &d, sizeof(v));
-            v = be64toh(v);
+            v = simd::ByteSwap(v);
             std::memcpy(&d, &v, sizeof(d));
         }
         return d;
@@ -341,8 +571,9 @@ public:
         if (GetRemaining() < size) {
             size = GetRemaining();
         }
-        m.resize(size);
-        Pick(m.data(), size);
+        auto first = reinterpret_cast<std::byte const *>(GetPositionPointer());
+        m.assign(first, first + size);
+        Advance(size);
 
         return m;
     }
@@ -429,15 +660,55 @@ public:
         v.clear();
         std::uint64_t size{0};
         Read(size);
-        v.reserve(size);
-        for (std::uint64_t i = 0; i < size; ++i) {
-            T e;
-            Read(e);
-            v.push_back(e);
+        if constexpr (kIsManipulatorBulk<T> && !std::is_same_v<T, bool>) {
+            v.resize(std::min(size, GetRemaining() / sizeof(T)));
+            ReadItems(v.data(), v.size());
+        } else {
+            v.reserve(size);
+            for (std::uint64_t i = 0; i < size; ++i) {
+                T e;
+                Read(e);
+                v.push_back(e);
+            }
         }
         return v;
     }
 
+    /**
+     * @brief   Gets an array of items.
+     * The number of items is given by the array and not read.
+     * @param   a       the array to get
+     * @return  a read
+     */
+    template <class T, std::size_t N>
+    std::array<T, N> const & Read(std::array<T, N> & a) const {
+        ReadItems(a.data(), N);
+        return a;
+    }
+
+    /**
+     * @brief   Gets a C array of items.
+     * The number of items is given by the array and not read. Arrays of char are strings and not taken here.
+     * @param   a       the array to get
+     * @return  a read
+     */
+    template <class T, std::size_t N>
+    std::enable_if_t<!std::is_same_v<T, char>, T const (&)[N]> Read(T (&a)[N]) const {
+        ReadItems(a, N);
+        return a;
+    }
+
+    /**
+     * @brief   Gets a class opted in with IsManipulatorRaw as it is in memory.
+     * @param   t       the instance to get
+     * @return  t read
+     */
+    template <class T>
+    std::enable_if_t<kIsManipulatorRawClass<T>, T const &> Read(T & t) const {
+        Pick(&t, sizeof(T));
+        return t;
+    }
+
     /**
      * @brief   Resets read/write position.
      * This does not discard, free or delete any memory already held within the manipulator.
@@ -449,12 +720,22 @@ public:
 
     /**
      * @brief   Sets this manipulator to do endian conversion.
+     * This is for the runtime byte order only.
      * @param   endian_aware        endian conversion flag
      */
     void SetEndianAware(bool endian_aware) {
+        static_assert(Order == ManipulatorEndian::kRuntime, "The byte order is fixed at compile time.");
         endian_aware_ = endian_aware;
     }
 
+    /**
+     * @brief   Sets the policy by which the capacity of the memory grows.
+     * @param   growth_policy       the new growth policy
+     */
+    void SetGrowthPolicy(GrowthPolicy growth_policy) {
+        growth_policy_ = std::move(growth_policy);
+    }
+
     /**
      * @brief   Sets the read/write position.
      * Does nothing, if the position is out of bounds.
@@ -503,8 +784,8 @@ public:
      * @param   i       the int16_t to add
      */
     void Write(std::int16_t i) {
-        if (IsEndianAware()) {
-            i = htobe16(static_cast<std::uint16_t>(i));
+        if (SwapsBytes()) {
+            i = simd::ByteSwap(static_cast<std::uint16_t>(i));
         }
         Add(&i, sizeof(i));
     }
@@ -514,8 +795,8 @@ public:
      * @param   u       the uint16_t to add
      */
     void Write(std::uint16_t u) {
-        if (IsEndianAware()) {
-            u = htobe16(u);
+        if (SwapsBytes()) {
+            u = simd::ByteSwap(u);
         }
         Add(&u, sizeof(u));
     }
@@ -525,8 +806,8 @@ public:
      * @param   i       the int32_t to add
      */
     void Write(std::int32_t i) {
-        if (IsEndianAware()) {
-            i = htobe32(static_cast<std::uint32_t>(i));
+        if (SwapsBytes()) {
+            i = simd::ByteSwap(static_cast<std::uint32_t>(i));
         }
         Add(&i, sizeof(i));
     }
@@ -536,8 +817,8 @@ public:
      * @param   u       the uint32_t to add
      */
     void Write(std::uint32_t u) {
-        if (IsEndianAware()) {
-            u = htobe32(u);
+        if (SwapsBytes()) {
+            u = simd::ByteSwap(u);
         }
         Add(&u, sizeof(u));
     }
@@ -547,8 +828,8 @@ public:
      * @param   i       the int64_t to add
      */
     void Write(std::int64_t i) {
-        if (IsEndianAware()) {
-            i = htobe64(static_cast<std::uint64_t>(i));
+        if (SwapsBytes()) {
+            i = simd::ByteSwap(static_cast<std::uint64_t>(i));
         }
         Add(&i, sizeof(i));
     }
@@ -558,8 +839,8 @@ public:
      * @param   u       the uint64_t to add
      */
     void Write(std::uint64_t u) {
-        if (IsEndianAware()) {
-            u = htobe64(u);
+        if (SwapsBytes()) {
+            u = simd::ByteSwap(u);
         }
         Add(&u, sizeof(u));
     }
@@ -570,10 +851,10 @@ public:
      */
     void Write(float f) {
 
-        if (IsEndianAware()) {
+        if (SwapsBytes()) {
             std::uint32_t v;
             std::memcpy(&v, &f, sizeof(v));
-            v = htobe32(v);
+            v = simd::ByteSwap(v);
             std::memcpy(&f, &v, sizeof(f));
         }
 
@@ -586,10 +867,10 @@ public:
      */
     void Write(double d) {
 
-        if (IsEndianAware()) {
+        if (SwapsBytes()) {
             std::uint64_t v;
             std::memcpy(&v, &d, sizeof(v));
-            v = htobe64(v);
+            v = simd::ByteSwap(v);
             std::memcpy(&d, &v, sizeof(d));
         }
 
@@ -660,12 +941,62 @@ public:
     template <class T>
     void Write(std::vector<T> const & v) {
         Write(static_cast<std::uint64_t>(v.size()));
-        for (auto e : v) {
-            Write(e);
+        if constexpr (std::is_same_v<T, bool>) {
+            for (bool e : v) {
+                Write(e);
+            }
+        } else {
+            WriteItems(v.data(), v.size());
         }
     }
 
+    /**
+     * @brief   Writes an array of items.
+     * Unlike the other containers the number of items is not written, as the array on reading knows it already.
+     * @param   a       the array to write
+     */
+    template <class T, std::size_t N>
+    void Write(std::array<T, N> const & a) {
+        WriteItems(a.data(), N);
+    }
+
+    /**
+     * @brief   Writes a C array of items.
+     * The number of items is not written. Arrays of char are strings and not taken here.
+     * @param   a       the array to write
+     */
+    template <class T, std::size_t N>
+    std::enable_if_t<!std::is_same_v<T, char>> Write(T const (&a)[N]) {
+        WriteItems(a, N);
+    }
+
+    /**
+     * @brief   Writes a class opted in with IsManipulatorRaw as it is in memory.
+     * @param   t       the instance to write
+     */
+    template <class T>
+    std::enable_if_t<kIsManipulatorRawClass<T>> Write(T const & t) {
+        Add(&t, sizeof(T));
+    }
+
 private:
+    /**
+     * @brief   Checks if numbers are byte swapped between the host and the memory.
+     * This is a constant for byte orders fixed at compile time, so the check vanishes.
+     * @return  true, if numbers are byte swapped
+     */
+    bool SwapsBytes() const {
+        if constexpr (Order == ManipulatorEndian::kRuntime) {
+            return endian_aware_ && (Endian::kNative != Endian::kBig);
+        } else if constexpr (Order == ManipulatorEndian::kBig) {
+            return Endian::kNative != Endian::kBig;
+        } else if constexpr (Order == ManipulatorEndian::kLittle) {
+            return Endian::kNative != Endian::kLittle;
+        } else {
+            return false;
+        }
+    }
+
     /**
      * @brief   Gets current read/write position as memory pointer.
      * @return  current read write position into memory
@@ -683,23 +1014,75 @@ private:
     }
 
     /**
-     * @brief   Grows the memory managed (if necessary).
+     * @brief   Grows the capacity of the memory managed (if necessary).
+     * The capacity is raised as the growth policy says, so repeated small writes do not copy the memory each time.
+     * The size is left to the write, which appends the bytes beyond the end.
      * @param   needed_space    amount of needed free size within the memory managed
      */
     void Grow(std::uint64_t needed_space) {
+        std::uint64_t new_size = position_ + needed_space;
+        if (memory_.capacity() < new_size) {
+            memory_.reserve(growth_policy_.GetCapacity(memory_.capacity(), new_size));
+        }
+    }
 
-        if (position_ + needed_space <= memory_.size()) {
-            return;
+    /**
+     * @brief   Reads items into a range, in one copy if they are plain (see kIsManipulatorBulk).
+     * Endian aware manipulators convert numbers while copying them with the vectorized simd::ByteSwap. Only whole
+     * items are read: those for which there is no data left are not touched.
+     * @param   items       the items to read
+     * @param   count       number of items
+     */
+    template <class T>
+    void ReadItems(T * items, std::uint64_t count) const {
+        if constexpr (kIsManipulatorBulk<T>) {
+            count = std::min(count, GetRemaining() / sizeof(T));
+            if constexpr (kIsManipulatorNumber<T>) {
+                if (SwapsBytes()) {
+                    simd::ByteSwap<sizeof(T)>(reinterpret_cast<char *>(items), GetPositionPointer(), count);
+                    Advance(count * sizeof(T));
+                    return;
+                }
+            }
+            Pick(items, count * sizeof(T));
+        } else {
+            for (std::uint64_t i = 0; i < count; ++i) {
+                Read(items[i]);
+            }
         }
+    }
 
-        std::uint64_t new_size = position_ + needed_space;
-        if (memory_.capacity() < new_size) {
-            memory_.reserve(new_size);
+    /**
+     * @brief   Writes a range of items, in one copy if they are plain (see kIsManipulatorBulk).
+     * Endian aware manipulators convert numbers in place afterwards with the vectorized simd::ByteSwap.
+     * @param   items       the items to write
+     * @param   count       number of items
+     */
+    template <class T>
+    void WriteItems(T const * items, std::uint64_t count) {
+        if constexpr (kIsManipulatorBulk<T>) {
+            auto first = position_;
+            Add(items, count * sizeof(T));
+            if constexpr (kIsManipulatorNumber<T>) {
+                if (SwapsBytes()) {
+                    auto written = reinterpret_cast<char *>(memory_.data() + first);
+                    simd::ByteSwap<sizeof(T)>(written, written, count);
+                }
+            }
+        } else {
+            for (std::uint64_t i = 0; i < count; ++i) {
+                Write(items[i]);
+            }
         }
-        memory_.resize(new_size);
     }
 };
 
+
+/**
+ * @brief   The manipulator with the byte order chosen at runtime by SetEndianAware().
+ */
+using MemoryManipulator = BasicMemoryManipulator<ManipulatorEndian::kRuntime>;
+
 }
 
 /**
@@ -708,7 +1091,8 @@ private:
  * @param   c           char
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, char c) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs, char c) {
     lhs.Write(c);
     return lhs;
 }
@@ -719,7 +1103,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   uc          unsigned char
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, unsigned char uc) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          unsigned char uc) {
     lhs.Write(uc);
     return lhs;
 }
@@ -730,7 +1116,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   b           byte
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::byte b) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::byte b) {
     lhs.Write(b);
     return lhs;
 }
@@ -741,7 +1129,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   i           int16_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::int16_t i) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::int16_t i) {
     lhs.Write(i);
     return lhs;
 }
@@ -752,7 +1142,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   ui          uint16_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::uint16_t ui) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::uint16_t ui) {
     lhs.Write(ui);
     return lhs;
 }
@@ -763,7 +1155,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   i           int32_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::int32_t i) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::int32_t i) {
     lhs.Write(i);
     return lhs;
 }
@@ -774,7 +1168,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   ui          uint32_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::uint32_t ui) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::uint32_t ui) {
     lhs.Write(ui);
     return lhs;
 }
@@ -785,7 +1181,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   i           int64_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::int64_t i) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::int64_t i) {
     lhs.Write(i);
     return lhs;
 }
@@ -796,7 +1194,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   ui          uint64_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::uint64_t ui) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::uint64_t ui) {
     lhs.Write(ui);
     return lhs;
 }
@@ -807,7 +1207,8 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   f           float
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, float f) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs, float f) {
     lhs.Write(f);
     return lhs;
 }
@@ -818,7 +1219,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   d           double
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, double d) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          double d) {
     lhs.Write(d);
     return lhs;
 }
@@ -829,8 +1232,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   m           memory
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs,
-                                                     std::vector<std::byte> const & m) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::vector<std::byte> const & m) {
     lhs.Write(m);
     return lhs;
 }
@@ -841,7 +1245,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   s           string
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::string const & s) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::string const & s) {
     lhs.Write(s);
     return lhs;
 }
@@ -852,7 +1258,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   s           string
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, char const * s) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          char const * s) {
     lhs.Write(std::string{s});
     return lhs;
 }
@@ -863,8 +1271,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   l           list
  * @return  lhs
  */
-template <class T>
-headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::list<T> const & l) {
+template <headcode::mem::ManipulatorEndian Order, class T>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::list<T> const & l) {
     lhs.Write(l);
     return lhs;
 }
@@ -875,8 +1284,9 @@ headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator &
  * @param   m           map
  * @return  lhs
  */
-template <class K, class T>
-headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::map<K, T> const & m) {
+template <headcode::mem::ManipulatorEndian Order, class K, class T>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::map<K, T> const & m) {
     lhs.Write(m);
     return lhs;
 }
@@ -887,8 +1297,9 @@ headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator &
  * @param   s           set
  * @return  lhs
  */
-template <class T>
-headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::set<T> const & s) {
+template <headcode::mem::ManipulatorEndian Order, class T>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::set<T> const & s) {
     lhs.Write(s);
     return lhs;
 }
@@ -899,19 +1310,60 @@ headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator &
  * @param   v           vector
  * @return  lhs
  */
-template <class T>
-headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, std::vector<T> const & v) {
+template <headcode::mem::ManipulatorEndian Order, class T>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::vector<T> const & v) {
     lhs.Write(v);
     return lhs;
 }
 
+/**
+ * @brief   Stream in
+ * @param   lhs         left-hand-side manipulator
+ * @param   a           array
+ * @return  lhs
+ */
+template <headcode::mem::ManipulatorEndian Order, class T, std::size_t N>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::array<T, N> const & a) {
+    lhs.Write(a);
+    return lhs;
+}
+
+/**
+ * @brief   Stream in
+ * @param   lhs         left-hand-side manipulator
+ * @param   a           C array (not of char)
+ * @return  lhs
+ */
+template <headcode::mem::ManipulatorEndian Order, class T, std::size_t N>
+std::enable_if_t<!std::is_same_v<T, char>, headcode::mem::BasicMemoryManipulator<Order> &> operator<<(
+        headcode::mem::BasicMemoryManipulator<Order> & lhs, T const (&a)[N]) {
+    lhs.Write(a);
+    return lhs;
+}
+
+/**
+ * @brief   Stream in
+ * @param   lhs         left-hand-side manipulator
+ * @param   t           class opted in with IsManipulatorRaw
+ * @return  lhs
+ */
+template <headcode::mem::ManipulatorEndian Order, class T>
+std::enable_if_t<headcode::mem::kIsManipulatorRawClass<T>, headcode::mem::BasicMemoryManipulator<Order> &> operator<<(
+        headcode::mem::BasicMemoryManipulator<Order> & lhs, T const & t) {
+    lhs.Write(t);
+    return lhs;
+}
+
 /**
  * @brief   Stream in
  * @param   lhs         left-hand-side manipulator
  * @param   b           bool
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipulator & lhs, bool b) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator<<(headcode::mem::BasicMemoryManipulator<Order> & lhs, bool b) {
     lhs.Write(b);
     return lhs;
 }
@@ -922,7 +1374,9 @@ inline headcode::mem::MemoryManipulator & operator<<(headcode::mem::MemoryManipu
  * @param   c           char
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, char & c) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          char & c) {
     lhs.Read(c);
     return lhs;
 }
@@ -933,7 +1387,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   uc          unsigned char
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, unsigned char & uc) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          unsigned char & uc) {
     lhs.Read(uc);
     return lhs;
 }
@@ -944,7 +1400,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   b           byte
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::byte & b) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::byte & b) {
     lhs.Read(b);
     return lhs;
 }
@@ -955,7 +1413,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   i           int16_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::int16_t & i) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::int16_t & i) {
     lhs.Read(i);
     return lhs;
 }
@@ -966,7 +1426,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   ui          uint16_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::uint16_t & ui) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::uint16_t & ui) {
     lhs.Read(ui);
     return lhs;
 }
@@ -977,7 +1439,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   i           int32_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::int32_t & i) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::int32_t & i) {
     lhs.Read(i);
     return lhs;
 }
@@ -988,7 +1452,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   ui          uint32_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::uint32_t & ui) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::uint32_t & ui) {
     lhs.Read(ui);
     return lhs;
 }
@@ -999,7 +1465,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   i           int64_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::int64_t & i) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::int64_t & i) {
     lhs.Read(i);
     return lhs;
 }
@@ -1010,7 +1478,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   ui          uint64_t
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::uint64_t & ui) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::uint64_t & ui) {
     lhs.Read(ui);
     return lhs;
 }
@@ -1021,7 +1491,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   f           float
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, float & f) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          float & f) {
     lhs.Read(f);
     return lhs;
 }
@@ -1032,7 +1504,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   d           double
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, double & d) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          double & d) {
     lhs.Read(d);
     return lhs;
 }
@@ -1043,8 +1517,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   m           memory
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs,
-                                                     std::vector<std::byte> & m) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::vector<std::byte> & m) {
     lhs.Read(m);
     return lhs;
 }
@@ -1055,7 +1530,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   s           string
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::string & s) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::string & s) {
     lhs.Read(s);
     return lhs;
 }
@@ -1066,8 +1543,9 @@ inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipu
  * @param   l           list
  * @return  lhs
  */
-template <class T>
-headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::list<T> & l) {
+template <headcode::mem::ManipulatorEndian Order, class T>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::list<T> & l) {
     lhs.Read(l);
     return lhs;
 }
@@ -1078,8 +1556,9 @@ headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator &
  * @param   m           map
  * @return  lhs
  */
-template <class K, class T>
-headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::map<K, T> & m) {
+template <headcode::mem::ManipulatorEndian Order, class K, class T>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::map<K, T> & m) {
     lhs.Read(m);
     return lhs;
 }
@@ -1090,8 +1569,9 @@ headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator &
  * @param   s           set
  * @return  lhs
  */
-template <class T>
-headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::set<T> & s) {
+template <headcode::mem::ManipulatorEndian Order, class T>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::set<T> & s) {
     lhs.Read(s);
     return lhs;
 }
@@ -1102,19 +1582,61 @@ headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator &
  * @param   v           vector
  * @return  lhs
  */
-template <class T>
-headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, std::vector<T> & v) {
+template <headcode::mem::ManipulatorEndian Order, class T>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::vector<T> & v) {
     lhs.Read(v);
     return lhs;
 }
 
+/**
+ * @brief   Stream out
+ * @param   lhs         left-hand-side manipulator
+ * @param   a           array
+ * @return  lhs
+ */
+template <headcode::mem::ManipulatorEndian Order, class T, std::size_t N>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          std::array<T, N> & a) {
+    lhs.Read(a);
+    return lhs;
+}
+
+/**
+ * @brief   Stream out
+ * @param   lhs         left-hand-side manipulator
+ * @param   a           C array (not of char)
+ * @return  lhs
+ */
+template <headcode::mem::ManipulatorEndian Order, class T, std::size_t N>
+std::enable_if_t<!std::is_same_v<T, char>, headcode::mem::BasicMemoryManipulator<Order> &> operator>>(
+        headcode::mem::BasicMemoryManipulator<Order> & lhs, T (&a)[N]) {
+    lhs.Read(a);
+    return lhs;
+}
+
+/**
+ * @brief   Stream out
+ * @param   lhs         left-hand-side manipulator
+ * @param   t           class opted in with IsManipulatorRaw
+ * @return  lhs
+ */
+template <headcode::mem::ManipulatorEndian Order, class T>
+std::enable_if_t<headcode::mem::kIsManipulatorRawClass<T>, headcode::mem::BasicMemoryManipulator<Order> &> operator>>(
+        headcode::mem::BasicMemoryManipulator<Order> & lhs, T & t) {
+    lhs.Read(t);
+    return lhs;
+}
+
 /**
  * @brief   Stream out
  * @param   lhs         left-hand-side manipulator
  * @param   b           bool
  * @return  lhs
  */
-inline headcode::mem::MemoryManipulator & operator>>(headcode::mem::MemoryManipulator & lhs, bool & b) {
+template <headcode::mem::ManipulatorEndian Order>
+headcode::mem::BasicMemoryManipulator<Order> & operator>>(headcode::mem::BasicMemoryManipulator<Order> & lhs,
+                                                          bool & b) {
     lhs.Read(b);
     return lhs;
 }
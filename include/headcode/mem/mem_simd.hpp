@@ -0,0 +1,2015 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#ifndef HEADCODE_SPACE_MEM_MEM_SIMD_HPP
+#define HEADCODE_SPACE_MEM_MEM_SIMD_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <unistd.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define HEADCODE_SPACE_MEM_SIMD_X86 1
+#define HEADCODE_SPACE_MEM_TARGET(x) __attribute__((target(x)))
+#include <immintrin.h>
+#endif
+
+
+/**
+ * @brief   The headcode mem namespace
+ */
+namespace headcode::mem {
+
+/**
+ * @brief   The vector instruction sets used by the mem kernels, ordered by capability.
+ * A level implies all levels below it.
+ */
+enum class SimdLevel : unsigned int {
+    kScalar = 0,        //!< @brief Plain C++, no vector instructions.
+    kSSE2 = 1,          //!< @brief x86 SSE2, 16 bytes per vector.
+    kSSSE3 = 2,         //!< @brief x86 SSSE3, 16 bytes per vector with byte shuffles.
+    kAVX2 = 3,          //!< @brief x86 AVX2, 32 bytes per vector.
+    kAVX512VBMI = 4     //!< @brief x86 AVX-512 (F, BW and VBMI), 64 bytes per vector.
+};
+
+/**
+ * @brief   The Base64 alphabets of RFC 4648.
+ */
+enum class Base64Alphabet : unsigned int {
+    kStandard = 0,      //!< @brief "+" and "/" for 62 and 63, padded with "=".
+    kUrl = 1            //!< @brief URL and file name safe: "-" and "_" for 62 and 63, no padding.
+};
+
+/**
+ * @brief   The Base85 alphabets.
+ */
+enum class Base85Alphabet : unsigned int {
+    kZ85 = 0,           //!< @brief ZeroMQ Z85, safe within quoted strings.
+    kAscii85 = 1        //!< @brief Ascii85 (btoa, PDF): '!' to 'u'.
+};
+
+/**
+ * @brief   The byte order of values in memory.
+ */
+enum class Endian : unsigned int {
+    kLittle = 0,        //!< @brief Least significant byte first.
+    kBig = 1,           //!< @brief Most significant byte first (network byte order).
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    kNative = kBig      //!< @brief The byte order of the CPU.
+#else
+    kNative = kLittle   //!< @brief The byte order of the CPU.
+#endif
+};
+
+/**
+ * @brief   Queries the system for the size of the last level cache.
+ * @return  The size of the L3 cache (or L2 if there is no L3) in bytes, 8 MiB if unknown.
+ */
+inline std::uint64_t DetectLastLevelCacheSize();
+
+/**
+ * @brief   Queries the CPU for the best vector instruction set usable.
+ * @return  The highest SimdLevel the CPU (and OS) supports.
+ */
+inline SimdLevel DetectSimdLevel();
+
+/**
+ * @brief   Returns the last level cache size used by the mem functions to decide on non-temporal stores.
+ * This is DetectLastLevelCacheSize() evaluated once.
+ * @return  The last level cache size in bytes.
+ */
+inline std::uint64_t GetLastLevelCacheSize();
+
+/**
+ * @brief   Returns the SimdLevel used by the mem functions.
+ * This is DetectSimdLevel() evaluated once.
+ * @return  The SimdLevel used.
+ */
+inline SimdLevel GetSimdLevel();
+
+/**
+ * @brief   Returns a human readable name of a SimdLevel.
+ * @param   level       the level
+ * @return  The name of the level.
+ */
+inline char const * SimdLevelToString(SimdLevel level);
+
+/**
+ * @brief   The vector kernels of mem.
+ * Each kernel exists in several flavours, one per SimdLevel. The dispatcher functions (without suffix)
+ * pick the flavour matching the given level, but never one higher than GetSimdLevel().
+ */
+namespace simd {
+
+/**
+ * @brief   Creates the table of the hex representation of all bytes.
+ * @param   upper_case      use upper case hex digits
+ * @return  The two hex chars of each byte.
+ */
+constexpr std::array<std::array<char, 2>, 256> MakeByteToHexTable(bool upper_case = false) {
+
+    char const * digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::array<std::array<char, 2>, 256> table{};
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        table[i][0] = digits[i >> 4u];
+        table[i][1] = digits[i & 0x0fu];
+    }
+    return table;
+}
+
+/**
+ * @brief   The two hex chars of each byte, built at compile time.
+ */
+inline constexpr std::array<std::array<char, 2>, 256> kByteToHex = MakeByteToHexTable();
+
+/**
+ * @brief   The two upper case hex chars of each byte, built at compile time.
+ */
+inline constexpr std::array<std::array<char, 2>, 256> kByteToHexUpper = MakeByteToHexTable(true);
+
+/**
+ * @brief   Writes the hex representation of a memory area (scalar version).
+ * @param   dst         destination, must hold at least 2 * size chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ */
+inline void HexEncodeScalar(char * dst, unsigned char const * src, std::uint64_t size) {
+    for (std::uint64_t i = 0; i < size; ++i) {
+        dst[i * 2] = kByteToHex[src[i]][0];
+        dst[i * 2 + 1] = kByteToHex[src[i]][1];
+    }
+}
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+
+/**
+ * @brief   Turns 16 nibbles (0x00-0x0f) into their hex chars without a shuffle (SSE2).
+ * @param   nibbles     the nibbles
+ * @return  the hex chars
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline __m128i NibblesToHexSSE2(__m128i nibbles) {
+    __m128i const above_nine = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    __m128i const digits = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+    return _mm_add_epi8(digits, _mm_and_si128(above_nine, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+/**
+ * @brief   Writes the hex representation of a memory area (SSE2 version, 16 bytes per iteration).
+ * @param   dst         destination, must hold at least 2 * size chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline void HexEncodeSSE2(char * dst, unsigned char const * src, std::uint64_t size) {
+
+    __m128i const mask = _mm_set1_epi8(0x0f);
+
+    std::uint64_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+        __m128i hi = NibblesToHexSSE2(_mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        __m128i lo = NibblesToHexSSE2(_mm_and_si128(v, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    HexEncodeScalar(dst + i * 2, src + i, size - i);
+}
+
+/**
+ * @brief   Writes the hex representation of a memory area (SSSE3 version, 16 bytes per iteration).
+ * @param   dst         destination, must hold at least 2 * size chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ */
+HEADCODE_SPACE_MEM_TARGET("ssse3")
+inline void HexEncodeSSSE3(char * dst, unsigned char const * src, std::uint64_t size) {
+
+    __m128i const mask = _mm_set1_epi8(0x0f);
+    __m128i const table = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+
+    std::uint64_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+        __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(v, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    HexEncodeScalar(dst + i * 2, src + i, size - i);
+}
+
+/**
+ * @brief   Writes the hex representation of a memory area (AVX2 version, 32 bytes per iteration).
+ * @param   dst         destination, must hold at least 2 * size chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline void HexEncodeAVX2(char * dst, unsigned char const * src, std::uint64_t size) {
+
+    __m256i const mask = _mm256_set1_epi8(0x0f);
+    __m256i const table = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e',
+                                           'f', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd',
+                                           'e', 'f');
+
+    std::uint64_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+        __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+        __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, mask));
+
+        // unpack works within 128 bit lanes: fix lane order afterwards
+        __m256i first = _mm256_unpacklo_epi8(hi, lo);
+        __m256i second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 2), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 2 + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+
+    HexEncodeScalar(dst + i * 2, src + i, size - i);
+}
+
+/**
+ * @brief   Writes the hex representation of a memory area (AVX-512 VBMI version, 64 bytes per iteration).
+ * @param   dst         destination, must hold at least 2 * size chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ */
+HEADCODE_SPACE_MEM_TARGET("avx512f,avx512bw,avx512vbmi")
+inline void HexEncodeAVX512VBMI(char * dst, unsigned char const * src, std::uint64_t size) {
+
+    // interleave indices for _mm512_permutex2var_epi8: even output bytes from the high nibbles (0-63),
+    // odd output bytes from the low nibbles (64-127)
+    static unsigned char const interleave[2][64] = {
+            {0,  64, 1,  65, 2,  66, 3,  67, 4,  68, 5,  69, 6,  70, 7,  71, 8,  72, 9,  73, 10, 74,
+             11, 75, 12, 76, 13, 77, 14, 78, 15, 79, 16, 80, 17, 81, 18, 82, 19, 83, 20, 84, 21, 85,
+             22, 86, 23, 87, 24, 88, 25, 89, 26, 90, 27, 91, 28, 92, 29, 93, 30, 94, 31, 95},
+            {32, 96,  33, 97,  34, 98,  35, 99,  36, 100, 37, 101, 38, 102, 39, 103, 40, 104, 41, 105, 42, 106,
+             43, 107, 44, 108, 45, 109, 46, 110, 47, 111, 48, 112, 49, 113, 50, 114, 51, 115, 52, 116, 53, 117,
+             54, 118, 55, 119, 56, 120, 57, 121, 58, 122, 59, 123, 60, 124, 61, 125, 62, 126, 63, 127}};
+
+    static char const hex_table[] = "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+
+    __m512i const mask = _mm512_set1_epi8(0x0f);
+    __m512i const table = _mm512_loadu_si512(hex_table);
+    __m512i const interleave_first = _mm512_loadu_si512(interleave[0]);
+    __m512i const interleave_second = _mm512_loadu_si512(interleave[1]);
+
+    std::uint64_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m512i v = _mm512_loadu_si512(src + i);
+        __m512i hi = _mm512_shuffle_epi8(table, _mm512_and_si512(_mm512_srli_epi16(v, 4), mask));
+        __m512i lo = _mm512_shuffle_epi8(table, _mm512_and_si512(v, mask));
+        _mm512_storeu_si512(dst + i * 2, _mm512_permutex2var_epi8(hi, interleave_first, lo));
+        _mm512_storeu_si512(dst + i * 2 + 64, _mm512_permutex2var_epi8(hi, interleave_second, lo));
+    }
+
+    HexEncodeAVX2(dst + i * 2, src + i, size - i);
+}
+
+#endif
+
+/**
+ * @brief   Writes the hex representation of a memory area with the kernel of the given level.
+ * @param   dst         destination, must hold at least 2 * size chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ * @param   level       the SimdLevel to use (capped at GetSimdLevel())
+ */
+inline void HexEncode(char * dst, char const * src, std::uint64_t size, SimdLevel level = GetSimdLevel()) {
+
+    auto source = reinterpret_cast<unsigned char const *>(src);
+    if (level > GetSimdLevel()) {
+        level = GetSimdLevel();
+    }
+
+    switch (level) {
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+        case SimdLevel::kAVX512VBMI:
+            HexEncodeAVX512VBMI(dst, source, size);
+            return;
+        case SimdLevel::kAVX2:
+            HexEncodeAVX2(dst, source, size);
+            return;
+        case SimdLevel::kSSSE3:
+            HexEncodeSSSE3(dst, source, size);
+            return;
+        case SimdLevel::kSSE2:
+            HexEncodeSSE2(dst, source, size);
+            return;
+#endif
+        default:
+            HexEncodeScalar(dst, source, size);
+    }
+}
+
+/**
+ * @brief   Creates the table of nibble values of all chars.
+ * @return  The nibble value of each char with 0xff for non-hex chars.
+ */
+constexpr std::array<unsigned char, 256> MakeHexToNibbleTable() {
+
+    std::array<unsigned char, 256> table{};
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        table[i] = 0xff;
+    }
+    for (unsigned char i = 0; i < 10; ++i) {
+        table['0' + i] = i;
+    }
+    for (unsigned char i = 0; i < 6; ++i) {
+        table['a' + i] = 0x0a + i;
+        table['A' + i] = 0x0a + i;
+    }
+    return table;
+}
+
+/**
+ * @brief   Nibble value of each char, 0xff marks a non-hex char.
+ */
+inline constexpr std::array<unsigned char, 256> kHexToNibble = MakeHexToNibbleTable();
+
+/**
+ * @brief   Decodes hex chars to memory (scalar version).
+ * Invalid chars are decoded as 0. A dangling last char is ignored.
+ * @param   dst         destination, must hold at least size / 2 bytes
+ * @param   src         the hex chars
+ * @param   size        number of hex chars
+ * @param   strict      stop at the first invalid char
+ * @return  offset of the first invalid char in src or size if all are valid
+ */
+inline std::uint64_t HexDecodeScalar(unsigned char * dst, char const * src, std::uint64_t size, bool strict) {
+
+    std::uint64_t invalid = size;
+    for (std::uint64_t i = 0; i + 1 < size; i += 2) {
+
+        unsigned char hi = kHexToNibble[static_cast<unsigned char>(src[i])];
+        unsigned char lo = kHexToNibble[static_cast<unsigned char>(src[i + 1])];
+        if ((hi | lo) & 0xf0) {
+            if (invalid == size) {
+                invalid = (hi & 0xf0) ? i : i + 1;
+            }
+            if (strict) {
+                return invalid;
+            }
+            hi = (hi & 0xf0) ? 0 : hi;
+            lo = (lo & 0xf0) ? 0 : lo;
+        }
+        dst[i / 2] = static_cast<unsigned char>((hi << 4) | lo);
+    }
+
+    return invalid;
+}
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+
+/**
+ * @brief   Turns 16 hex chars into their nibble values (SSE2).
+ * @param   chars       the hex chars
+ * @param   valid       receives 0xff for each valid hex char, 0x00 otherwise
+ * @return  the nibbles, 0 for invalid chars
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline __m128i HexToNibblesSSE2(__m128i chars, __m128i & valid) {
+
+    __m128i const zero = _mm_setzero_si128();
+    __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_subs_epu8(digit, _mm_set1_epi8(9)), zero);
+    __m128i alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_alpha = _mm_cmpeq_epi8(_mm_subs_epu8(alpha, _mm_set1_epi8(5)), zero);
+
+    valid = _mm_or_si128(is_digit, is_alpha);
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+/**
+ * @brief   Joins pairs of nibbles into 16 bit words holding the byte value (SSE2).
+ * @param   nibbles     the nibbles, high nibble first
+ * @return  8 words with the byte values
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline __m128i JoinNibblesSSE2(__m128i nibbles) {
+    __m128i hi = _mm_and_si128(_mm_slli_epi16(nibbles, 4), _mm_set1_epi16(0x00f0));
+    return _mm_or_si128(hi, _mm_srli_epi16(nibbles, 8));
+}
+
+/**
+ * @brief   Decodes hex chars to memory (SSE2 version, 32 chars per iteration).
+ * @param   dst         destination, must hold at least size / 2 bytes
+ * @param   src         the hex chars
+ * @param   size        number of hex chars
+ * @param   strict      stop at the first invalid char
+ * @return  offset of the first invalid char in src or size if all are valid
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline std::uint64_t HexDecodeSSE2(unsigned char * dst, char const * src, std::uint64_t size, bool strict) {
+
+    std::uint64_t invalid = size;
+    std::uint64_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+
+        __m128i valid_first;
+        __m128i valid_second;
+        __m128i first = HexToNibblesSSE2(_mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i)), valid_first);
+        __m128i second =
+                HexToNibblesSSE2(_mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i + 16)), valid_second);
+
+        auto valid = static_cast<std::uint32_t>(_mm_movemask_epi8(valid_first)) |
+                     (static_cast<std::uint32_t>(_mm_movemask_epi8(valid_second)) << 16);
+        if (valid != 0xffffffffu) {
+            if (invalid == size) {
+                invalid = i + __builtin_ctz(~valid);
+            }
+            if (strict) {
+                // the pairs before the invalid char are decoded nonetheless
+                HexDecodeScalar(dst + i / 2, src + i, 32, true);
+                return invalid;
+            }
+        }
+
+        __m128i bytes = _mm_packus_epi16(JoinNibblesSSE2(first), JoinNibblesSSE2(second));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i / 2), bytes);
+    }
+
+    auto tail_invalid = HexDecodeScalar(dst + i / 2, src + i, size - i, strict);
+    if ((invalid == size) && (tail_invalid != size - i)) {
+        invalid = i + tail_invalid;
+    }
+    return invalid;
+}
+
+/**
+ * @brief   Decodes hex chars to memory (AVX2 version, 32 chars per iteration).
+ * @param   dst         destination, must hold at least size / 2 bytes
+ * @param   src         the hex chars
+ * @param   size        number of hex chars
+ * @param   strict      stop at the first invalid char
+ * @return  offset of the first invalid char in src or size if all are valid
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline std::uint64_t HexDecodeAVX2(unsigned char * dst, char const * src, std::uint64_t size, bool strict) {
+
+    __m256i const zero = _mm256_setzero_si256();
+
+    std::uint64_t invalid = size;
+    std::uint64_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+        __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+        __m256i is_digit = _mm256_cmpeq_epi8(_mm256_subs_epu8(digit, _mm256_set1_epi8(9)), zero);
+        __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_subs_epu8(alpha, _mm256_set1_epi8(5)), zero);
+
+        auto valid = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)));
+        if (valid != 0xffffffffu) {
+            if (invalid == size) {
+                invalid = i + __builtin_ctz(~valid);
+            }
+            if (strict) {
+                // the pairs before the invalid char are decoded nonetheless
+                HexDecodeScalar(dst + i / 2, src + i, 32, true);
+                return invalid;
+            }
+        }
+
+        __m256i nibbles = _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                                          _mm256_and_si256(is_alpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+        __m256i words = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(nibbles, 4), _mm256_set1_epi16(0x00f0)),
+                                        _mm256_srli_epi16(nibbles, 8));
+
+        // pack works within 128 bit lanes: gather the low quad word of each lane
+        __m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(words, words), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i / 2), _mm256_castsi256_si128(bytes));
+    }
+
+    auto tail_invalid = HexDecodeScalar(dst + i / 2, src + i, size - i, strict);
+    if ((invalid == size) && (tail_invalid != size - i)) {
+        invalid = i + tail_invalid;
+    }
+    return invalid;
+}
+
+/**
+ * @brief   Decodes hex chars to memory (AVX-512 BW version, 64 chars per iteration).
+ * @param   dst         destination, must hold at least size / 2 bytes
+ * @param   src         the hex chars
+ * @param   size        number of hex chars
+ * @param   strict      stop at the first invalid char
+ * @return  offset of the first invalid char in src or size if all are valid
+ */
+HEADCODE_SPACE_MEM_TARGET("avx512f,avx512bw")
+inline std::uint64_t HexDecodeAVX512(unsigned char * dst, char const * src, std::uint64_t size, bool strict) {
+
+    std::uint64_t invalid = size;
+    std::uint64_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+
+        __m512i chars = _mm512_loadu_si512(src + i);
+        __m512i digit = _mm512_sub_epi8(chars, _mm512_set1_epi8('0'));
+        __mmask64 is_digit = _mm512_cmple_epu8_mask(digit, _mm512_set1_epi8(9));
+        __m512i alpha = _mm512_sub_epi8(_mm512_or_si512(chars, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+        __mmask64 is_alpha = _mm512_cmple_epu8_mask(alpha, _mm512_set1_epi8(5));
+
+        std::uint64_t valid = is_digit | is_alpha;
+        if (valid != ~std::uint64_t{0}) {
+            if (invalid == size) {
+                invalid = i + __builtin_ctzll(~valid);
+            }
+            if (strict) {
+                // the pairs before the invalid char are decoded nonetheless
+                HexDecodeScalar(dst + i / 2, src + i, 64, true);
+                return invalid;
+            }
+        }
+
+        __m512i nibbles = _mm512_mask_blend_epi8(is_alpha, _mm512_maskz_mov_epi8(is_digit, digit),
+                                                 _mm512_add_epi8(alpha, _mm512_set1_epi8(10)));
+        __m512i words = _mm512_or_si512(_mm512_and_si512(_mm512_slli_epi16(nibbles, 4), _mm512_set1_epi16(0x00f0)),
+                                        _mm512_srli_epi16(nibbles, 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i / 2), _mm512_maskz_cvtepi16_epi8(~__mmask32{0}, words));
+    }
+
+    auto tail_invalid = HexDecodeAVX2(dst + i / 2, src + i, size - i, strict);
+    if ((invalid == size) && (tail_invalid != size - i)) {
+        invalid = i + tail_invalid;
+    }
+    return invalid;
+}
+
+#endif
+
+/**
+ * @brief   Decodes hex chars to memory with the kernel of the given level.
+ * Invalid chars are decoded as 0 unless strict is set. A dangling last char is ignored.
+ * @param   dst         destination, must hold at least size / 2 bytes
+ * @param   src         the hex chars
+ * @param   size        number of hex chars
+ * @param   strict      stop at the first invalid char
+ * @param   level       the SimdLevel to use (capped at GetSimdLevel())
+ * @return  offset of the first invalid char in src or size if all are valid
+ */
+inline std::uint64_t HexDecode(unsigned char * dst,
+                               char const * src,
+                               std::uint64_t size,
+                               bool strict,
+                               SimdLevel level = GetSimdLevel()) {
+
+    if (level > GetSimdLevel()) {
+        level = GetSimdLevel();
+    }
+
+    switch (level) {
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+        case SimdLevel::kAVX512VBMI:
+            return HexDecodeAVX512(dst, src, size, strict);
+        case SimdLevel::kAVX2:
+            return HexDecodeAVX2(dst, src, size, strict);
+        case SimdLevel::kSSSE3:
+        case SimdLevel::kSSE2:
+            return HexDecodeSSE2(dst, src, size, strict);
+#endif
+        default:
+            return HexDecodeScalar(dst, src, size, strict);
+    }
+}
+
+/**
+ * @brief   Returns the 64 chars of a Base64 alphabet.
+ * @param   alphabet    the Base64 alphabet
+ * @return  The chars for the values 0 to 63.
+ */
+constexpr char const * Base64Chars(Base64Alphabet alphabet) {
+    return alphabet == Base64Alphabet::kUrl ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+                                            : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+}
+
+/**
+ * @brief   Returns the number of chars the Base64 representation of a memory area has.
+ * @param   size        size of the memory area
+ * @param   alphabet    the Base64 alphabet (kStandard pads to a multiple of 4 chars)
+ * @return  The number of Base64 chars.
+ */
+constexpr std::uint64_t Base64EncodedSize(std::uint64_t size, Base64Alphabet alphabet) {
+    if (alphabet == Base64Alphabet::kStandard) {
+        return (size + 2) / 3 * 4;
+    }
+    return size / 3 * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+}
+
+/**
+ * @brief   Creates the table of the 6 bit values of all chars.
+ * @param   alphabet    the Base64 alphabet
+ * @return  The 6 bit value of each char, 0xff for chars not in the alphabet (including "=").
+ */
+constexpr std::array<unsigned char, 256> MakeBase64ToSextetTable(Base64Alphabet alphabet) {
+    std::array<unsigned char, 256> table{};
+    for (auto & sextet : table) {
+        sextet = 0xff;
+    }
+    auto chars = Base64Chars(alphabet);
+    for (unsigned char i = 0; i < 64; ++i) {
+        table[static_cast<unsigned char>(chars[i])] = i;
+    }
+    return table;
+}
+
+/**
+ * @brief   The 6 bit values of all chars for both Base64 alphabets (indexed by Base64Alphabet).
+ */
+inline constexpr std::array<std::array<unsigned char, 256>, 2> kBase64ToSextet = {
+        MakeBase64ToSextetTable(Base64Alphabet::kStandard),
+        MakeBase64ToSextetTable(Base64Alphabet::kUrl)};
+
+/**
+ * @brief   Writes the Base64 representation of a memory area (scalar version).
+ * @param   dst         destination, must hold Base64EncodedSize(size, alphabet) chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ * @param   alphabet    the Base64 alphabet
+ */
+inline void Base64EncodeScalar(char * dst, unsigned char const * src, std::uint64_t size, Base64Alphabet alphabet) {
+
+    auto chars = Base64Chars(alphabet);
+    std::uint64_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        std::uint32_t v = (std::uint32_t{src[i]} << 16u) | (std::uint32_t{src[i + 1]} << 8u) | src[i + 2];
+        dst[0] = chars[v >> 18u];
+        dst[1] = chars[(v >> 12u) & 0x3fu];
+        dst[2] = chars[(v >> 6u) & 0x3fu];
+        dst[3] = chars[v & 0x3fu];
+        dst += 4;
+    }
+
+    if (i < size) {
+        bool two = (i + 2 == size);
+        std::uint32_t v = (std::uint32_t{src[i]} << 16u) | (two ? std::uint32_t{src[i + 1]} << 8u : 0u);
+        dst[0] = chars[v >> 18u];
+        dst[1] = chars[(v >> 12u) & 0x3fu];
+        if (two) {
+            dst[2] = chars[(v >> 6u) & 0x3fu];
+        }
+        if (alphabet == Base64Alphabet::kStandard) {
+            if (!two) {
+                dst[2] = '=';
+            }
+            dst[3] = '=';
+        }
+    }
+}
+
+/**
+ * @brief   Decodes complete groups of 4 Base64 chars to memory (scalar version).
+ * @param   dst         destination, must hold at least size / 4 * 3 bytes
+ * @param   src         the Base64 chars, without padding
+ * @param   size        number of Base64 chars, a multiple of 4
+ * @param   alphabet    the Base64 alphabet
+ * @return  offset of the first invalid char in src or size if all are valid
+ */
+inline std::uint64_t Base64DecodeScalar(unsigned char * dst,
+                                        char const * src,
+                                        std::uint64_t size,
+                                        Base64Alphabet alphabet) {
+
+    auto const & table = kBase64ToSextet[static_cast<unsigned int>(alphabet)];
+    for (std::uint64_t i = 0; i + 4 <= size; i += 4) {
+        std::uint32_t v = 0;
+        for (std::uint64_t j = 0; j < 4; ++j) {
+            auto sextet = table[static_cast<unsigned char>(src[i + j])];
+            if (sextet & 0xc0u) {
+                return i + j;
+            }
+            v = (v << 6u) | sextet;
+        }
+        dst[0] = static_cast<unsigned char>(v >> 16u);
+        dst[1] = static_cast<unsigned char>(v >> 8u);
+        dst[2] = static_cast<unsigned char>(v);
+        dst += 3;
+    }
+    return size;
+}
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+
+/**
+ * @brief   Splits 12 bytes into 16 6-bit values, one per byte (SSSE3).
+ * @param   v           12 bytes to split in the lower 12 bytes
+ * @return  The 6 bit values in Base64 char order.
+ */
+HEADCODE_SPACE_MEM_TARGET("ssse3")
+inline __m128i BytesToSextetsSSSE3(__m128i v) {
+    v = _mm_shuffle_epi8(v, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    __m128i ac = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    __m128i bd = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(ac, bd);
+}
+
+/**
+ * @brief   Maps 16 6-bit values to their Base64 chars (SSSE3).
+ * @param   sextets     the 6 bit values
+ * @param   offsets     offsets to add to a value: index 0 for 26-51, 1-10 for 52-61, 11 for 62, 12 for 63, 13 for 0-25
+ * @return  The Base64 chars.
+ */
+HEADCODE_SPACE_MEM_TARGET("ssse3")
+inline __m128i SextetsToCharsSSSE3(__m128i sextets, __m128i offsets) {
+    __m128i index = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+    index = _mm_or_si128(index, _mm_and_si128(_mm_cmplt_epi8(sextets, _mm_set1_epi8(26)), _mm_set1_epi8(13)));
+    return _mm_add_epi8(sextets, _mm_shuffle_epi8(offsets, index));
+}
+
+/**
+ * @brief   Returns the offsets used by SextetsToCharsSSSE3.
+ * @param   alphabet    the Base64 alphabet
+ * @return  The offsets for each value range.
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline __m128i Base64OffsetsSSE2(Base64Alphabet alphabet) {
+    auto chars = Base64Chars(alphabet);
+    return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                         '0' - 52, '0' - 52, static_cast<char>(chars[62] - 62), static_cast<char>(chars[63] - 63), 'A',
+                         0, 0);
+}
+
+/**
+ * @brief   Writes the Base64 representation of a memory area (SSSE3 version, 12 bytes per iteration).
+ * @param   dst         destination, must hold Base64EncodedSize(size, alphabet) chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ * @param   alphabet    the Base64 alphabet
+ */
+HEADCODE_SPACE_MEM_TARGET("ssse3")
+inline void Base64EncodeSSSE3(char * dst, unsigned char const * src, std::uint64_t size, Base64Alphabet alphabet) {
+
+    __m128i const offsets = Base64OffsetsSSE2(alphabet);
+
+    std::uint64_t i = 0;
+    for (; i + 16 <= size; i += 12) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), SextetsToCharsSSSE3(BytesToSextetsSSSE3(v), offsets));
+        dst += 16;
+    }
+
+    Base64EncodeScalar(dst, src + i, size - i, alphabet);
+}
+
+/**
+ * @brief   Writes the Base64 representation of a memory area (AVX2 version, 24 bytes per iteration).
+ * @param   dst         destination, must hold Base64EncodedSize(size, alphabet) chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ * @param   alphabet    the Base64 alphabet
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline void Base64EncodeAVX2(char * dst, unsigned char const * src, std::uint64_t size, Base64Alphabet alphabet) {
+
+    __m256i const offsets = _mm256_broadcastsi128_si256(Base64OffsetsSSE2(alphabet));
+    __m256i const shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5,
+                                             4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+    std::uint64_t i = 0;
+    for (; i + 28 <= size; i += 24) {
+
+        __m128i first = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i + 12));
+        __m256i v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1), shuffle);
+
+        __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)),
+                                        _mm256_set1_epi32(0x04000040));
+        __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)),
+                                        _mm256_set1_epi32(0x01000010));
+        __m256i sextets = _mm256_or_si256(ac, bd);
+
+        __m256i index = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+        index = _mm256_or_si256(index, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets),
+                                                        _mm256_set1_epi8(13)));
+        __m256i chars = _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, index));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), chars);
+        dst += 32;
+    }
+
+    Base64EncodeSSSE3(dst, src + i, size - i, alphabet);
+}
+
+/**
+ * @brief   Writes the Base64 representation of a memory area (AVX-512 VBMI version, 48 bytes per iteration).
+ * @param   dst         destination, must hold Base64EncodedSize(size, alphabet) chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ * @param   alphabet    the Base64 alphabet
+ */
+HEADCODE_SPACE_MEM_TARGET("avx512f,avx512bw,avx512vbmi")
+inline void Base64EncodeAVX512VBMI(char * dst,
+                                   unsigned char const * src,
+                                   std::uint64_t size,
+                                   Base64Alphabet alphabet) {
+
+    // gather each 3 bytes into a 32 bit word as [1, 0, 2, 1], then pick the four 6 bit fields with multishift
+    __m512i const gather = _mm512_setr_epi32(0x01020001, 0x04050304, 0x07080607, 0x0a0b090a, 0x0d0e0c0d, 0x10110f10,
+                                             0x13141213, 0x16171516, 0x191a1819, 0x1c1d1b1c, 0x1f201e1f, 0x22232122,
+                                             0x25262425, 0x28292728, 0x2b2c2a2b, 0x2e2f2d2e);
+    __m512i const shifts = _mm512_set1_epi64(0x3036242a1016040a);
+    __m512i const table = _mm512_loadu_si512(Base64Chars(alphabet));
+
+    std::uint64_t i = 0;
+    for (; i + 48 <= size; i += 48) {
+        __m512i v = _mm512_maskz_loadu_epi8(0x0000ffffffffffffull, src + i);
+        __m512i words = _mm512_maskz_permutexvar_epi8(~__mmask64{0}, gather, v);
+        __m512i sextets = _mm512_maskz_multishift_epi64_epi8(~__mmask64{0}, shifts, words);
+        _mm512_storeu_si512(dst, _mm512_maskz_permutexvar_epi8(~__mmask64{0}, sextets, table));
+        dst += 64;
+    }
+
+    Base64EncodeAVX2(dst, src + i, size - i, alphabet);
+}
+
+/**
+ * @brief   Maps 16 Base64 chars to their 6 bit values (SSE2).
+ * Letters, digits and the two chars of the alphabet for 62 and 63 are tested by range compares.
+ * @param   chars       the Base64 chars
+ * @param   alphabet    the Base64 alphabet
+ * @param   valid       receives 0xff for each valid char
+ * @return  The 6 bit values (garbage for invalid chars).
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline __m128i CharsToSextetsSSE2(__m128i chars, Base64Alphabet alphabet, __m128i & valid) {
+
+    auto alphabet_chars = Base64Chars(alphabet);
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)));
+    __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('a' - 1)),
+                                  _mm_cmplt_epi8(chars, _mm_set1_epi8('z' + 1)));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    __m128i c62 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(alphabet_chars[62]));
+    __m128i c63 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(alphabet_chars[63]));
+    valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, c62)), c63);
+
+    __m128i offsets = _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')),
+                                   _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    offsets = _mm_or_si128(offsets, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    offsets = _mm_or_si128(offsets, _mm_and_si128(c62, _mm_set1_epi8(static_cast<char>(62 - alphabet_chars[62]))));
+    offsets = _mm_or_si128(offsets, _mm_and_si128(c63, _mm_set1_epi8(static_cast<char>(63 - alphabet_chars[63]))));
+    return _mm_add_epi8(chars, offsets);
+}
+
+/**
+ * @brief   Decodes complete groups of 4 Base64 chars to memory (SSSE3 version, 16 chars per iteration).
+ * @param   dst         destination, must hold at least size / 4 * 3 bytes
+ * @param   src         the Base64 chars, without padding
+ * @param   size        number of Base64 chars, a multiple of 4
+ * @param   alphabet    the Base64 alphabet
+ * @return  offset of the first invalid char in src or size if all are valid
+ */
+HEADCODE_SPACE_MEM_TARGET("ssse3")
+inline std::uint64_t Base64DecodeSSSE3(unsigned char * dst,
+                                       char const * src,
+                                       std::uint64_t size,
+                                       Base64Alphabet alphabet) {
+
+    // the 16 byte store spills 4 bytes, so stop while the following chars still overwrite them
+    std::uint64_t i = 0;
+    for (; i + 24 <= size; i += 16) {
+
+        __m128i valid;
+        __m128i sextets = CharsToSextetsSSE2(_mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i)), alphabet,
+                                             valid);
+        if (_mm_movemask_epi8(valid) != 0xffff) {
+            break;
+        }
+
+        __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+        __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        __m128i bytes = _mm_shuffle_epi8(words, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), bytes);
+        dst += 12;
+    }
+
+    return i + Base64DecodeScalar(dst, src + i, size - i, alphabet);
+}
+
+/**
+ * @brief   Decodes complete groups of 4 Base64 chars to memory (AVX2 version, 32 chars per iteration).
+ * @param   dst         destination, must hold at least size / 4 * 3 bytes
+ * @param   src         the Base64 chars, without padding
+ * @param   size        number of Base64 chars, a multiple of 4
+ * @param   alphabet    the Base64 alphabet
+ * @return  offset of the first invalid char in src or size if all are valid
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline std::uint64_t Base64DecodeAVX2(unsigned char * dst,
+                                      char const * src,
+                                      std::uint64_t size,
+                                      Base64Alphabet alphabet) {
+
+    auto alphabet_chars = Base64Chars(alphabet);
+    __m256i const c62_char = _mm256_set1_epi8(alphabet_chars[62]);
+    __m256i const c63_char = _mm256_set1_epi8(alphabet_chars[63]);
+    __m256i const c62_offset = _mm256_set1_epi8(static_cast<char>(62 - alphabet_chars[62]));
+    __m256i const c63_offset = _mm256_set1_epi8(static_cast<char>(63 - alphabet_chars[63]));
+    __m256i const shuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4,
+                                             10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    // the 32 byte store spills 8 bytes, so stop while the following chars still overwrite them
+    std::uint64_t i = 0;
+    for (; i + 44 <= size; i += 32) {
+
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+        __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('A' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), chars));
+        __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('a' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), chars));
+        __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+        __m256i c62 = _mm256_cmpeq_epi8(chars, c62_char);
+        __m256i c63 = _mm256_cmpeq_epi8(chars, c63_char);
+        __m256i valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, c62)),
+                                        c63);
+        if (static_cast<std::uint32_t>(_mm256_movemask_epi8(valid)) != 0xffffffffu) {
+            break;
+        }
+
+        __m256i offsets = _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')),
+                                          _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+        offsets = _mm256_or_si256(offsets, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+        offsets = _mm256_or_si256(offsets, _mm256_and_si256(c62, c62_offset));
+        offsets = _mm256_or_si256(offsets, _mm256_and_si256(c63, c63_offset));
+        __m256i sextets = _mm256_add_epi8(chars, offsets);
+
+        __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+        __m256i words = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        __m256i bytes = _mm256_shuffle_epi8(words, shuffle);
+        bytes = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), bytes);
+        dst += 24;
+    }
+
+    return i + Base64DecodeSSSE3(dst, src + i, size - i, alphabet);
+}
+
+/**
+ * @brief   Decodes complete groups of 4 Base64 chars to memory (AVX-512 VBMI version, 64 chars per iteration).
+ * Chars are mapped by a 128 entry table lookup; chars above 127 and chars not in the alphabet set the
+ * high bit.
+ * @param   dst         destination, must hold at least size / 4 * 3 bytes
+ * @param   src         the Base64 chars, without padding
+ * @param   size        number of Base64 chars, a multiple of 4
+ * @param   alphabet    the Base64 alphabet
+ * @return  offset of the first invalid char in src or size if all are valid
+ */
+HEADCODE_SPACE_MEM_TARGET("avx512f,avx512bw,avx512vbmi")
+inline std::uint64_t Base64DecodeAVX512VBMI(unsigned char * dst,
+                                            char const * src,
+                                            std::uint64_t size,
+                                            Base64Alphabet alphabet) {
+
+    // the 3 bytes of each 32 bit word, in memory order
+    static unsigned char const compact[64] = {2,  1,  0,  6,  5,  4,  10, 9,  8,  14, 13, 12, 18, 17, 16, 22,
+                                              21, 20, 26, 25, 24, 30, 29, 28, 34, 33, 32, 38, 37, 36, 42, 41,
+                                              40, 46, 45, 44, 50, 49, 48, 54, 53, 52, 58, 57, 56, 62, 61, 60};
+
+    auto const & table = kBase64ToSextet[static_cast<unsigned int>(alphabet)];
+    __m512i const table_low = _mm512_loadu_si512(table.data());
+    __m512i const table_high = _mm512_loadu_si512(table.data() + 64);
+    __m512i const bytes_order = _mm512_loadu_si512(compact);
+
+    std::uint64_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+
+        __m512i chars = _mm512_loadu_si512(src + i);
+        __m512i sextets = _mm512_permutex2var_epi8(table_low, chars, table_high);
+        if (_mm512_movepi8_mask(_mm512_or_si512(sextets, chars)) != 0) {
+            break;
+        }
+
+        __m512i pairs = _mm512_maddubs_epi16(sextets, _mm512_set1_epi32(0x01400140));
+        __m512i words = _mm512_madd_epi16(pairs, _mm512_set1_epi32(0x00011000));
+        _mm512_mask_storeu_epi8(dst, 0x0000ffffffffffffull,
+                                _mm512_maskz_permutexvar_epi8(~__mmask64{0}, bytes_order, words));
+        dst += 48;
+    }
+
+    return i + Base64DecodeAVX2(dst, src + i, size - i, alphabet);
+}
+
+#endif
+
+/**
+ * @brief   Writes the Base64 representation of a memory area with the kernel of the given level.
+ * SSE2 has no byte shuffle and uses the scalar version.
+ * @param   dst         destination, must hold Base64EncodedSize(size, alphabet) chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ * @param   alphabet    the Base64 alphabet
+ * @param   level       the SimdLevel to use (capped at GetSimdLevel())
+ */
+inline void Base64Encode(char * dst,
+                         char const * src,
+                         std::uint64_t size,
+                         Base64Alphabet alphabet,
+                         SimdLevel level = GetSimdLevel()) {
+
+    auto source = reinterpret_cast<unsigned char const *>(src);
+    if (level > GetSimdLevel()) {
+        level = GetSimdLevel();
+    }
+
+    switch (level) {
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+        case SimdLevel::kAVX512VBMI:
+            Base64EncodeAVX512VBMI(dst, source, size, alphabet);
+            return;
+        case SimdLevel::kAVX2:
+            Base64EncodeAVX2(dst, source, size, alphabet);
+            return;
+        case SimdLevel::kSSSE3:
+            Base64EncodeSSSE3(dst, source, size, alphabet);
+            return;
+#endif
+        default:
+            Base64EncodeScalar(dst, source, size, alphabet);
+    }
+}
+
+/**
+ * @brief   Decodes complete groups of 4 Base64 chars to memory with the kernel of the given level.
+ * Decoding stops at the first invalid char. SSE2 has no byte shuffle and uses the scalar version.
+ * @param   dst         destination, must hold at least size / 4 * 3 bytes
+ * @param   src         the Base64 chars, without padding
+ * @param   size        number of Base64 chars, a multiple of 4
+ * @param   alphabet    the Base64 alphabet
+ * @param   level       the SimdLevel to use (capped at GetSimdLevel())
+ * @return  offset of the first invalid char in src or size if all are valid
+ */
+inline std::uint64_t Base64Decode(unsigned char * dst,
+                                  char const * src,
+                                  std::uint64_t size,
+                                  Base64Alphabet alphabet,
+                                  SimdLevel level = GetSimdLevel()) {
+
+    if (level > GetSimdLevel()) {
+        level = GetSimdLevel();
+    }
+
+    switch (level) {
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+        case SimdLevel::kAVX512VBMI:
+            return Base64DecodeAVX512VBMI(dst, src, size, alphabet);
+        case SimdLevel::kAVX2:
+            return Base64DecodeAVX2(dst, src, size, alphabet);
+        case SimdLevel::kSSSE3:
+            return Base64DecodeSSSE3(dst, src, size, alphabet);
+#endif
+        default:
+            return Base64DecodeScalar(dst, src, size, alphabet);
+    }
+}
+
+/**
+ * @brief   Creates the table of the chars of a Base85 alphabet.
+ * @param   alphabet    the Base85 alphabet
+ * @return  The chars for the digits 0 to 84, followed by 0 up to 96 entries.
+ */
+constexpr std::array<char, 96> MakeBase85CharTable(Base85Alphabet alphabet) {
+    char const * z85 = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+    std::array<char, 96> table{};
+    for (std::size_t i = 0; i < 85; ++i) {
+        table[i] = alphabet == Base85Alphabet::kZ85 ? z85[i] : static_cast<char>('!' + i);
+    }
+    return table;
+}
+
+/**
+ * @brief   Creates the table of the digit values of all chars.
+ * @param   alphabet    the Base85 alphabet
+ * @return  The digit of each char, 0xff for chars not in the alphabet.
+ */
+constexpr std::array<unsigned char, 256> MakeBase85ToDigitTable(Base85Alphabet alphabet) {
+    std::array<unsigned char, 256> table{};
+    for (auto & digit : table) {
+        digit = 0xff;
+    }
+    auto chars = MakeBase85CharTable(alphabet);
+    for (unsigned char i = 0; i < 85; ++i) {
+        table[static_cast<unsigned char>(chars[i])] = i;
+    }
+    return table;
+}
+
+/**
+ * @brief   The chars of both Base85 alphabets (indexed by Base85Alphabet).
+ */
+inline constexpr std::array<std::array<char, 96>, 2> kBase85Chars = {MakeBase85CharTable(Base85Alphabet::kZ85),
+                                                                     MakeBase85CharTable(Base85Alphabet::kAscii85)};
+
+/**
+ * @brief   The digit values of all chars for both Base85 alphabets (indexed by Base85Alphabet).
+ */
+inline constexpr std::array<std::array<unsigned char, 256>, 2> kBase85ToDigit = {
+        MakeBase85ToDigitTable(Base85Alphabet::kZ85),
+        MakeBase85ToDigitTable(Base85Alphabet::kAscii85)};
+
+/**
+ * @brief   Returns the number of chars the Base85 representation of a memory area has.
+ * Each group of 4 bytes takes 5 chars, a last group of 1 to 3 bytes takes 1 char more than it has bytes.
+ * @param   size        size of the memory area
+ * @return  The number of Base85 chars.
+ */
+constexpr std::uint64_t Base85EncodedSize(std::uint64_t size) {
+    return size / 4 * 5 + (size % 4 == 0 ? 0 : size % 4 + 1);
+}
+
+/**
+ * @brief   Writes the 5 Base85 chars of a 32 bit value.
+ * @param   dst         destination, must hold 5 chars
+ * @param   value       the value (of 4 bytes in big endian order)
+ * @param   chars       the chars of the alphabet
+ */
+inline void Base85EncodeGroup(char * dst, std::uint32_t value, char const * chars) {
+    for (int i = 4; i >= 0; --i) {
+        dst[i] = chars[value % 85];
+        value /= 85;
+    }
+}
+
+/**
+ * @brief   Writes the Base85 representation of a memory area (scalar version).
+ * A last group of 1 to 3 bytes is padded with 0 and written without the chars only the padding needs.
+ * @param   dst         destination, must hold Base85EncodedSize(size) chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ * @param   alphabet    the Base85 alphabet
+ */
+inline void Base85EncodeScalar(char * dst, unsigned char const * src, std::uint64_t size, Base85Alphabet alphabet) {
+
+    auto chars = kBase85Chars[static_cast<unsigned int>(alphabet)].data();
+    std::uint64_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        auto value = (std::uint32_t{src[i]} << 24u) | (std::uint32_t{src[i + 1]} << 16u) |
+                     (std::uint32_t{src[i + 2]} << 8u) | src[i + 3];
+        Base85EncodeGroup(dst, value, chars);
+        dst += 5;
+    }
+
+    if (i < size) {
+        std::uint32_t value = 0;
+        for (auto j = i; j < size; ++j) {
+            value |= std::uint32_t{src[j]} << (24u - 8u * (j - i));
+        }
+        char group[5];
+        Base85EncodeGroup(group, value, chars);
+        for (std::uint64_t j = 0; j <= size - i; ++j) {
+            dst[j] = group[j];
+        }
+    }
+}
+
+/**
+ * @brief   Decodes complete groups of 5 Base85 chars to memory (scalar version).
+ * @param   dst         destination, must hold at least size / 5 * 4 bytes
+ * @param   src         the Base85 chars
+ * @param   size        number of Base85 chars, a multiple of 5
+ * @param   alphabet    the Base85 alphabet
+ * @return  offset of the first invalid char in src (the start of a group exceeding 32 bits) or size if all are valid
+ */
+inline std::uint64_t Base85DecodeScalar(unsigned char * dst,
+                                        char const * src,
+                                        std::uint64_t size,
+                                        Base85Alphabet alphabet) {
+
+    auto const & table = kBase85ToDigit[static_cast<unsigned int>(alphabet)];
+    for (std::uint64_t i = 0; i + 5 <= size; i += 5) {
+        std::uint64_t value = 0;
+        for (std::uint64_t j = 0; j < 5; ++j) {
+            auto digit = table[static_cast<unsigned char>(src[i + j])];
+            if (digit == 0xff) {
+                return i + j;
+            }
+            value = value * 85 + digit;
+        }
+        if (value > 0xffffffffu) {
+            return i;
+        }
+        dst[0] = static_cast<unsigned char>(value >> 24u);
+        dst[1] = static_cast<unsigned char>(value >> 16u);
+        dst[2] = static_cast<unsigned char>(value >> 8u);
+        dst[3] = static_cast<unsigned char>(value);
+        dst += 4;
+    }
+    return size;
+}
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+
+/**
+ * @brief   A table of 96 bytes split into 6 vectors for byte shuffle lookups (AVX2).
+ */
+struct Table96AVX2 {
+    __m256i chunks[6];      //!< @brief The table entries 0-15, 16-31, ... in both lanes.
+};
+
+/**
+ * @brief   Loads a table of 96 bytes for LookupTable96AVX2.
+ * @param   table       the table, 96 entries
+ * @return  The table in vectors.
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline Table96AVX2 LoadTable96AVX2(unsigned char const * table) {
+    Table96AVX2 result;
+    for (int i = 0; i < 6; ++i) {
+        result.chunks[i] =
+                _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(table + i * 16)));
+    }
+    return result;
+}
+
+/**
+ * @brief   Looks up bytes in a table of 96 entries (AVX2).
+ * Each chunk is shuffled with index - 16 * chunk saturated into 0x70-0x7f for indices within the chunk,
+ * all others get the high bit set and yield 0.
+ * @param   index       the table indices, anything at or above 96 yields fallback
+ * @param   table       the table
+ * @param   fallback    value for indices outside the table
+ * @return  The table entries.
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline __m256i LookupTable96AVX2(__m256i index, Table96AVX2 const & table, __m256i fallback) {
+    __m256i const bias = _mm256_set1_epi8(0x70);
+    __m256i result = _mm256_shuffle_epi8(table.chunks[0], _mm256_adds_epu8(index, bias));
+    for (int i = 1; i < 6; ++i) {
+        __m256i chunk_start = _mm256_set1_epi8(static_cast<char>(16 * i));
+        __m256i chunk_index = _mm256_adds_epu8(_mm256_sub_epi8(index, chunk_start), bias);
+        result = _mm256_or_si256(result, _mm256_shuffle_epi8(table.chunks[i], chunk_index));
+    }
+    __m256i outside = _mm256_cmpeq_epi8(_mm256_max_epu8(index, _mm256_set1_epi8(96)), index);
+    return _mm256_blendv_epi8(result, fallback, outside);
+}
+
+/**
+ * @brief   Maps Base85 digits to chars (AVX2).
+ * @param   digits      the digits (0-84)
+ * @param   table       the chars of a Z85 alphabet
+ * @param   alphabet    the Base85 alphabet, Ascii85 chars are just '!' + digit
+ * @return  The chars.
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline __m256i Base85DigitsToCharsAVX2(__m256i digits, Table96AVX2 const & table, Base85Alphabet alphabet) {
+    if (alphabet == Base85Alphabet::kAscii85) {
+        return _mm256_add_epi8(digits, _mm256_set1_epi8('!'));
+    }
+    return LookupTable96AVX2(digits, table, _mm256_setzero_si256());
+}
+
+/**
+ * @brief   Maps Base85 chars to digits (AVX2).
+ * @param   chars       the chars
+ * @param   table       the digits of the chars 32 to 127 of a Z85 alphabet
+ * @param   alphabet    the Base85 alphabet, Ascii85 digits are just char - '!'
+ * @return  The digits, 0xff for invalid chars.
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline __m256i Base85CharsToDigitsAVX2(__m256i chars, Table96AVX2 const & table, Base85Alphabet alphabet) {
+    __m256i const invalid = _mm256_set1_epi8(static_cast<char>(0xff));
+    if (alphabet == Base85Alphabet::kAscii85) {
+        __m256i digits = _mm256_sub_epi8(chars, _mm256_set1_epi8('!'));
+        __m256i valid = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(84)), digits);
+        return _mm256_blendv_epi8(invalid, digits, valid);
+    }
+    return LookupTable96AVX2(_mm256_sub_epi8(chars, _mm256_set1_epi8(32)), table, invalid);
+}
+
+/**
+ * @brief   Divides unsigned 32 bit values by 85 (AVX2).
+ * Multiplies by 0xc0c0c0c1 and shifts the 64 bit product right by 38, which is exact for all 32 bit values.
+ * @param   value       the values
+ * @return  The quotients.
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline __m256i DivideBy85AVX2(__m256i value) {
+    __m256i const magic = _mm256_set1_epi32(static_cast<int>(0xc0c0c0c1u));
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(value, magic), 38);
+    __m256i odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(value, 32), magic), 38);
+    return _mm256_or_si256(even, _mm256_slli_epi64(odd, 32));
+}
+
+/**
+ * @brief   Writes the Base85 representation of a memory area (AVX2 version, 32 bytes per iteration).
+ * @param   dst         destination, must hold Base85EncodedSize(size) chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ * @param   alphabet    the Base85 alphabet
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline void Base85EncodeAVX2(char * dst, unsigned char const * src, std::uint64_t size, Base85Alphabet alphabet) {
+
+    auto const table = LoadTable96AVX2(
+            reinterpret_cast<unsigned char const *>(kBase85Chars[static_cast<unsigned int>(alphabet)].data()));
+    __m256i const swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5,
+                                          4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i const base = _mm256_set1_epi32(85);
+
+    // place the first 4 chars (packed in a 32 bit word) and the fifth char of 4 groups into 20 chars
+    __m256i const first_low = _mm256_setr_epi8(0, 1, 2, 3, -1, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 0, 1, 2, 3, -1,
+                                               4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12);
+    __m256i const fifth_low = _mm256_setr_epi8(-1, -1, -1, -1, 0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1, -1, -1,
+                                               -1, -1, 0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1);
+    __m256i const first_high = _mm256_setr_epi8(13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 13,
+                                                14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    __m256i const fifth_high = _mm256_setr_epi8(-1, -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+
+    // the 4 trailing chars of a block are stored with 16 bytes, so stop while the following chars overwrite them
+    std::uint64_t i = 0;
+    for (; i + 44 <= size; i += 32) {
+
+        __m256i value = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i)), swap);
+        __m256i digits[5];
+        for (int j = 4; j > 0; --j) {
+            __m256i quotient = DivideBy85AVX2(value);
+            digits[j] = _mm256_sub_epi32(value, _mm256_mullo_epi32(quotient, base));
+            value = quotient;
+        }
+        digits[0] = value;
+
+        __m256i first_digits = _mm256_or_si256(digits[0], _mm256_slli_epi32(digits[1], 8));
+        __m256i last_digits = _mm256_or_si256(_mm256_slli_epi32(digits[2], 16), _mm256_slli_epi32(digits[3], 24));
+        __m256i first = _mm256_or_si256(first_digits, last_digits);
+        first = Base85DigitsToCharsAVX2(first, table, alphabet);
+        __m256i fifth = Base85DigitsToCharsAVX2(digits[4], table, alphabet);
+
+        __m256i low = _mm256_or_si256(_mm256_shuffle_epi8(first, first_low), _mm256_shuffle_epi8(fifth, fifth_low));
+        __m256i high = _mm256_or_si256(_mm256_shuffle_epi8(first, first_high), _mm256_shuffle_epi8(fifth, fifth_high));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm256_castsi256_si128(low));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 16), _mm256_castsi256_si128(high));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 20), _mm256_extracti128_si256(low, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 36), _mm256_extracti128_si256(high, 1));
+        dst += 40;
+    }
+
+    Base85EncodeScalar(dst, src + i, size - i, alphabet);
+}
+
+/**
+ * @brief   Decodes complete groups of 5 Base85 chars to memory (AVX2 version, 40 chars per iteration).
+ * @param   dst         destination, must hold at least size / 5 * 4 bytes
+ * @param   src         the Base85 chars
+ * @param   size        number of Base85 chars, a multiple of 5
+ * @param   alphabet    the Base85 alphabet
+ * @return  offset of the first invalid char in src (the start of a group exceeding 32 bits) or size if all are valid
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline std::uint64_t Base85DecodeAVX2(unsigned char * dst,
+                                      char const * src,
+                                      std::uint64_t size,
+                                      Base85Alphabet alphabet) {
+
+    // digit tables for the chars 32 to 127
+    auto const table = LoadTable96AVX2(kBase85ToDigit[static_cast<unsigned int>(alphabet)].data() + 32);
+    __m256i const base = _mm256_set1_epi32(85);
+    __m256i const max_first_digits = _mm256_set1_epi32(0xffffffffu / 85);
+    __m256i const swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5,
+                                          4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    // digit j of the 4 groups in 20 chars: chars 0-15 come from the first load, chars 16-19 from the second
+    // load starting 4 chars later
+    static constexpr auto gather = [](bool second) {
+        std::array<std::array<char, 32>, 5> indices{};
+        for (int j = 0; j < 5; ++j) {
+            for (int k = 0; k < 32; ++k) {
+                int group = (k % 16) / 4;
+                int position = group * 5 + j;
+                bool from_second = position > 15;
+                indices[j][k] = ((k % 4 == 0) && (from_second == second))
+                                        ? static_cast<char>(second ? position - 4 : position)
+                                        : static_cast<char>(0x80);
+            }
+        }
+        return indices;
+    };
+    static constexpr auto gather_first = gather(false);
+    static constexpr auto gather_second = gather(true);
+    __m256i index_first[5];
+    __m256i index_second[5];
+    for (int j = 0; j < 5; ++j) {
+        index_first[j] = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(gather_first[j].data()));
+        index_second[j] = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(gather_second[j].data()));
+    }
+
+    std::uint64_t i = 0;
+    for (; i + 40 <= size; i += 40) {
+
+        auto chars = src + i;
+        __m256i first = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(chars))),
+                _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars + 20)), 1);
+        __m256i second = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(chars + 4))),
+                _mm_loadu_si128(reinterpret_cast<__m128i const *>(chars + 24)), 1);
+        first = Base85CharsToDigitsAVX2(first, table, alphabet);
+        second = Base85CharsToDigitsAVX2(second, table, alphabet);
+        if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) != 0) {
+            break;
+        }
+
+        __m256i digits[5];
+        for (int j = 0; j < 5; ++j) {
+            digits[j] = _mm256_or_si256(_mm256_shuffle_epi8(first, index_first[j]),
+                                        _mm256_shuffle_epi8(second, index_second[j]));
+        }
+
+        __m256i value = digits[0];
+        for (int j = 1; j < 4; ++j) {
+            value = _mm256_add_epi32(_mm256_mullo_epi32(value, base), digits[j]);
+        }
+        __m256i overflow = _mm256_or_si256(
+                _mm256_cmpgt_epi32(value, max_first_digits),
+                _mm256_andnot_si256(_mm256_cmpeq_epi32(digits[4], _mm256_setzero_si256()),
+                                    _mm256_cmpeq_epi32(value, max_first_digits)));
+        if (!_mm256_testz_si256(overflow, overflow)) {
+            break;
+        }
+
+        value = _mm256_add_epi32(_mm256_mullo_epi32(value, base), digits[4]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_shuffle_epi8(value, swap));
+        dst += 32;
+    }
+
+    return i + Base85DecodeScalar(dst, src + i, size - i, alphabet);
+}
+
+#endif
+
+/**
+ * @brief   Writes the Base85 representation of a memory area with the kernel of the given level.
+ * Levels below AVX2 lack 32 bit multiplies and use the scalar version, AVX-512 uses AVX2.
+ * @param   dst         destination, must hold Base85EncodedSize(size) chars
+ * @param   src         the memory to convert
+ * @param   size        size of the memory to convert
+ * @param   alphabet    the Base85 alphabet
+ * @param   level       the SimdLevel to use (capped at GetSimdLevel())
+ */
+inline void Base85Encode(char * dst,
+                         char const * src,
+                         std::uint64_t size,
+                         Base85Alphabet alphabet,
+                         SimdLevel level = GetSimdLevel()) {
+
+    auto source = reinterpret_cast<unsigned char const *>(src);
+    if (level > GetSimdLevel()) {
+        level = GetSimdLevel();
+    }
+
+    switch (level) {
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+        case SimdLevel::kAVX512VBMI:
+        case SimdLevel::kAVX2:
+            Base85EncodeAVX2(dst, source, size, alphabet);
+            return;
+#endif
+        default:
+            Base85EncodeScalar(dst, source, size, alphabet);
+    }
+}
+
+/**
+ * @brief   Decodes complete groups of 5 Base85 chars to memory with the kernel of the given level.
+ * Decoding stops at the first invalid char or group exceeding 32 bits. Levels below AVX2 use the scalar
+ * version, AVX-512 uses AVX2.
+ * @param   dst         destination, must hold at least size / 5 * 4 bytes
+ * @param   src         the Base85 chars
+ * @param   size        number of Base85 chars, a multiple of 5
+ * @param   alphabet    the Base85 alphabet
+ * @param   level       the SimdLevel to use (capped at GetSimdLevel())
+ * @return  offset of the first invalid char in src (the start of a group exceeding 32 bits) or size if all are valid
+ */
+inline std::uint64_t Base85Decode(unsigned char * dst,
+                                  char const * src,
+                                  std::uint64_t size,
+                                  Base85Alphabet alphabet,
+                                  SimdLevel level = GetSimdLevel()) {
+
+    if (level > GetSimdLevel()) {
+        level = GetSimdLevel();
+    }
+
+    switch (level) {
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+        case SimdLevel::kAVX512VBMI:
+        case SimdLevel::kAVX2:
+            return Base85DecodeAVX2(dst, src, size, alphabet);
+#endif
+        default:
+            return Base85DecodeScalar(dst, src, size, alphabet);
+    }
+}
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+
+/**
+ * @brief   Copies memory with non-temporal stores which bypass the cache (SSE2 version).
+ * The copy is finished with a store fence, so other threads see it once they synchronize with this one.
+ * @param   dst         destination, must hold at least size bytes
+ * @param   src         the memory to copy
+ * @param   size        size of the memory to copy
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline void CopyNonTemporalSSE2(char * dst, char const * src, std::uint64_t size) {
+
+    // streaming stores need 16 byte aligned destinations
+    auto head = std::min<std::uint64_t>((16 - reinterpret_cast<std::uintptr_t>(dst) % 16) % 16, size);
+    std::memcpy(dst, src, head);
+
+    std::uint64_t i = head;
+    for (; i + 16 <= size; i += 16) {
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i),
+                         _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i)));
+    }
+    std::memcpy(dst + i, src + i, size - i);
+
+    _mm_sfence();
+}
+
+#endif
+
+/**
+ * @brief   Copies memory with non-temporal stores if the given level has them, else with memcpy.
+ * @param   dst         destination, must hold at least size bytes
+ * @param   src         the memory to copy
+ * @param   size        size of the memory to copy
+ * @param   level       the SimdLevel to use (capped at GetSimdLevel())
+ */
+inline void CopyNonTemporal(char * dst, char const * src, std::uint64_t size, SimdLevel level = GetSimdLevel()) {
+
+    if (level > GetSimdLevel()) {
+        level = GetSimdLevel();
+    }
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+    if (level >= SimdLevel::kSSE2) {
+        CopyNonTemporalSSE2(dst, src, size);
+        return;
+    }
+#endif
+
+    std::memcpy(dst, src, size);
+}
+
+/**
+ * @brief   Finds the first byte in which two memory areas differ (scalar version).
+ * The areas may overlap.
+ * @param   a           the first memory area
+ * @param   b           the second memory area
+ * @param   size        size of both memory areas
+ * @return  the offset of the first differing byte, size if the areas are equal
+ */
+inline std::uint64_t FindMismatchScalar(unsigned char const * a, unsigned char const * b, std::uint64_t size) {
+    std::uint64_t i = 0;
+    while ((i < size) && (a[i] == b[i])) {
+        ++i;
+    }
+    return i;
+}
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+
+/**
+ * @brief   Compares 16 bytes of two memory areas (SSE2).
+ * @param   a           the first memory area
+ * @param   b           the second memory area
+ * @return  0xff for each equal byte
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline __m128i EqualBytesSSE2(unsigned char const * a, unsigned char const * b) {
+    return _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(a)),
+                          _mm_loadu_si128(reinterpret_cast<__m128i const *>(b)));
+}
+
+/**
+ * @brief   Finds the first byte in which two memory areas differ (SSE2 version, 64 bytes per iteration).
+ * @param   a           the first memory area
+ * @param   b           the second memory area
+ * @param   size        size of both memory areas
+ * @return  the offset of the first differing byte, size if the areas are equal
+ */
+HEADCODE_SPACE_MEM_TARGET("sse2")
+inline std::uint64_t FindMismatchSSE2(unsigned char const * a, unsigned char const * b, std::uint64_t size) {
+
+    std::uint64_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m128i all = _mm_and_si128(_mm_and_si128(EqualBytesSSE2(a + i, b + i), EqualBytesSSE2(a + i + 16, b + i + 16)),
+                                    _mm_and_si128(EqualBytesSSE2(a + i + 32, b + i + 32),
+                                                  EqualBytesSSE2(a + i + 48, b + i + 48)));
+        if (_mm_movemask_epi8(all) != 0xffff) {
+            break;
+        }
+    }
+    for (; i + 16 <= size; i += 16) {
+        auto mask = static_cast<unsigned int>(_mm_movemask_epi8(EqualBytesSSE2(a + i, b + i)));
+        if (mask != 0xffff) {
+            return i + static_cast<std::uint64_t>(__builtin_ctz(~mask));
+        }
+    }
+
+    return i + FindMismatchScalar(a + i, b + i, size - i);
+}
+
+/**
+ * @brief   Compares 32 bytes of two memory areas (AVX2).
+ * @param   a           the first memory area
+ * @param   b           the second memory area
+ * @return  0xff for each equal byte
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline __m256i EqualBytesAVX2(unsigned char const * a, unsigned char const * b) {
+    return _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(a)),
+                             _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b)));
+}
+
+/**
+ * @brief   Finds the first byte in which two memory areas differ (AVX2 version, 128 bytes per iteration).
+ * @param   a           the first memory area
+ * @param   b           the second memory area
+ * @param   size        size of both memory areas
+ * @return  the offset of the first differing byte, size if the areas are equal
+ */
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline std::uint64_t FindMismatchAVX2(unsigned char const * a, unsigned char const * b, std::uint64_t size) {
+
+    std::uint64_t i = 0;
+    for (; i + 128 <= size; i += 128) {
+        __m256i all = _mm256_and_si256(
+                _mm256_and_si256(EqualBytesAVX2(a + i, b + i), EqualBytesAVX2(a + i + 32, b + i + 32)),
+                _mm256_and_si256(EqualBytesAVX2(a + i + 64, b + i + 64), EqualBytesAVX2(a + i + 96, b + i + 96)));
+        if (static_cast<unsigned int>(_mm256_movemask_epi8(all)) != 0xffffffffu) {
+            break;
+        }
+    }
+    for (; i + 32 <= size; i += 32) {
+        auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(EqualBytesAVX2(a + i, b + i)));
+        if (mask != 0xffffffffu) {
+            return i + static_cast<std::uint64_t>(__builtin_ctz(~mask));
+        }
+    }
+
+    return i + FindMismatchSSE2(a + i, b + i, size - i);
+}
+
+/**
+ * @brief   Compares 64 bytes of two memory areas (AVX-512 BW).
+ * @param   a           the first memory area
+ * @param   b           the second memory area
+ * @return  a set bit for each differing byte
+ */
+HEADCODE_SPACE_MEM_TARGET("avx512f,avx512bw")
+inline __mmask64 DifferentBytesAVX512(unsigned char const * a, unsigned char const * b) {
+    return _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a), _mm512_loadu_si512(b));
+}
+
+/**
+ * @brief   Finds the first byte in which two memory areas differ (AVX-512 version, 256 bytes per iteration).
+ * @param   a           the first memory area
+ * @param   b           the second memory area
+ * @param   size        size of both memory areas
+ * @return  the offset of the first differing byte, size if the areas are equal
+ */
+HEADCODE_SPACE_MEM_TARGET("avx512f,avx512bw")
+inline std::uint64_t FindMismatchAVX512(unsigned char const * a, unsigned char const * b, std::uint64_t size) {
+
+    std::uint64_t i = 0;
+    for (; i + 256 <= size; i += 256) {
+        if ((DifferentBytesAVX512(a + i, b + i) | DifferentBytesAVX512(a + i + 64, b + i + 64) |
+             DifferentBytesAVX512(a + i + 128, b + i + 128) | DifferentBytesAVX512(a + i + 192, b + i + 192)) != 0) {
+            break;
+        }
+    }
+    for (; i + 64 <= size; i += 64) {
+        auto mask = DifferentBytesAVX512(a + i, b + i);
+        if (mask != 0) {
+            return i + static_cast<std::uint64_t>(__builtin_ctzll(mask));
+        }
+    }
+
+    return i + FindMismatchAVX2(a + i, b + i, size - i);
+}
+
+#endif
+
+/**
+ * @brief   Finds the first byte in which two memory areas differ with the kernel of the given level.
+ * The areas may overlap: comparing a memory area with itself shifted by n bytes finds the end of a
+ * run of repeated n byte patterns.
+ * @param   a           the first memory area
+ * @param   b           the second memory area
+ * @param   size        size of both memory areas
+ * @param   level       the SimdLevel to use (capped at GetSimdLevel())
+ * @return  the offset of the first differing byte, size if the areas are equal
+ */
+inline std::uint64_t FindMismatch(char const * a,
+                                  char const * b,
+                                  std::uint64_t size,
+                                  SimdLevel level = GetSimdLevel()) {
+
+    auto first = reinterpret_cast<unsigned char const *>(a);
+    auto second = reinterpret_cast<unsigned char const *>(b);
+    if (level > GetSimdLevel()) {
+        level = GetSimdLevel();
+    }
+
+    switch (level) {
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+        case SimdLevel::kAVX512VBMI:
+            return FindMismatchAVX512(first, second, size);
+        case SimdLevel::kAVX2:
+            return FindMismatchAVX2(first, second, size);
+        case SimdLevel::kSSSE3:
+        case SimdLevel::kSSE2:
+            return FindMismatchSSE2(first, second, size);
+#endif
+        default:
+            return FindMismatchScalar(first, second, size);
+    }
+}
+
+/**
+ * @brief   Reverses the bytes of a value.
+ * @param   value       the value
+ * @return  the value with reversed byte order
+ */
+inline std::uint8_t ByteSwap(std::uint8_t value) {
+    return value;
+}
+
+/**
+ * @brief   Reverses the bytes of a value.
+ * @param   value       the value
+ * @return  the value with reversed byte order
+ */
+inline std::uint16_t ByteSwap(std::uint16_t value) {
+    return __builtin_bswap16(value);
+}
+
+/**
+ * @brief   Reverses the bytes of a value.
+ * @param   value       the value
+ * @return  the value with reversed byte order
+ */
+inline std::uint32_t ByteSwap(std::uint32_t value) {
+    return __builtin_bswap32(value);
+}
+
+/**
+ * @brief   Reverses the bytes of a value.
+ * @param   value       the value
+ * @return  the value with reversed byte order
+ */
+inline std::uint64_t ByteSwap(std::uint64_t value) {
+    return __builtin_bswap64(value);
+}
+
+/**
+ * @brief   Makes the byte shuffle reversing the bytes of each item.
+ * The shuffle works on 16 byte lanes, as pshufb does, and is repeated for the 4 lanes of an AVX-512 vector.
+ * @tparam  Width       size of the items (2, 4 or 8)
+ * @return  The shuffle.
+ */
+template <std::uint64_t Width>
+constexpr std::array<char, 64> MakeByteSwapShuffle() {
+    std::array<char, 64> shuffle{};
+    for (std::uint64_t i = 0; i < shuffle.size(); ++i) {
+        shuffle[i] = static_cast<char>((i % 16) / Width * Width + Width - 1 - i % Width);
+    }
+    return shuffle;
+}
+
+/**
+ * @brief   The byte shuffle reversing the bytes of each item.
+ * @tparam  Width       size of the items (2, 4 or 8)
+ */
+template <std::uint64_t Width>
+inline constexpr std::array<char, 64> kByteSwapShuffle = MakeByteSwapShuffle<Width>();
+
+/**
+ * @brief   Reverses the bytes of each item of an array (scalar version).
+ * @tparam  Width       size of the items (2, 4 or 8)
+ * @param   dst         destination, must hold count items: either src or not overlapping it
+ * @param   src         the items
+ * @param   count       number of items
+ */
+template <std::uint64_t Width>
+inline void ByteSwapScalar(unsigned char * dst, unsigned char const * src, std::uint64_t count) {
+
+    using Item = std::conditional_t<Width == 2,
+                                    std::uint16_t,
+                                    std::conditional_t<Width == 4, std::uint32_t, std::uint64_t>>;
+    static_assert(sizeof(Item) == Width, "Items must be of 2, 4 or 8 bytes.");
+
+    // std::copy_n is inlined where std::memcpy is not (-fno-builtin)
+    for (std::uint64_t i = 0; i < count; ++i) {
+        Item item;
+        std::copy_n(src + i * Width, Width, reinterpret_cast<unsigned char *>(&item));
+        item = ByteSwap(item);
+        std::copy_n(reinterpret_cast<unsigned char const *>(&item), Width, dst + i * Width);
+    }
+}
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+
+/**
+ * @brief   Reverses the bytes of each item of an array (SSSE3 version, 16 bytes per iteration).
+ * @tparam  Width       size of the items (2, 4 or 8)
+ * @param   dst         destination, must hold count items: either src or not overlapping it
+ * @param   src         the items
+ * @param   count       number of items
+ */
+template <std::uint64_t Width>
+HEADCODE_SPACE_MEM_TARGET("ssse3")
+inline void ByteSwapSSSE3(unsigned char * dst, unsigned char const * src, std::uint64_t count) {
+
+    __m128i const shuffle = _mm_loadu_si128(reinterpret_cast<__m128i const *>(kByteSwapShuffle<Width>.data()));
+
+    auto size = count * Width;
+    std::uint64_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_shuffle_epi8(v, shuffle));
+    }
+
+    ByteSwapScalar<Width>(dst + i, src + i, (size - i) / Width);
+}
+
+/**
+ * @brief   Reverses the bytes of each item of an array (AVX2 version, 64 bytes per iteration).
+ * vpshufb shuffles within 128 bit lanes, which is fine as no item crosses a lane.
+ * @tparam  Width       size of the items (2, 4 or 8)
+ * @param   dst         destination, must hold count items: either src or not overlapping it
+ * @param   src         the items
+ * @param   count       number of items
+ */
+template <std::uint64_t Width>
+HEADCODE_SPACE_MEM_TARGET("avx2")
+inline void ByteSwapAVX2(unsigned char * dst, unsigned char const * src, std::uint64_t count) {
+
+    __m256i const shuffle = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(kByteSwapShuffle<Width>.data()));
+
+    auto size = count * Width;
+    std::uint64_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+        __m256i second = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_shuffle_epi8(first, shuffle));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 32), _mm256_shuffle_epi8(second, shuffle));
+    }
+
+    ByteSwapSSSE3<Width>(dst + i, src + i, (size - i) / Width);
+}
+
+/**
+ * @brief   Reverses the bytes of each item of an array (AVX-512 BW version, 128 bytes per iteration).
+ * @tparam  Width       size of the items (2, 4 or 8)
+ * @param   dst         destination, must hold count items: either src or not overlapping it
+ * @param   src         the items
+ * @param   count       number of items
+ */
+template <std::uint64_t Width>
+HEADCODE_SPACE_MEM_TARGET("avx512f,avx512bw")
+inline void ByteSwapAVX512(unsigned char * dst, unsigned char const * src, std::uint64_t count) {
+
+    __m512i const shuffle = _mm512_loadu_si512(kByteSwapShuffle<Width>.data());
+
+    auto size = count * Width;
+    std::uint64_t i = 0;
+    for (; i + 128 <= size; i += 128) {
+        __m512i first = _mm512_loadu_si512(src + i);
+        __m512i second = _mm512_loadu_si512(src + i + 64);
+        _mm512_storeu_si512(dst + i, _mm512_shuffle_epi8(first, shuffle));
+        _mm512_storeu_si512(dst + i + 64, _mm512_shuffle_epi8(second, shuffle));
+    }
+
+    ByteSwapAVX2<Width>(dst + i, src + i, (size - i) / Width);
+}
+
+#endif
+
+/**
+ * @brief   Reverses the bytes of each item of an array with the kernel of the given level.
+ * This converts arrays of 16, 32 or 64 bit numbers (including float and double) between little and big endian,
+ * either in place (dst == src) or while copying them.
+ * @tparam  Width       size of the items (2, 4 or 8)
+ * @param   dst         destination, must hold count items: either src or not overlapping it
+ * @param   src         the items
+ * @param   count       number of items
+ * @param   level       the SimdLevel to use (capped at GetSimdLevel())
+ */
+template <std::uint64_t Width>
+inline void ByteSwap(char * dst, char const * src, std::uint64_t count, SimdLevel level = GetSimdLevel()) {
+
+    static_assert((Width == 2) || (Width == 4) || (Width == 8), "Items must be of 2, 4 or 8 bytes.");
+
+    auto destination = reinterpret_cast<unsigned char *>(dst);
+    auto source = reinterpret_cast<unsigned char const *>(src);
+    if (level > GetSimdLevel()) {
+        level = GetSimdLevel();
+    }
+
+    switch (level) {
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+        case SimdLevel::kAVX512VBMI:
+            ByteSwapAVX512<Width>(destination, source, count);
+            return;
+        case SimdLevel::kAVX2:
+            ByteSwapAVX2<Width>(destination, source, count);
+            return;
+        case SimdLevel::kSSSE3:
+            ByteSwapSSSE3<Width>(destination, source, count);
+            return;
+#endif
+        default:
+            ByteSwapScalar<Width>(destination, source, count);
+    }
+}
+
+}
+
+}
+
+
+inline std::uint64_t headcode::mem::DetectLastLevelCacheSize() {
+
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    for (auto name : {_SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE}) {
+        auto size = sysconf(name);
+        if (size > 0) {
+            return static_cast<std::uint64_t>(size);
+        }
+    }
+#endif
+
+    return 8 * 1024 * 1024;
+}
+
+
+inline headcode::mem::SimdLevel headcode::mem::DetectSimdLevel() {
+
+#ifdef HEADCODE_SPACE_MEM_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vbmi")) {
+        return SimdLevel::kAVX512VBMI;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::kAVX2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return SimdLevel::kSSSE3;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SimdLevel::kSSE2;
+    }
+#endif
+
+    return SimdLevel::kScalar;
+}
+
+
+inline std::uint64_t headcode::mem::GetLastLevelCacheSize() {
+    static std::uint64_t const size = DetectLastLevelCacheSize();
+    return size;
+}
+
+
+inline headcode::mem::SimdLevel headcode::mem::GetSimdLevel() {
+    static SimdLevel const level = DetectSimdLevel();
+    return level;
+}
+
+
+inline char const * headcode::mem::SimdLevelToString(SimdLevel level) {
+
+    switch (level) {
+        case SimdLevel::kSSE2:
+            return "SSE2";
+        case SimdLevel::kSSSE3:
+            return "SSSE3";
+        case SimdLevel::kAVX2:
+            return "AVX2";
+        case SimdLevel::kAVX512VBMI:
+            return "AVX512VBMI";
+        default:
+            return "scalar";
+    }
+}
+
+
+#endif
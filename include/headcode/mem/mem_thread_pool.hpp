@@ -0,0 +1,196 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#ifndef HEADCODE_SPACE_MEM_MEM_THREAD_POOL_HPP
+#define HEADCODE_SPACE_MEM_MEM_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * @brief   The headcode mem namespace
+ */
+namespace headcode::mem {
+
+/**
+ * @brief   Size of the chunks (in input bytes) the parallel mem functions hand to a single thread.
+ */
+inline constexpr std::uint64_t kParallelChunkSize = 256 * 1024;
+
+/**
+ * @brief   Inputs smaller than this (in bytes) are processed by the parallel mem functions on the calling thread.
+ */
+inline constexpr std::uint64_t kParallelMinSize = 1024 * 1024;
+
+/**
+ * @brief   A fixed set of worker threads running the parallel mem functions.
+ * Run() hands out task indices to the workers and the calling thread until all are done:
+ * @code
+ *      headcode::mem::ThreadPool pool{4};
+ *      pool.Run(100, [&](std::uint64_t i) { ... work on chunk i ... });
+ * @endcode
+ * Tasks must not throw.
+ */
+class ThreadPool {
+
+    std::vector<std::thread> workers_;                  //!< @brief The worker threads.
+    std::mutex run_mutex_;                              //!< @brief Serializes concurrent Run() calls.
+    std::mutex mutex_;                                  //!< @brief Guards the job state below.
+    std::condition_variable job_started_;               //!< @brief Wakes the workers on a new job.
+    std::condition_variable job_finished_;              //!< @brief Wakes Run() when all workers are done.
+    std::function<void(std::uint64_t)> const * task_ = nullptr;        //!< @brief The current task.
+    std::uint64_t task_count_ = 0;                      //!< @brief Number of task indices of the current job.
+    std::atomic<std::uint64_t> next_task_{0};           //!< @brief Next task index to hand out.
+    std::uint64_t job_ = 0;                             //!< @brief Job counter.
+    unsigned int busy_workers_ = 0;                     //!< @brief Workers still on the current job.
+    bool stop_ = false;                                 //!< @brief Shut down the workers.
+
+public:
+    /**
+     * @brief   Constructor
+     * @param   threads         number of threads working on a job including the caller of Run(),
+     *                          0 for one per hardware thread
+     */
+    explicit ThreadPool(unsigned int threads = 0) {
+        if (threads == 0) {
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        for (unsigned int i = 1; i < threads; ++i) {
+            workers_.emplace_back([this] { Work(); });
+        }
+    }
+
+    /**
+     * @brief   Copy constructor (deleted).
+     */
+    ThreadPool(ThreadPool const &) = delete;
+
+    /**
+     * @brief   Destructor
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        job_started_.notify_all();
+        for (auto & worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief   Assignment (deleted).
+     * @return  this
+     */
+    ThreadPool & operator=(ThreadPool const &) = delete;
+
+    /**
+     * @brief   Returns the number of threads working on a job (including the caller of Run()).
+     * @return  The number of threads.
+     */
+    unsigned int GetThreads() const {
+        return static_cast<unsigned int>(workers_.size()) + 1;
+    }
+
+    /**
+     * @brief   Runs task(i) for all i in [0, count) on all threads and returns when all are done.
+     * @param   count       number of task indices
+     * @param   task        the task
+     */
+    void Run(std::uint64_t count, std::function<void(std::uint64_t)> const & task) {
+
+        std::lock_guard<std::mutex> run_lock{run_mutex_};
+        if (workers_.empty() || (count < 2)) {
+            for (std::uint64_t i = 0; i < count; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            task_ = &task;
+            task_count_ = count;
+            next_task_ = 0;
+            busy_workers_ = static_cast<unsigned int>(workers_.size());
+            ++job_;
+        }
+        job_started_.notify_all();
+
+        RunTasks(task, count);
+
+        std::unique_lock<std::mutex> lock{mutex_};
+        job_finished_.wait(lock, [this] { return busy_workers_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    /**
+     * @brief   Picks and runs task indices of the current job until none are left.
+     * @param   task        the task
+     * @param   count       number of task indices
+     */
+    void RunTasks(std::function<void(std::uint64_t)> const & task, std::uint64_t count) {
+        for (auto i = next_task_.fetch_add(1); i < count; i = next_task_.fetch_add(1)) {
+            task(i);
+        }
+    }
+
+    /**
+     * @brief   The worker thread main loop.
+     */
+    void Work() {
+
+        std::uint64_t job_done = 0;
+        while (true) {
+
+            std::function<void(std::uint64_t)> const * task = nullptr;
+            std::uint64_t count = 0;
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+                job_started_.wait(lock, [&] { return stop_ || (job_ != job_done); });
+                if (stop_) {
+                    return;
+                }
+                job_done = job_;
+                task = task_;
+                count = task_count_;
+            }
+
+            RunTasks(*task, count);
+
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (--busy_workers_ == 0) {
+                job_finished_.notify_one();
+            }
+        }
+    }
+};
+
+/**
+ * @brief   Returns the thread pool used by the parallel mem functions if none is given.
+ * This pool has one thread per hardware thread and is created on first use.
+ * @return  The default thread pool.
+ */
+inline ThreadPool & GetDefaultThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+}
+
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/benchmark/benchmark.hpp>
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+
+TEST(BenchmarkBase64, EncodeKernels48MiB) {
+
+    auto loop_count = 10u;
+    auto memory = CreateMemory<char>(48u << 20u);
+    std::string base64(headcode::mem::simd::Base64EncodedSize(memory.size(), headcode::mem::Base64Alphabet::kStandard),
+                       '\0');
+
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(headcode::mem::GetSimdLevel()); ++l) {
+
+        auto level = static_cast<headcode::mem::SimdLevel>(l);
+        auto time_start = std::chrono::high_resolution_clock::now();
+        for (std::uint64_t i = 0; i < loop_count; ++i) {
+            headcode::mem::simd::Base64Encode(base64.data(), memory.data(), memory.size(),
+                                              headcode::mem::Base64Alphabet::kStandard, level);
+        }
+
+        auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+        headcode::benchmark::Throughput throughput{elapsed, memory.size() * loop_count};
+        std::cout << StreamPerformanceIndicators(throughput,
+                                                 std::string{"BenchmarkBase64::EncodeKernels48MiB "} +
+                                                         headcode::mem::SimdLevelToString(level) + " ");
+    }
+}
+
+
+TEST(BenchmarkBase64, DecodeKernels48MiB) {
+
+    auto loop_count = 10u;
+    auto memory = CreateMemory<char>(48u << 20u);
+    auto base64 = headcode::mem::MemoryToBase64(memory.data(), memory.size());
+    std::vector<unsigned char> decoded(memory.size());
+
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(headcode::mem::GetSimdLevel()); ++l) {
+
+        auto level = static_cast<headcode::mem::SimdLevel>(l);
+        auto time_start = std::chrono::high_resolution_clock::now();
+        for (std::uint64_t i = 0; i < loop_count; ++i) {
+            auto invalid = headcode::mem::simd::Base64Decode(decoded.data(), base64.data(), base64.size(),
+                                                             headcode::mem::Base64Alphabet::kStandard, level);
+            EXPECT_EQ(invalid, base64.size());
+        }
+
+        auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+        headcode::benchmark::Throughput throughput{elapsed, memory.size() * loop_count};
+        std::cout << StreamPerformanceIndicators(throughput,
+                                                 std::string{"BenchmarkBase64::DecodeKernels48MiB "} +
+                                                         headcode::mem::SimdLevelToString(level) + " ");
+    }
+}
+
+
+TEST(BenchmarkBase64, VersusHex48MiB) {
+
+    auto loop_count = 10u;
+    auto memory = CreateMemory<char>(48u << 20u);
+    std::vector<std::byte> decoded;
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    std::string hex;
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        hex = headcode::mem::MemoryToHex(memory.data(), memory.size());
+    }
+    headcode::benchmark::Throughput memory_to_hex_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                             memory.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(memory_to_hex_throughput, "BenchmarkBase64::VersusHex48MiB MemoryToHex ");
+
+    time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        EXPECT_TRUE(headcode::mem::HexToMemoryStrict(hex, decoded));
+    }
+    headcode::benchmark::Throughput hex_to_memory_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                             memory.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(hex_to_memory_throughput,
+                                             "BenchmarkBase64::VersusHex48MiB HexToMemoryStrict ");
+
+    time_start = std::chrono::high_resolution_clock::now();
+    std::string base64;
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        base64 = headcode::mem::MemoryToBase64(memory.data(), memory.size());
+    }
+    headcode::benchmark::Throughput memory_to_base64_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                                memory.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(memory_to_base64_throughput,
+                                             "BenchmarkBase64::VersusHex48MiB MemoryToBase64 ");
+
+    time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        EXPECT_TRUE(headcode::mem::Base64ToMemory(base64, decoded));
+    }
+    headcode::benchmark::Throughput base64_to_memory_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                                memory.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(base64_to_memory_throughput,
+                                             "BenchmarkBase64::VersusHex48MiB Base64ToMemory ");
+
+    std::cout << "BenchmarkBase64::VersusHex48MiB text size: hex " << hex.size() << ", Base64 " << base64.size()
+              << std::endl;
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/benchmark/benchmark.hpp>
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+
+/**
+ * @brief   Runs the Base85 kernels of all SimdLevels and prints the throughput.
+ * @param   name        name of the benchmark
+ * @param   alphabet    the Base85 alphabet
+ */
+static void BenchmarkKernels(std::string const & name, headcode::mem::Base85Alphabet alphabet) {
+
+    auto loop_count = 10u;
+    auto memory = CreateMemory<char>(32u << 20u);
+    std::string text(headcode::mem::simd::Base85EncodedSize(memory.size()), '\0');
+    std::vector<unsigned char> decoded(memory.size());
+
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(headcode::mem::GetSimdLevel()); ++l) {
+
+        auto level = static_cast<headcode::mem::SimdLevel>(l);
+        auto time_start = std::chrono::high_resolution_clock::now();
+        for (std::uint64_t i = 0; i < loop_count; ++i) {
+            headcode::mem::simd::Base85Encode(text.data(), memory.data(), memory.size(), alphabet, level);
+        }
+        headcode::benchmark::Throughput encode_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                          memory.size() * loop_count};
+        std::cout << StreamPerformanceIndicators(encode_throughput,
+                                                 name + " encode " + headcode::mem::SimdLevelToString(level) + " ");
+
+        time_start = std::chrono::high_resolution_clock::now();
+        for (std::uint64_t i = 0; i < loop_count; ++i) {
+            auto invalid = headcode::mem::simd::Base85Decode(decoded.data(), text.data(), text.size(), alphabet, level);
+            EXPECT_EQ(invalid, text.size());
+        }
+        headcode::benchmark::Throughput decode_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                          memory.size() * loop_count};
+        std::cout << StreamPerformanceIndicators(decode_throughput,
+                                                 name + " decode " + headcode::mem::SimdLevelToString(level) + " ");
+    }
+}
+
+
+TEST(BenchmarkBase85, Z85Kernels32MiB) {
+    BenchmarkKernels("BenchmarkBase85::Z85Kernels32MiB", headcode::mem::Base85Alphabet::kZ85);
+}
+
+
+TEST(BenchmarkBase85, Ascii85Kernels32MiB) {
+    BenchmarkKernels("BenchmarkBase85::Ascii85Kernels32MiB", headcode::mem::Base85Alphabet::kAscii85);
+}
@@ -32,3 +32,38 @@ TEST(BenchmarkByteToHex, ByteToHex1000000) {
     headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), loop_count};
     std::cout << StreamPerformanceIndicators(throughput, "BenchmarkByteToHex::ByteToHex1000000 ");
 }
+
+
+TEST(BenchmarkByteToHex, ByteToHexBuffer1000000) {
+
+    auto loop_count = 1'000'000u;
+    char hex[2];
+    std::uint64_t checksum = 0;
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        headcode::mem::ByteToHex(hex, sizeof(hex), static_cast<std::byte>(i));
+        checksum += static_cast<unsigned char>(hex[0]) + static_cast<unsigned char>(hex[1]);
+    }
+
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), loop_count};
+    EXPECT_GT(checksum, 0u);
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkByteToHex::ByteToHexBuffer1000000 ");
+}
+
+
+TEST(BenchmarkByteToHex, ByteToHexChars1000000) {
+
+    auto loop_count = 1'000'000u;
+    std::uint64_t checksum = 0;
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        auto hex = headcode::mem::ByteToHexChars(static_cast<std::byte>(i));
+        checksum += static_cast<unsigned char>(hex[0]) + static_cast<unsigned char>(hex[1]);
+    }
+
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), loop_count};
+    EXPECT_GT(checksum, 0u);
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkByteToHex::ByteToHexChars1000000 ");
+}
@@ -6,16 +6,20 @@
  * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
  */
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include <headcode/benchmark/benchmark.hpp>
 #include <headcode/mem/mem.hpp>
 
+#include <shared/create_memory.hpp>
 #include <shared/ipsum_lorem.hpp>
 
 
@@ -33,3 +37,323 @@ TEST(BenchmarkCanonical, IpsumLorem1000) {
                                                IPSUM_LOREM_TEXT.size() * loop_count};
     std::cout << StreamPerformanceIndicators(throughput, "BenchmarkCanonical::IpsumLorem1000 ");
 }
+
+
+TEST(BenchmarkCanonical, StreamVersusString64MiB) {
+
+    auto memory = CreateMemory<char>(64u << 20u);
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    auto canonical = headcode::mem::CharArrayToCanonicalString(memory.data(), memory.size());
+    headcode::benchmark::Throughput string_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                      memory.size()};
+    std::cout << StreamPerformanceIndicators(string_throughput, "BenchmarkCanonical::StreamVersusString64MiB string ");
+    auto string_size = canonical.size();
+    canonical = std::string{};
+
+    std::uint64_t streamed = 0;
+    time_start = std::chrono::high_resolution_clock::now();
+    headcode::mem::CharArrayToCanonicalStream(memory.data(), memory.size(), [&](char const *, std::uint64_t size) {
+        streamed += size;
+        return true;
+    });
+    headcode::benchmark::Throughput stream_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                      memory.size()};
+    std::cout << StreamPerformanceIndicators(stream_throughput, "BenchmarkCanonical::StreamVersusString64MiB stream ");
+    EXPECT_EQ(streamed, string_size);
+}
+
+
+TEST(BenchmarkCanonical, LineKernels16MiB) {
+
+    auto loop_count = 5u;
+    auto memory = CreateMemory<char>(16u << 20u);
+
+    auto templ = headcode::mem::CanonicalLineTemplate({});
+    auto lines = memory.size() / 16;
+    std::string canonical(lines * templ.size(), '\0');
+
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(headcode::mem::GetSimdLevel()); ++l) {
+
+        auto level = static_cast<headcode::mem::SimdLevel>(l);
+        auto time_start = std::chrono::high_resolution_clock::now();
+        for (std::uint64_t i = 0; i < loop_count; ++i) {
+            headcode::mem::DumpCanonicalLines(
+                    canonical.data(), templ, 0, memory.data(), memory.size(), 0, lines, 0, level);
+        }
+
+        auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+        headcode::benchmark::Throughput throughput{elapsed, memory.size() * loop_count};
+        std::cout << StreamPerformanceIndicators(throughput,
+                                                 std::string{"BenchmarkCanonical::LineKernels16MiB "} +
+                                                         headcode::mem::SimdLevelToString(level) + " ");
+    }
+}
+
+
+TEST(BenchmarkCanonical, Squeeze64MiB) {
+
+    // mostly zero pages with a few distinct lines in between
+    std::vector<char> memory(64u << 20u, '\0');
+    for (std::size_t i = 0; i < memory.size(); i += 4096 * 16) {
+        memory[i] = static_cast<char>(i >> 16u);
+    }
+
+    for (bool squeeze : {false, true}) {
+
+        std::uint64_t streamed = 0;
+        auto time_start = std::chrono::high_resolution_clock::now();
+        headcode::mem::CharArrayToCanonicalStream(
+                memory.data(),
+                memory.size(),
+                [&](char const *, std::uint64_t size) {
+                    streamed += size;
+                    return true;
+                },
+                {},
+                64 * 1024,
+                squeeze);
+        headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                   memory.size()};
+        std::cout << StreamPerformanceIndicators(throughput,
+                                                 std::string{"BenchmarkCanonical::Squeeze64MiB "} +
+                                                         (squeeze ? "squeezed" : "full") + ", " +
+                                                         std::to_string(streamed) + " chars ");
+    }
+}
+
+
+/**
+ * @brief   Runs the canonical dump of a layout and prints the throughput.
+ * @param   name        name of the layout
+ * @param   memory      the memory to dump
+ */
+template <class Layout>
+static void BenchmarkLayout(std::string const & name, std::vector<char> const & memory) {
+
+    auto loop_count = 5u;
+    std::uint64_t chars = 0;
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        chars += headcode::mem::CharArrayToCanonicalString<Layout>(memory.data(), memory.size()).size();
+    }
+
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                               memory.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(throughput,
+                                             "BenchmarkCanonical::Layouts16MiB " + name + ", " +
+                                                     std::to_string(chars / loop_count) + " chars ");
+}
+
+
+TEST(BenchmarkCanonical, Layouts16MiB) {
+
+    auto memory = CreateMemory<char>(16u << 20u);
+
+    BenchmarkLayout<headcode::mem::CanonicalLayoutDefault>("16/8/16 ascii", memory);
+    BenchmarkLayout<headcode::mem::CanonicalLayout32>("32/8/16 ascii", memory);
+    BenchmarkLayout<headcode::mem::CanonicalLayout64>("64/8/16 ascii", memory);
+    BenchmarkLayout<headcode::mem::CanonicalLayout<32, 4, 8, false>>("32/4/8", memory);
+    BenchmarkLayout<headcode::mem::CanonicalLayout<16, 1, 4>>("16/1/4 ascii", memory);
+}
+
+
+TEST(BenchmarkCanonical, Diff64MiB) {
+
+    auto a = CreateMemory<std::byte>(64u << 20u);
+    auto b = a;
+    for (std::size_t i = 4u << 20u; i < b.size(); i += 8u << 20u) {
+        b[i + 1000] = ~b[i + 1000];
+    }
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    auto first = headcode::mem::FindFirstDifference(a, b);
+    headcode::benchmark::Throughput find_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), a.size()};
+    std::cout << StreamPerformanceIndicators(find_throughput,
+                                             "BenchmarkCanonical::Diff64MiB first difference at " +
+                                                     std::to_string(first) + " ");
+
+    time_start = std::chrono::high_resolution_clock::now();
+    auto diff = headcode::mem::MemoryDiffToCanonicalString(a, b);
+    headcode::benchmark::Throughput diff_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), a.size()};
+    std::cout << StreamPerformanceIndicators(diff_throughput,
+                                             "BenchmarkCanonical::Diff64MiB diff, " + std::to_string(diff.size()) +
+                                                     " chars ");
+
+    time_start = std::chrono::high_resolution_clock::now();
+    auto canonical_a = headcode::mem::MemoryToCanonicalString(a);
+    auto canonical_b = headcode::mem::MemoryToCanonicalString(b);
+    auto text_equal = canonical_a == canonical_b;
+    headcode::benchmark::Throughput text_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), a.size()};
+    std::cout << StreamPerformanceIndicators(text_throughput,
+                                             "BenchmarkCanonical::Diff64MiB dump both and compare text ");
+    EXPECT_FALSE(text_equal);
+}
+
+
+TEST(BenchmarkCanonical, ViewRandomLines256MiB) {
+
+    auto memory = CreateMemory<char>(256u << 20u);
+
+    // an interactive viewer jumping to a line deep into the memory
+    auto time_start = std::chrono::high_resolution_clock::now();
+    auto canonical = headcode::mem::CharArrayToCanonicalString(memory.data(), memory.size());
+    auto line_size = canonical.find('\n') + 1;
+    auto line = canonical.substr(10'000'000 * line_size, line_size);
+    auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+    std::cout << "BenchmarkCanonical::ViewRandomLines256MiB whole string, line 10'000'000: " << elapsed << " us"
+              << std::endl;
+
+    headcode::mem::CanonicalView view{memory.data(), memory.size()};
+    auto loop_count = 100'000u;
+    std::uint64_t chars = 0;
+    time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        chars += view.GetLine((i * 7919u) % view.GetLineCount()).size();
+    }
+    elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+    std::cout << "BenchmarkCanonical::ViewRandomLines256MiB view, " << loop_count << " random lines: " << elapsed
+              << " us, " << (static_cast<double>(elapsed) * 1000.0 / loop_count) << " ns per line" << std::endl;
+
+    EXPECT_EQ(view.GetLine(10'000'000), line);
+    EXPECT_EQ(chars, loop_count * line_size);
+}
+
+
+TEST(BenchmarkCanonical, Parse64MiB) {
+
+    auto memory = CreateMemory<std::byte>(64u << 20u);
+    auto canonical = headcode::mem::MemoryToCanonicalString(memory);
+
+    std::vector<std::byte> parsed;
+    auto time_start = std::chrono::high_resolution_clock::now();
+    EXPECT_TRUE(headcode::mem::CanonicalStringToMemory(canonical, parsed));
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                               canonical.size()};
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkCanonical::Parse64MiB canonical chars ");
+    EXPECT_EQ(parsed, memory);
+}
+
+
+TEST(BenchmarkCanonical, OffsetsBeyond4GiB) {
+
+    // 16 Mi line offsets from just below 4 GiB upwards, written into a block of 64 lines as the dump does
+    std::uint64_t const base_address = (4ul << 30u) - (1ul << 20u);
+    std::uint64_t const lines = 16u << 20u;
+    std::vector<char> block(64 * 16);
+    auto checksum_block = [&]() {
+        std::uint64_t sum = 0;
+        for (auto c : block) {
+            sum += static_cast<unsigned char>(c);
+        }
+        return sum;
+    };
+
+    std::uint64_t checksum = 0;
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t l = 0; l < lines; ++l) {
+        headcode::mem::HexNumberToCharArray(block.data() + (l % 64) * 16, base_address + l * 16);
+        if (l % 64 == 63) {
+            checksum += checksum_block();
+        }
+    }
+    auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+    std::cout << "BenchmarkCanonical::OffsetsBeyond4GiB formatted per line: " << elapsed << " us" << std::endl;
+
+    std::uint64_t incremental_checksum = 0;
+    char offset[16];
+    time_start = std::chrono::high_resolution_clock::now();
+    headcode::mem::HexNumberToCharArray(offset, base_address);
+    for (std::uint64_t l = 0, number = base_address; l < lines; ++l) {
+        std::copy_n(offset, 16, block.data() + (l % 64) * 16);
+        number = headcode::mem::AddToHexCharArray(offset, number, 16);
+        if (l % 64 == 63) {
+            incremental_checksum += checksum_block();
+        }
+    }
+    elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+    std::cout << "BenchmarkCanonical::OffsetsBeyond4GiB counted up: " << elapsed << " us" << std::endl;
+    EXPECT_EQ(checksum, incremental_checksum);
+
+    // a whole dump crossing 4 GiB
+    auto memory = CreateMemory<char>(64u << 20u);
+    time_start = std::chrono::high_resolution_clock::now();
+    auto canonical = headcode::mem::CharArrayToCanonicalString(memory.data(), memory.size(), {}, false, base_address);
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), memory.size()};
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkCanonical::OffsetsBeyond4GiB dump ");
+    EXPECT_EQ(canonical.substr(canonical.size() - 92, 18), "0x0000000103effff0");
+}
+
+
+TEST(BenchmarkCanonical, MonitorRefresh4MiB) {
+
+    auto memory = CreateMemory<char>(4u << 20u);
+
+    headcode::mem::CanonicalMonitor monitor;
+    monitor.Refresh(memory.data(), memory.size());
+
+    // a poll changing a few counters spread over the region
+    auto loop_count = 100u;
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        for (std::size_t j = 0; j < memory.size(); j += 256u << 10u) {
+            ++memory[j + i];
+        }
+        monitor.Refresh(memory.data(), memory.size());
+    }
+    auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+    std::cout << "BenchmarkCanonical::MonitorRefresh4MiB refresh, " << monitor.GetChangedLines().size()
+              << " changed lines: " << elapsed / loop_count << " us" << std::endl;
+
+    time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        ++memory[i];
+        auto canonical = headcode::mem::CharArrayToCanonicalString(memory.data(), memory.size());
+    }
+    elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+    std::cout << "BenchmarkCanonical::MonitorRefresh4MiB whole dump: " << elapsed / loop_count << " us" << std::endl;
+
+    monitor.Refresh(memory.data(), memory.size());
+    EXPECT_EQ(monitor.GetCanonical(), headcode::mem::CharArrayToCanonicalString(memory.data(), memory.size()));
+}
+
+
+/**
+ * @brief   Runs the typed canonical dump of a type and prints the throughput.
+ * @param   name        name of the type
+ * @param   memory      the memory to dump
+ * @param   endian      byte order of the values
+ */
+template <class T>
+static void BenchmarkTyped(std::string const & name, std::vector<char> const & memory, headcode::mem::Endian endian) {
+
+    auto loop_count = 5u;
+    std::uint64_t chars = 0;
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        chars += headcode::mem::CharArrayToTypedCanonicalString<T>(memory.data(), memory.size(), endian).size();
+    }
+
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                               memory.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(throughput,
+                                             "BenchmarkCanonical::Typed16MiB " + name + ", " +
+                                                     std::to_string(chars / loop_count) + " chars ");
+}
+
+
+TEST(BenchmarkCanonical, Typed16MiB) {
+
+    auto memory = CreateMemory<char>(16u << 20u);
+
+    BenchmarkLayout<headcode::mem::CanonicalLayoutDefault>("hex (reference)", memory);
+    BenchmarkTyped<std::uint8_t>("u8", memory, headcode::mem::Endian::kNative);
+    BenchmarkTyped<std::uint16_t>("u16", memory, headcode::mem::Endian::kNative);
+    BenchmarkTyped<std::int16_t>("i16 big endian", memory, headcode::mem::Endian::kBig);
+    BenchmarkTyped<std::uint32_t>("u32", memory, headcode::mem::Endian::kNative);
+    BenchmarkTyped<std::int32_t>("i32 big endian", memory, headcode::mem::Endian::kBig);
+    BenchmarkTyped<std::uint64_t>("u64", memory, headcode::mem::Endian::kNative);
+    BenchmarkTyped<std::int64_t>("i64 big endian", memory, headcode::mem::Endian::kBig);
+    BenchmarkTyped<float>("float", memory, headcode::mem::Endian::kNative);
+    BenchmarkTyped<double>("double big endian", memory, headcode::mem::Endian::kBig);
+}
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/benchmark/benchmark.hpp>
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+
+/**
+ * @brief   Runs a hex format on all SimdLevels and prints the throughput.
+ * @tparam  Format      the hex format
+ * @param   name        name of the benchmark
+ * @param   memory      the memory to format
+ */
+template <class Format>
+static void BenchmarkFormat(std::string const & name, std::vector<char> const & memory) {
+
+    auto loop_count = 10u;
+    std::string hex(headcode::mem::FormattedHexSize<Format>(memory.size()), '\0');
+
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(headcode::mem::GetSimdLevel()); ++l) {
+
+        auto level = static_cast<headcode::mem::SimdLevel>(l);
+        auto time_start = std::chrono::high_resolution_clock::now();
+        for (std::uint64_t i = 0; i < loop_count; ++i) {
+            headcode::mem::simd::HexFormat<Format>(hex.data(), memory.data(), memory.size(), level);
+        }
+
+        auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+        headcode::benchmark::Throughput throughput{elapsed, memory.size() * loop_count};
+        std::cout << StreamPerformanceIndicators(throughput, name +   + headcode::mem::SimdLevelToString(level) + " ");
+    }
+}
+
+
+TEST(BenchmarkHexFormat, Formats16MiB) {
+
+    auto memory = CreateMemory<char>(16u << 20u);
+
+    BenchmarkFormat<headcode::mem::HexFormatPackedUpper>("BenchmarkHexFormat::PackedUpper", memory);
+    BenchmarkFormat<headcode::mem::HexFormatColon>("BenchmarkHexFormat::Colon", memory);
+    BenchmarkFormat<headcode::mem::HexFormatCArray>("BenchmarkHexFormat::CArray", memory);
+    BenchmarkFormat<headcode::mem::HexFormatGrouped<4>>("BenchmarkHexFormat::Grouped4", memory);
+}
+
+
+TEST(BenchmarkHexFormat, ColonPostProcessed16MiB) {
+
+    auto loop_count = 10u;
+    auto memory = CreateMemory<char>(16u << 20u);
+
+    // the way to get "de:ad:be:ef" without a format: plain hex and a second pass inserting the colons
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        auto hex = headcode::mem::MemoryToHex(memory.data(), memory.size());
+        std::string colon;
+        colon.reserve(memory.size() * 3);
+        for (std::size_t j = 0; j < hex.size(); j += 2) {
+            if (j > 0) {
+                colon += ':';
+            }
+            colon.append(hex, j, 2);
+        }
+        EXPECT_EQ(colon.size(), memory.size() * 3 - 1);
+    }
+
+    auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+    headcode::benchmark::Throughput throughput{elapsed, memory.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkHexFormat::ColonPostProcessed16MiB ");
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/benchmark/benchmark.hpp>
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+
+TEST(BenchmarkHexStream, EncodeDecode256MiB) {
+
+    std::uint64_t total_size = 256u << 20u;
+    auto chunk = CreateMemory<char>(1u << 20u);
+
+    headcode::mem::HexEncoder encoder;
+    headcode::mem::HexDecoder decoder;
+    std::uint64_t decoded = 0;
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t offset = 0; offset < total_size; offset += chunk.size()) {
+
+        auto data = chunk.data();
+        auto size = chunk.size();
+        while (size > 0) {
+            auto consumed = encoder.Encode(data, size);
+            data += consumed;
+            size -= consumed;
+
+            auto hex = encoder.GetOutput();
+            auto hex_size = encoder.GetOutputSize();
+            while (hex_size > 0) {
+                auto hex_consumed = decoder.Decode(hex, hex_size);
+                hex += hex_consumed;
+                hex_size -= hex_consumed;
+                decoded += decoder.GetOutputSize();
+                decoder.ClearOutput();
+            }
+            encoder.ClearOutput();
+        }
+    }
+
+    auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+    EXPECT_EQ(decoded, total_size);
+    EXPECT_TRUE(decoder.Finish());
+    headcode::benchmark::Throughput throughput{elapsed, total_size};
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkHexStream::EncodeDecode256MiB ");
+}
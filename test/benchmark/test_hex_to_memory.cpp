@@ -0,0 +1,155 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/benchmark/benchmark.hpp>
+#include <headcode/mem/mem.hpp>
+
+
+
+/**
+ * @brief   The std::map based hex to memory conversion mem used up to 1.1.5 as reference.
+ * @param   hex     the hex string
+ * @return  the memory
+ */
+static std::vector<std::byte> MapBasedHexToMemory(std::string const & hex) {
+
+    static std::map<char, unsigned char> const hex_to_byte{
+            {'0', 0x0}, {'1', 0x1}, {'2', 0x2}, {'3', 0x3}, {'4', 0x4}, {'5', 0x5}, {'6', 0x6}, {'7', 0x7},
+            {'8', 0x8}, {'9', 0x9}, {'a', 0xa}, {'b', 0xb}, {'c', 0xc}, {'d', 0xd}, {'e', 0xe}, {'f', 0xf},
+            {'A', 0xa}, {'B', 0xb}, {'C', 0xc}, {'D', 0xd}, {'E', 0xe}, {'F', 0xf}};
+
+    std::vector<std::byte> res{hex.size() / 2};
+    for (std::size_t i = 0; i < hex.size() / 2; ++i) {
+        unsigned char value{0};
+        auto iter_first = hex_to_byte.find(hex[i * 2]);
+        if (iter_first != hex_to_byte.end()) {
+            value = iter_first->second << 4u;
+        }
+        auto iter_second = hex_to_byte.find(hex[i * 2 + 1]);
+        if (iter_second != hex_to_byte.end()) {
+            value = value | iter_second->second;
+        }
+        res[i] = static_cast<std::byte>(value);
+    }
+    return res;
+}
+
+
+/**
+ * @brief   Creates a hex string of the given size.
+ * @param   size    number of hex chars
+ * @return  a hex string
+ */
+static std::string CreateHex(std::uint64_t size) {
+    std::string hex(size, '0');
+    for (std::uint64_t i = 0; i < size; ++i) {
+        hex[i] = "0123456789abcdefABCDEF"[(i * 13u) % 22u];
+    }
+    return hex;
+}
+
+
+TEST(BenchmarkHexToMemory, MapBased16MiB) {
+
+    auto loop_count = 2u;
+    auto hex = CreateHex(16u << 20u);
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        MapBasedHexToMemory(hex);
+    }
+
+    auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+    headcode::benchmark::Throughput throughput{elapsed, hex.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkHexToMemory::MapBased16MiB ");
+}
+
+
+TEST(BenchmarkHexToMemory, Kernels64MiB) {
+
+    auto loop_count = 10u;
+    auto hex = CreateHex(64u << 20u);
+    std::vector<unsigned char> memory(hex.size() / 2);
+
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(headcode::mem::GetSimdLevel()); ++l) {
+
+        auto level = static_cast<headcode::mem::SimdLevel>(l);
+        for (auto strict : {false, true}) {
+
+            auto time_start = std::chrono::high_resolution_clock::now();
+            for (std::uint64_t i = 0; i < loop_count; ++i) {
+                headcode::mem::simd::HexDecode(memory.data(), hex.data(), hex.size(), strict, level);
+            }
+
+            auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+            headcode::benchmark::Throughput throughput{elapsed, hex.size() * loop_count};
+            std::cout << StreamPerformanceIndicators(throughput,
+                                                     std::string{"BenchmarkHexToMemory::Kernels64MiB "} +
+                                                             headcode::mem::SimdLevelToString(level) +
+                                                             (strict ? " strict" : "") + " ");
+        }
+    }
+}
+
+
+TEST(BenchmarkHexToMemory, HexToMemory1000) {
+
+    auto loop_count = 1000u;
+    auto hex = CreateHex(128u << 10u);
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        headcode::mem::HexToMemory(hex);
+    }
+
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                               hex.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkHexToMemory::HexToMemory1000 ");
+}
+
+
+/**
+ * @brief   Decodes into a reused memory block and prints the throughput.
+ * @param   name        name of the memory block type
+ * @param   hex         the hex string
+ */
+template <class Memory>
+static void BenchmarkReusedMemory(std::string const & name, std::string const & hex) {
+
+    // the memory is reused, so page faults of fresh allocations do not hide the cost of zero filling
+    auto loop_count = 10u;
+    Memory memory;
+    memory.reserve(hex.size() / 2);
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        memory.clear();
+        headcode::mem::HexToMemory(memory, hex);
+    }
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                               hex.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkHexToMemory::ReusedMemory64MiB " + name + " ");
+    EXPECT_EQ(memory.size(), hex.size() / 2);
+}
+
+
+TEST(BenchmarkHexToMemory, ReusedMemory64MiB) {
+    auto hex = CreateHex(64u << 20u);
+    BenchmarkReusedMemory<std::vector<std::byte>>("std::vector", hex);
+    BenchmarkReusedMemory<headcode::mem::ByteBuffer>("ByteBuffer", hex);
+}
@@ -9,12 +9,16 @@
 #include <chrono>
 #include <cstdint>
 #include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include <headcode/benchmark/benchmark.hpp>
 #include <headcode/mem/mem.hpp>
 
+#include <shared/create_memory.hpp>
 #include <shared/ipsum_lorem.hpp>
 
 
@@ -52,3 +56,210 @@ TEST(BenchmarkManipulator, IpsumLorem1000PreReserve) {
                                                IPSUM_LOREM_TEXT.size() * loop_count};
     std::cout << StreamPerformanceIndicators(throughput, "BenchmarkManipulator::IpsumLorem1000PreReserve ");
 }
+
+
+/**
+ * @brief   Streams small values into a manipulator and prints the throughput.
+ * @param   name            name of the growth policy
+ * @param   policy          the growth policy
+ * @param   loop_count      number of values to write
+ */
+static void BenchmarkSmallWrites(std::string const & name,
+                                 headcode::mem::GrowthPolicy policy,
+                                 std::uint64_t loop_count) {
+
+    std::vector<std::byte> data;
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    headcode::mem::MemoryManipulator manipulator{data, std::move(policy)};
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        manipulator << static_cast<std::uint32_t>(i);
+    }
+
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                               data.size()};
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkManipulator::SmallWrites " + name + " ");
+    EXPECT_EQ(data.size(), loop_count * sizeof(std::uint32_t));
+}
+
+
+TEST(BenchmarkManipulator, SmallWrites4M) {
+
+    auto loop_count = 4'000'000u;
+    BenchmarkSmallWrites("4M geometric 2", headcode::mem::GrowthPolicy{}, loop_count);
+    BenchmarkSmallWrites("4M geometric 1.5", headcode::mem::GrowthPolicy::Geometric(1.5), loop_count);
+    BenchmarkSmallWrites("4M chunk 1 MiB", headcode::mem::GrowthPolicy::Chunk(1u << 20u), loop_count);
+    BenchmarkSmallWrites("4M custom (doubling)",
+                         headcode::mem::GrowthPolicy::Custom(
+                                 [](std::uint64_t capacity, std::uint64_t) { return capacity * 2; }),
+                         loop_count);
+}
+
+
+TEST(BenchmarkManipulator, SmallWritesExactVersusGeometric) {
+
+    // exact growth copies the whole memory on each write: keep the count low
+    auto loop_count = 20'000u;
+    BenchmarkSmallWrites("20K exact", headcode::mem::GrowthPolicy::Exact(), loop_count);
+    BenchmarkSmallWrites("20K geometric 2", headcode::mem::GrowthPolicy{}, loop_count);
+}
+
+
+/**
+ * @brief   Writes and reads a vector of numbers in bulk and item by item and prints the throughput.
+ * @param   name            name of the item type
+ * @param   count           number of items
+ * @param   endian_aware    endian conversion flag
+ */
+template <class T>
+static void BenchmarkBulk(std::string const & name, std::uint64_t count, bool endian_aware) {
+
+    std::vector<T> items(count);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        items[i] = static_cast<T>(i * 3);
+    }
+    auto bytes = count * sizeof(T);
+    auto label = "BenchmarkManipulator::" + name + (endian_aware ? " endian aware" : "");
+
+    std::vector<std::byte> data;
+    data.reserve(bytes + sizeof(std::uint64_t));
+    headcode::mem::MemoryManipulator manipulator{data};
+    manipulator.SetEndianAware(endian_aware);
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    manipulator << static_cast<std::uint64_t>(items.size());
+    for (auto item : items) {
+        manipulator << item;
+    }
+    std::cout << StreamPerformanceIndicators(
+            headcode::benchmark::Throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), bytes},
+            label + " write item by item ");
+
+    manipulator.Reset();
+    time_start = std::chrono::high_resolution_clock::now();
+    manipulator << items;
+    std::cout << StreamPerformanceIndicators(
+            headcode::benchmark::Throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), bytes},
+            label + " write bulk ");
+
+    std::vector<T> read;
+    read.reserve(count);
+    manipulator.Reset();
+    time_start = std::chrono::high_resolution_clock::now();
+    std::uint64_t size = 0;
+    manipulator >> size;
+    for (std::uint64_t i = 0; i < size; ++i) {
+        T item;
+        manipulator >> item;
+        read.push_back(item);
+    }
+    std::cout << StreamPerformanceIndicators(
+            headcode::benchmark::Throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), bytes},
+            label + " read item by item ");
+    EXPECT_EQ(read, items);
+
+    manipulator.Reset();
+    time_start = std::chrono::high_resolution_clock::now();
+    manipulator >> read;
+    std::cout << StreamPerformanceIndicators(
+            headcode::benchmark::Throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start), bytes},
+            label + " read bulk ");
+    EXPECT_EQ(read, items);
+}
+
+
+TEST(BenchmarkManipulator, BulkVector4M) {
+
+    auto count = 4'000'000u;
+    for (auto endian_aware : {false, true}) {
+        BenchmarkBulk<double>("4M double", count, endian_aware);
+        BenchmarkBulk<std::uint32_t>("4M uint32", count, endian_aware);
+    }
+}
+
+
+/**
+ * @brief   Swaps the bytes of items in 64 MiB on all levels, in place and while copying, and prints the throughput.
+ */
+template <std::uint64_t Width>
+static void BenchmarkByteSwap() {
+
+    auto loop_count = 10u;
+    auto memory = CreateMemory<char>(64u << 20u);
+    std::vector<char> copy(memory.size());
+    auto count = memory.size() / Width;
+
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(headcode::mem::GetSimdLevel()); ++l) {
+
+        auto level = static_cast<headcode::mem::SimdLevel>(l);
+        auto name = "BenchmarkManipulator::ByteSwap64MiB " + std::to_string(Width * 8) + " bit " +
+                    headcode::mem::SimdLevelToString(level);
+
+        auto time_start = std::chrono::high_resolution_clock::now();
+        for (std::uint64_t i = 0; i < loop_count; ++i) {
+            headcode::mem::simd::ByteSwap<Width>(memory.data(), memory.data(), count, level);
+        }
+        headcode::benchmark::Throughput in_place_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                            memory.size() * loop_count};
+        std::cout << StreamPerformanceIndicators(in_place_throughput, name + " in place ");
+
+        time_start = std::chrono::high_resolution_clock::now();
+        for (std::uint64_t i = 0; i < loop_count; ++i) {
+            headcode::mem::simd::ByteSwap<Width>(copy.data(), memory.data(), count, level);
+        }
+        headcode::benchmark::Throughput copy_throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                                        memory.size() * loop_count};
+        std::cout << StreamPerformanceIndicators(copy_throughput, name + " copy ");
+    }
+}
+
+
+TEST(BenchmarkManipulator, ByteSwap64MiB) {
+    BenchmarkByteSwap<2>();
+    BenchmarkByteSwap<4>();
+    BenchmarkByteSwap<8>();
+}
+
+
+/**
+ * @brief   Streams numbers one by one into a manipulator and prints the throughput.
+ * @param   name            name of the manipulator
+ * @param   manipulator     the manipulator
+ * @param   memory          the memory of the manipulator
+ * @param   loop_count      number of values to write
+ */
+template <class Manipulator>
+static void BenchmarkNumbers(std::string const & name,
+                             Manipulator & manipulator,
+                             std::vector<std::byte> & memory,
+                             std::uint64_t loop_count) {
+
+    memory.reserve(loop_count * (sizeof(std::uint32_t) + sizeof(double)));
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        manipulator << static_cast<std::uint32_t>(i) << static_cast<double>(i);
+    }
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                               memory.size()};
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkManipulator::Numbers " + name + " ");
+}
+
+
+TEST(BenchmarkManipulator, RuntimeVersusCompileTimeEndian4M) {
+
+    auto loop_count = 4'000'000u;
+
+    std::vector<std::byte> runtime_memory;
+    headcode::mem::MemoryManipulator runtime{runtime_memory};
+    runtime.SetEndianAware(true);
+    BenchmarkNumbers("4M runtime big endian", runtime, runtime_memory, loop_count);
+
+    std::vector<std::byte> big_memory;
+    headcode::mem::BasicMemoryManipulator<headcode::mem::ManipulatorEndian::kBig> big{big_memory};
+    BenchmarkNumbers("4M compile time big endian", big, big_memory, loop_count);
+    EXPECT_EQ(big_memory, runtime_memory);
+
+    std::vector<std::byte> little_memory;
+    headcode::mem::BasicMemoryManipulator<headcode::mem::ManipulatorEndian::kLittle> little{little_memory};
+    BenchmarkNumbers("4M compile time little endian", little, little_memory, loop_count);
+}
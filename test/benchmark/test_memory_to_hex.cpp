@@ -0,0 +1,59 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/benchmark/benchmark.hpp>
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+
+TEST(BenchmarkMemoryToHex, Kernels64MiB) {
+
+    auto loop_count = 10u;
+    auto memory = CreateMemory<char>(64u << 20u);
+    std::string hex(memory.size() * 2, '\0');
+
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(headcode::mem::GetSimdLevel()); ++l) {
+
+        auto level = static_cast<headcode::mem::SimdLevel>(l);
+        auto time_start = std::chrono::high_resolution_clock::now();
+        for (std::uint64_t i = 0; i < loop_count; ++i) {
+            headcode::mem::simd::HexEncode(hex.data(), memory.data(), memory.size(), level);
+        }
+
+        auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+        headcode::benchmark::Throughput throughput{elapsed, memory.size() * loop_count};
+        std::cout << StreamPerformanceIndicators(throughput,
+                                                 std::string{"BenchmarkMemoryToHex::Kernels64MiB "} +
+                                                         headcode::mem::SimdLevelToString(level) + " ");
+    }
+}
+
+
+TEST(BenchmarkMemoryToHex, MemoryToHex1000) {
+
+    auto loop_count = 1000u;
+    auto memory = headcode::mem::StringToMemory(std::string(64u << 10u, 'x'));
+
+    auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::uint64_t i = 0; i < loop_count; ++i) {
+        headcode::mem::MemoryToHex(memory);
+    }
+
+    headcode::benchmark::Throughput throughput{headcode::benchmark::GetElapsedMicroSeconds(time_start),
+                                               memory.size() * loop_count};
+    std::cout << StreamPerformanceIndicators(throughput, "BenchmarkMemoryToHex::MemoryToHex1000 ");
+}
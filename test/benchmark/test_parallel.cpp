@@ -0,0 +1,126 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/benchmark/benchmark.hpp>
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+
+/**
+ * @brief   Largest input size of the scaling benchmarks.
+ * Defaults to 256 MiB, set HCS_MEM_BENCHMARK_MAX_SIZE (in bytes) to go up to several GiB.
+ * @return  The maximum input size.
+ */
+static std::uint64_t GetMaxBenchmarkSize() {
+    auto env = std::getenv("HCS_MEM_BENCHMARK_MAX_SIZE");
+    return env ? std::strtoull(env, nullptr, 10) : (256ull << 20u);
+}
+
+
+/**
+ * @brief   The thread counts to benchmark: 1, 2, 4, ... up to the hardware threads.
+ * @return  The thread counts.
+ */
+static std::vector<unsigned int> GetBenchmarkThreads() {
+    std::vector<unsigned int> threads;
+    auto hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (unsigned int t = 1; t < hardware_threads; t *= 2) {
+        threads.push_back(t);
+    }
+    threads.push_back(hardware_threads);
+    return threads;
+}
+
+
+TEST(BenchmarkParallel, MemoryToHexScaling) {
+
+    for (std::uint64_t size = 1ull << 20u; size <= GetMaxBenchmarkSize(); size *= 16) {
+
+        std::vector<std::byte> memory(size, std::byte{0x5a});
+        for (auto threads : GetBenchmarkThreads()) {
+
+            headcode::mem::ThreadPool pool{threads};
+            auto time_start = std::chrono::high_resolution_clock::now();
+            auto hex = headcode::mem::MemoryToHexParallel(memory, pool);
+            auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+
+            EXPECT_EQ(hex.size(), size * 2);
+            headcode::benchmark::Throughput throughput{elapsed, size};
+            std::cout << StreamPerformanceIndicators(throughput,
+                                                     "BenchmarkParallel::MemoryToHexScaling " +
+                                                             std::to_string(size >> 20u) + " MiB, " +
+                                                             std::to_string(threads) + " threads ");
+        }
+    }
+}
+
+
+TEST(BenchmarkParallel, HexToMemoryScaling) {
+
+    for (std::uint64_t size = 1ull << 20u; size <= GetMaxBenchmarkSize(); size *= 16) {
+
+        std::string hex(size * 2, 'a');
+        for (auto threads : GetBenchmarkThreads()) {
+
+            headcode::mem::ThreadPool pool{threads};
+            auto time_start = std::chrono::high_resolution_clock::now();
+            auto memory = headcode::mem::HexToMemoryParallel(hex, pool);
+            auto elapsed = headcode::benchmark::GetElapsedMicroSeconds(time_start);
+
+            EXPECT_EQ(memory.size(), size);
+            headcode::benchmark::Throughput throughput{elapsed, hex.size()};
+            std::cout << StreamPerformanceIndicators(throughput,
+                                                     "BenchmarkParallel::HexToMemoryScaling " +
+                                                             std::to_string(size >> 20u) + " MiB, " +
+                                                             std::to_string(threads) + " threads ");
+        }
+    }
+}
+
+
+TEST(BenchmarkParallel, CanonicalScaling) {
+
+    // the result is about 5.75 times the input: stay at a quarter of the maximum size
+    for (std::uint64_t size = 1ull << 20u; size <= GetMaxBenchmarkSize() / 4; size *= 8) {
+
+        auto memory = CreateMemory<std::byte>(size);
+
+        double single_thread_elapsed = 0.0;
+        for (auto threads : GetBenchmarkThreads()) {
+
+            headcode::mem::ThreadPool pool{threads};
+            auto time_start = std::chrono::high_resolution_clock::now();
+            auto canonical = headcode::mem::MemoryToCanonicalStringParallel(memory, {}, 0, pool);
+            auto elapsed = std::max<std::uint64_t>(headcode::benchmark::GetElapsedMicroSeconds(time_start), 1);
+            if (threads == 1) {
+                single_thread_elapsed = static_cast<double>(elapsed);
+            }
+
+            EXPECT_EQ(canonical.size(), (size / 16) * 92);
+            auto speedup = single_thread_elapsed / static_cast<double>(elapsed);
+            headcode::benchmark::Throughput throughput{elapsed, size};
+            std::cout << StreamPerformanceIndicators(throughput,
+                                                     "BenchmarkParallel::CanonicalScaling " +
+                                                             std::to_string(size >> 20u) + " MiB, " +
+                                                             std::to_string(threads) + " threads, speedup " +
+                                                             std::to_string(speedup) + " ");
+        }
+    }
+}
@@ -0,0 +1,32 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#ifndef HEADCODE_SPACE_MEM_TEST_SHARED_CREATE_MEMORY_HPP
+#define HEADCODE_SPACE_MEM_TEST_SHARED_CREATE_MEMORY_HPP
+
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @brief   Creates some memory holding all byte values.
+ * @tparam  T           the element type (char or std::byte)
+ * @param   size        size of the memory
+ * @return  The memory.
+ */
+template <class T = char>
+inline std::vector<T> CreateMemory(std::uint64_t size) {
+    std::vector<T> memory(size);
+    for (std::uint64_t i = 0; i < size; ++i) {
+        memory[i] = static_cast<T>(i * 7 + 3);
+    }
+    return memory;
+}
+
+
+#endif
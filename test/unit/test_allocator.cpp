@@ -0,0 +1,148 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+using namespace headcode::mem;
+
+
+TEST(Allocator, ByteBuffer) {
+
+    ByteBuffer buffer;
+    buffer.resize(100);
+    EXPECT_EQ(buffer.size(), 100u);
+    buffer.resize(200, std::byte{0x2a});
+    EXPECT_EQ(buffer[150], std::byte{0x2a});
+    buffer.push_back(std::byte{0x11});
+    EXPECT_EQ(buffer.back(), std::byte{0x11});
+
+    std::vector<int, DefaultInitAllocator<int>> numbers{1, 2, 3};
+    numbers.insert(numbers.begin(), 0);
+    EXPECT_EQ(numbers, (std::vector<int, DefaultInitAllocator<int>>{0, 1, 2, 3}));
+}
+
+
+TEST(Allocator, DecodeIntoByteBuffer) {
+
+    // sizes well beyond the blocks in which std::vector results are appended
+    auto memory = CreateMemory<std::byte>(100'000);
+    std::vector<std::byte> vector;
+    ByteBuffer buffer;
+
+    auto hex = MemoryToHex(memory);
+    EXPECT_TRUE(HexToMemoryStrict(hex, vector));
+    EXPECT_TRUE(HexToMemoryStrict(hex, buffer));
+    EXPECT_EQ(vector, memory);
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), memory.begin(), memory.end()));
+
+    auto base64 = MemoryToBase64(memory);
+    EXPECT_TRUE(Base64ToMemory(base64, vector));
+    EXPECT_TRUE(Base64ToMemory(base64, buffer));
+    EXPECT_EQ(vector, memory);
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), memory.begin(), memory.end()));
+
+    auto z85 = MemoryToZ85(memory);
+    EXPECT_TRUE(Z85ToMemory(z85, vector));
+    EXPECT_TRUE(Z85ToMemory(z85, buffer));
+    EXPECT_EQ(vector, memory);
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), memory.begin(), memory.end()));
+
+    auto ascii85 = MemoryToAscii85(memory);
+    EXPECT_TRUE(Ascii85ToMemory(ascii85, vector));
+    EXPECT_TRUE(Ascii85ToMemory(ascii85, buffer));
+    EXPECT_EQ(vector, memory);
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), memory.begin(), memory.end()));
+
+    // long runs of equal lines are squeezed into "*" lines spanning several blocks
+    std::vector<std::byte> runs(200'000, std::byte{0x5a});
+    std::fill(runs.begin() + 50'000, runs.begin() + 50'100, std::byte{0x00});
+    runs.resize(runs.size() + 7);
+    auto canonical = MemoryToCanonicalString(runs, {}, true);
+    EXPECT_TRUE(CanonicalStringToMemory(canonical, vector));
+    EXPECT_TRUE(CanonicalStringToMemory(canonical, buffer));
+    EXPECT_EQ(vector, runs);
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), runs.begin(), runs.end()));
+}
+
+
+TEST(Allocator, InvalidPositionsBeyondFirstBlock) {
+
+    auto memory = CreateMemory<std::byte>(90'000);
+    std::vector<std::byte> vector;
+    ByteBuffer buffer;
+    std::uint64_t invalid = 0;
+
+    auto hex = MemoryToHex(memory);
+    hex[150'001] = 'x';
+    EXPECT_FALSE(HexToMemoryStrict(hex, vector, &invalid));
+    EXPECT_EQ(invalid, 150'001u);
+    EXPECT_TRUE(vector.empty());
+    invalid = 0;
+    EXPECT_FALSE(HexToMemoryStrict(hex, buffer, &invalid));
+    EXPECT_EQ(invalid, 150'001u);
+    EXPECT_TRUE(buffer.empty());
+
+    auto base64 = MemoryToBase64(memory);
+    base64[100'002] = '!';
+    EXPECT_FALSE(Base64ToMemory(base64, vector, Base64Alphabet::kStandard, &invalid));
+    EXPECT_EQ(invalid, 100'002u);
+    invalid = 0;
+    EXPECT_FALSE(Base64ToMemory(base64, buffer, Base64Alphabet::kStandard, &invalid));
+    EXPECT_EQ(invalid, 100'002u);
+
+    auto z85 = MemoryToZ85(memory);
+    z85[70'003] = '~';
+    EXPECT_FALSE(Z85ToMemory(z85, vector, &invalid));
+    EXPECT_EQ(invalid, 70'003u);
+    invalid = 0;
+    EXPECT_FALSE(Z85ToMemory(z85, buffer, &invalid));
+    EXPECT_EQ(invalid, 70'003u);
+}
+
+
+TEST(Allocator, HexToMemoryAppend) {
+
+    auto memory = CreateMemory<std::byte>(50'000);
+    auto hex = MemoryToHex(memory);
+
+    ByteBuffer buffer{std::byte{1}, std::byte{2}};
+    EXPECT_EQ(HexToMemory(buffer, hex), memory.size());
+    EXPECT_EQ(HexToMemory(buffer, hex), memory.size());
+    ASSERT_EQ(buffer.size(), 2 + 2 * memory.size());
+    EXPECT_EQ(buffer[0], std::byte{1});
+    EXPECT_EQ(buffer[1], std::byte{2});
+    EXPECT_TRUE(std::equal(buffer.begin() + 2, buffer.begin() + 2 + memory.size(), memory.begin()));
+    EXPECT_TRUE(std::equal(buffer.begin() + 2 + memory.size(), buffer.end(), memory.begin()));
+}
+
+
+TEST(Allocator, ManipulatorOverwriteAndAppend) {
+
+    std::vector<std::byte> memory(4, std::byte{0xee});
+    MemoryManipulator manipulator{memory};
+    manipulator.SetPosition(2);
+    manipulator.Add("abcdef", 6);
+    EXPECT_EQ(manipulator.GetPosition(), 8u);
+    EXPECT_EQ(memory, (std::vector<std::byte>{std::byte{0xee}, std::byte{0xee}, std::byte{'a'}, std::byte{'b'},
+                                              std::byte{'c'}, std::byte{'d'}, std::byte{'e'}, std::byte{'f'}}));
+
+    manipulator.Reset();
+    manipulator.Add("xy", 2);
+    EXPECT_EQ(memory.size(), 8u);
+    EXPECT_EQ(memory[0], std::byte{'x'});
+    EXPECT_EQ(memory[2], std::byte{'a'});
+}
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+using namespace headcode::mem;
+
+
+TEST(Base64, Rfc4648) {
+
+    EXPECT_EQ(MemoryToBase64(StringToMemory("")), "");
+    EXPECT_EQ(MemoryToBase64(StringToMemory("f")), "Zg==");
+    EXPECT_EQ(MemoryToBase64(StringToMemory("fo")), "Zm8=");
+    EXPECT_EQ(MemoryToBase64(StringToMemory("foo")), "Zm9v");
+    EXPECT_EQ(MemoryToBase64(StringToMemory("foob")), "Zm9vYg==");
+    EXPECT_EQ(MemoryToBase64(StringToMemory("fooba")), "Zm9vYmE=");
+    EXPECT_EQ(MemoryToBase64(StringToMemory("foobar")), "Zm9vYmFy");
+
+    std::vector<std::byte> memory;
+    EXPECT_TRUE(Base64ToMemory("Zm9vYmE=", memory));
+    EXPECT_EQ(memory, StringToMemory("fooba"));
+    EXPECT_TRUE(Base64ToMemory("Zg==", memory));
+    EXPECT_EQ(memory, StringToMemory("f"));
+    EXPECT_TRUE(Base64ToMemory("", memory));
+    EXPECT_TRUE(memory.empty());
+}
+
+
+TEST(Base64, UrlAlphabet) {
+
+    char const data[] = {'\xfb', '\xff', '\xbf', '\xfe'};
+    EXPECT_EQ(MemoryToBase64(data, 4), "+/+//g==");
+    EXPECT_EQ(MemoryToBase64(data, 4, Base64Alphabet::kUrl), "-_-__g");
+
+    std::vector<std::byte> memory;
+    EXPECT_TRUE(Base64ToMemory("-_-__g", memory, Base64Alphabet::kUrl));
+    EXPECT_EQ(memory, CharArrayToMemory(data, 4));
+    EXPECT_TRUE(Base64ToMemory("-_-__g==", memory, Base64Alphabet::kUrl));
+    EXPECT_EQ(memory, CharArrayToMemory(data, 4));
+
+    std::uint64_t position = 0;
+    EXPECT_FALSE(Base64ToMemory("-_-__g==", memory, Base64Alphabet::kStandard, &position));
+    EXPECT_EQ(position, 0u);
+    EXPECT_FALSE(Base64ToMemory("+/+//g==", memory, Base64Alphabet::kUrl, &position));
+    EXPECT_EQ(position, 0u);
+}
+
+
+TEST(Base64, Invalid) {
+
+    std::vector<std::byte> memory{std::byte{1}};
+    std::uint64_t position = 0;
+
+    // missing padding, dangling char, padding in the middle, too much padding
+    EXPECT_FALSE(Base64ToMemory("Zm9vYg", memory, Base64Alphabet::kStandard, &position));
+    EXPECT_EQ(position, 6u);
+    EXPECT_TRUE(memory.empty());
+    EXPECT_FALSE(Base64ToMemory("Zm9vY", memory, Base64Alphabet::kUrl, &position));
+    EXPECT_EQ(position, 5u);
+    EXPECT_FALSE(Base64ToMemory("Zg==Zm9v", memory, Base64Alphabet::kStandard, &position));
+    EXPECT_EQ(position, 2u);
+    EXPECT_FALSE(Base64ToMemory("Z===", memory, Base64Alphabet::kStandard, &position));
+    EXPECT_EQ(position, 1u);
+    EXPECT_FALSE(Base64ToMemory("====", memory, Base64Alphabet::kStandard, &position));
+    EXPECT_EQ(position, 0u);
+
+    // unused bits of the last char must be 0
+    EXPECT_FALSE(Base64ToMemory("Zh==", memory, Base64Alphabet::kStandard, &position));
+    EXPECT_EQ(position, 1u);
+    EXPECT_FALSE(Base64ToMemory("Zm9=", memory, Base64Alphabet::kStandard, &position));
+    EXPECT_EQ(position, 2u);
+
+    // invalid chars deep inside long input hit every kernel
+    auto base64 = MemoryToBase64(std::vector<std::byte>(3000, std::byte{0x5a}));
+    for (std::uint64_t offset : {0ul, 17ul, 100ul, 1000ul, 2222ul, 3998ul}) {
+        for (char c : {'!', '=', '\x80', ' ', '-'}) {
+            auto broken = base64;
+            broken[offset] = c;
+            for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+                auto level = static_cast<SimdLevel>(l);
+                std::vector<unsigned char> dst(3000);
+                auto invalid =
+                        simd::Base64Decode(dst.data(), broken.data(), broken.size(), Base64Alphabet::kStandard, level);
+                EXPECT_EQ(invalid, offset) << "level: " << SimdLevelToString(level) << ", offset: " << offset;
+            }
+            EXPECT_FALSE(Base64ToMemory(broken, memory, Base64Alphabet::kStandard, &position));
+            EXPECT_EQ(position, offset);
+        }
+    }
+}
+
+
+TEST(Base64, AllLevels) {
+
+    std::vector<char> memory(1000);
+    for (std::size_t i = 0; i < memory.size(); ++i) {
+        memory[i] = static_cast<char>((i * 7919u) >> 3u);
+    }
+
+    for (auto alphabet : {Base64Alphabet::kStandard, Base64Alphabet::kUrl}) {
+        for (std::uint64_t size = 0; size < memory.size(); size += 7) {
+
+            std::string expected(simd::Base64EncodedSize(size, alphabet), '\0');
+            simd::Base64EncodeScalar(expected.data(), reinterpret_cast<unsigned char const *>(memory.data()), size,
+                                     alphabet);
+
+            for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+
+                auto level = static_cast<SimdLevel>(l);
+                std::string base64(expected.size(), '\0');
+                simd::Base64Encode(base64.data(), memory.data(), size, alphabet, level);
+                ASSERT_EQ(base64, expected) << "level: " << SimdLevelToString(level) << ", size: " << size;
+
+                auto body = size / 3 * 4;
+                std::vector<unsigned char> decoded(size / 3 * 3);
+                EXPECT_EQ(simd::Base64Decode(decoded.data(), base64.data(), body, alphabet, level), body);
+                EXPECT_EQ(std::string(decoded.begin(), decoded.end()), std::string(memory.data(), decoded.size()))
+                        << "level: " << SimdLevelToString(level) << ", size: " << size;
+            }
+
+            std::vector<std::byte> decoded;
+            EXPECT_TRUE(Base64ToMemory(expected, decoded, alphabet));
+            EXPECT_EQ(decoded, CharArrayToMemory(memory.data(), size));
+        }
+    }
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+using namespace headcode::mem;
+
+
+TEST(Base85, Z85Rfc32) {
+
+    char const data[] = {'\x86', '\x4f', '\xd2', '\x6f', '\xb5', '\x59', '\xf7', '\x5b'};
+    EXPECT_EQ(MemoryToZ85(data, 8), "HelloWorld");
+
+    std::vector<std::byte> memory;
+    EXPECT_TRUE(Z85ToMemory("HelloWorld", memory));
+    EXPECT_EQ(memory, CharArrayToMemory(data, 8));
+    EXPECT_TRUE(Z85ToMemory("", memory));
+    EXPECT_TRUE(memory.empty());
+
+    EXPECT_EQ(MemoryToZ85(std::vector<std::byte>(4, std::byte{0xff})), "%nSc0");
+    EXPECT_EQ(MemoryToZ85(std::vector<std::byte>(4, std::byte{0x00})), "00000");
+}
+
+
+TEST(Base85, Ascii85) {
+
+    EXPECT_EQ(MemoryToAscii85(StringToMemory("Man is distinguished")), "9jqo^BlbD-BleB1DJ+*+F(f,q");
+    EXPECT_EQ(MemoryToAscii85(StringToMemory(".")), "/c");
+
+    std::vector<std::byte> memory;
+    EXPECT_TRUE(Ascii85ToMemory("9jqo^BlbD-BleB1DJ+*+F(f,q", memory));
+    EXPECT_EQ(memory, StringToMemory("Man is distinguished"));
+    EXPECT_TRUE(Ascii85ToMemory("/c", memory));
+    EXPECT_EQ(memory, StringToMemory("."));
+
+    // 'z' abbreviates a zero group
+    EXPECT_TRUE(Ascii85ToMemory("z@:E^", memory));
+    EXPECT_EQ(memory, StringToMemory(std::string(4, '\0') + "abc"));
+    EXPECT_TRUE(Ascii85ToMemory("9jqo^zzBlbD-z", memory));
+    EXPECT_EQ(memory, StringToMemory(std::string{"Man "} + std::string(8, '\0') + "is d" + std::string(4, '\0')));
+}
+
+
+TEST(Base85, Padding) {
+
+    std::vector<char> data(11);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(0xf0 + i);
+    }
+
+    for (std::uint64_t size = 0; size <= data.size(); ++size) {
+        std::vector<std::byte> memory;
+        auto z85 = MemoryToZ85(data.data(), size);
+        EXPECT_EQ(z85.size(), size / 4 * 5 + (size % 4 ? size % 4 + 1 : 0));
+        EXPECT_TRUE(Z85ToMemory(z85, memory)) << "size: " << size;
+        EXPECT_EQ(memory, CharArrayToMemory(data.data(), size));
+
+        auto ascii85 = MemoryToAscii85(data.data(), size);
+        EXPECT_TRUE(Ascii85ToMemory(ascii85, memory)) << "size: " << size;
+        EXPECT_EQ(memory, CharArrayToMemory(data.data(), size));
+    }
+}
+
+
+TEST(Base85, Invalid) {
+
+    std::vector<std::byte> memory{std::byte{1}};
+    std::uint64_t position = 0;
+
+    // dangling char, invalid char, group above 32 bits, 'z' only in Ascii85 between groups
+    EXPECT_FALSE(Z85ToMemory("HelloWorldH", memory, &position));
+    EXPECT_EQ(position, 11u);
+    EXPECT_TRUE(memory.empty());
+    EXPECT_FALSE(Z85ToMemory("Hello~orld", memory, &position));
+    EXPECT_EQ(position, 5u);
+    EXPECT_FALSE(Z85ToMemory("Hello%nSc1", memory, &position));
+    EXPECT_EQ(position, 5u);
+    EXPECT_FALSE(Ascii85ToMemory("9jqo^s8W-\"", memory, &position));
+    EXPECT_EQ(position, 5u);
+    EXPECT_FALSE(Ascii85ToMemory("9jqzo^", memory, &position));
+    EXPECT_EQ(position, 3u);
+    EXPECT_FALSE(Ascii85ToMemory("9jqo^vv", memory, &position));
+    EXPECT_EQ(position, 5u);
+
+    // a last partial group must be written as MemoryToZ85 does
+    EXPECT_FALSE(Ascii85ToMemory("/d", memory, &position));
+    EXPECT_EQ(position, 1u);
+
+    // invalid chars and groups deep inside long input hit every kernel
+    auto z85 = MemoryToZ85(std::vector<std::byte>(800, std::byte{0x5a}));
+    for (std::uint64_t offset : {0ul, 17ul, 100ul, 555ul, 999ul}) {
+        for (char c : {'~', '"', '\x80', ' ', '\x01'}) {
+            auto broken = z85;
+            broken[offset] = c;
+            for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+                auto level = static_cast<SimdLevel>(l);
+                std::vector<unsigned char> dst(800);
+                EXPECT_EQ(simd::Base85Decode(dst.data(), broken.data(), broken.size(), Base85Alphabet::kZ85, level),
+                          offset)
+                        << "level: " << SimdLevelToString(level) << ", offset: " << offset;
+            }
+            EXPECT_FALSE(Z85ToMemory(broken, memory, &position));
+            EXPECT_EQ(position, offset);
+        }
+
+        auto broken = z85;
+        broken.replace(offset / 5 * 5, 5, "%nSc1");
+        for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+            auto level = static_cast<SimdLevel>(l);
+            std::vector<unsigned char> dst(800);
+            EXPECT_EQ(simd::Base85Decode(dst.data(), broken.data(), broken.size(), Base85Alphabet::kZ85, level),
+                      offset / 5 * 5)
+                    << "level: " << SimdLevelToString(level) << ", offset: " << offset;
+        }
+    }
+}
+
+
+TEST(Base85, AllLevels) {
+
+    std::vector<char> memory(1000);
+    for (std::size_t i = 0; i < memory.size(); ++i) {
+        memory[i] = static_cast<char>((i * 7919u) >> 3u);
+    }
+    std::fill(memory.begin() + 100, memory.begin() + 140, '\xff');
+
+    for (auto alphabet : {Base85Alphabet::kZ85, Base85Alphabet::kAscii85}) {
+        for (std::uint64_t size = 0; size < memory.size(); size += 7) {
+
+            std::string expected(simd::Base85EncodedSize(size), '\0');
+            simd::Base85EncodeScalar(expected.data(), reinterpret_cast<unsigned char const *>(memory.data()), size,
+                                     alphabet);
+
+            for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+
+                auto level = static_cast<SimdLevel>(l);
+                std::string text(expected.size(), '\0');
+                simd::Base85Encode(text.data(), memory.data(), size, alphabet, level);
+                ASSERT_EQ(text, expected) << "level: " << SimdLevelToString(level) << ", size: " << size;
+
+                auto groups = size / 4 * 5;
+                std::vector<unsigned char> decoded(size / 4 * 4);
+                EXPECT_EQ(simd::Base85Decode(decoded.data(), text.data(), groups, alphabet, level), groups);
+                EXPECT_EQ(std::string(decoded.begin(), decoded.end()), std::string(memory.data(), decoded.size()))
+                        << "level: " << SimdLevelToString(level) << ", size: " << size;
+            }
+        }
+    }
+}
@@ -0,0 +1,510 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+using namespace headcode::mem;
+
+
+/**
+ * @brief   Formats memory in a canonical layout the slow and obvious way.
+ * The offset digits are left as 'o', see MaskOffsets().
+ * @param   memory      the memory
+ * @param   indent      indent of each line
+ * @return  The canonical lines.
+ */
+template <class Layout>
+static std::string ReferenceCanonical(std::vector<char> const & memory, std::string const & indent) {
+
+    char const * hex = "0123456789abcdef";
+    std::string res;
+    for (std::uint64_t pos = 0; pos < memory.size(); pos += Layout::kBytesPerLine) {
+
+        std::string hex_column;
+        std::string ascii_column;
+        for (std::uint64_t i = 0; i < Layout::kBytesPerLine; ++i) {
+            if ((i > 0) && (i % Layout::kGroupSize == 0)) {
+                hex_column += "  ";
+                ascii_column += ' ';
+            } else if (i > 0) {
+                hex_column += ' ';
+            }
+            if (pos + i < memory.size()) {
+                auto c = static_cast<unsigned char>(memory[pos + i]);
+                hex_column += hex[c >> 4];
+                hex_column += hex[c & 0x0f];
+                ascii_column += ((c >= 0x20) && (c < 0x80)) ? static_cast<char>(c) : '.';
+            } else {
+                hex_column += "  ";
+                ascii_column += ' ';
+            }
+        }
+
+        res += indent + "0x" + std::string(Layout::kOffsetDigits, 'o') + "   " + hex_column;
+        if constexpr (Layout::kAscii) {
+            res += "   |" + ascii_column + "|";
+        }
+        res += '\n';
+    }
+    return res;
+}
+
+
+/**
+ * @brief   Replaces the offset digits of canonical lines by 'o'.
+ * @param   canonical   the canonical lines
+ * @param   indent      indent of each line
+ * @return  The canonical lines without offsets.
+ */
+template <class Layout>
+static std::string MaskOffsets(std::string canonical, std::string const & indent) {
+    auto line_size = CanonicalLineTemplate<Layout>(indent).size();
+    for (std::uint64_t pos = 0; pos < canonical.size(); pos += line_size) {
+        canonical.replace(pos + indent.size() + 2, Layout::kOffsetDigits, Layout::kOffsetDigits, 'o');
+    }
+    return canonical;
+}
+
+
+/**
+ * @brief   Checks a canonical layout at all SIMD levels and through all canonical functions.
+ */
+template <class Layout>
+static void CheckLayout() {
+
+    for (std::uint64_t size : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000, 4099}) {
+
+        auto memory = CreateMemory(size);
+        for (std::string indent : {"", "  "}) {
+
+            auto expected = ReferenceCanonical<Layout>(memory, indent);
+            auto templ = CanonicalLineTemplate<Layout>(indent);
+            auto lines = (size + Layout::kBytesPerLine - 1) / Layout::kBytesPerLine;
+            ASSERT_EQ(lines * templ.size(), expected.size());
+
+            for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+                auto level = static_cast<SimdLevel>(l);
+                std::string canonical(expected.size(), '\0');
+                DumpCanonicalLines<Layout>(
+                        canonical.data(), templ, indent.size(), memory.data(), size, 0, lines, 0, level);
+                EXPECT_EQ(MaskOffsets<Layout>(canonical, indent), expected)
+                        << SimdLevelToString(level) << " " << Layout::kBytesPerLine << "/" << Layout::kGroupSize
+                        << " size " << size;
+            }
+
+            auto canonical = CharArrayToCanonicalString<Layout>(memory.data(), size, indent, false, 0x1000);
+            EXPECT_EQ(MaskOffsets<Layout>(canonical, indent), expected);
+
+            std::ostringstream out;
+            EXPECT_TRUE(CharArrayToCanonicalStream<Layout>(memory.data(), size, out, indent, false, 0x1000));
+            EXPECT_EQ(out.str(), canonical);
+        }
+    }
+}
+
+
+/**
+ * @brief   Reads a whole C file from the start.
+ * @param   file        the file
+ * @return  The content of the file.
+ */
+static std::string ReadFile(std::FILE * file) {
+    std::string content;
+    std::rewind(file);
+    char buffer[4096];
+    for (auto read = std::fread(buffer, 1, sizeof(buffer), file); read > 0;
+         read = std::fread(buffer, 1, sizeof(buffer), file)) {
+        content.append(buffer, read);
+    }
+    return content;
+}
+
+
+TEST(Canonical, StreamToSink) {
+
+    for (std::uint64_t size : {0, 1, 15, 16, 17, 1000, 5003}) {
+
+        auto memory = CreateMemory(size);
+        for (std::string indent : {"", "  ", "memory: "}) {
+
+            auto expected = CharArrayToCanonicalString(memory.data(), size, indent);
+            for (std::uint64_t buffer_size : {0, 1, 80, 81, 1000, 64 * 1024}) {
+
+                std::string streamed;
+                std::uint64_t calls = 0;
+                auto sink = [&](char const * lines, std::uint64_t lines_size) {
+                    EXPECT_LE(lines_size, std::max<std::uint64_t>(buffer_size, 92 + indent.size()));
+                    streamed.append(lines, lines_size);
+                    ++calls;
+                    return true;
+                };
+                EXPECT_TRUE(CharArrayToCanonicalStream(memory.data(), size, sink, indent, buffer_size));
+                EXPECT_EQ(streamed, expected);
+                if (size == 0) {
+                    EXPECT_EQ(calls, 0u);
+                }
+            }
+        }
+    }
+}
+
+
+TEST(Canonical, StreamAbort) {
+
+    auto memory = CreateMemory(1000);
+    std::uint64_t calls = 0;
+    auto sink = [&](char const *, std::uint64_t) {
+        ++calls;
+        return calls < 3;
+    };
+    EXPECT_FALSE(CharArrayToCanonicalStream(memory.data(), memory.size(), sink, {}, 160));
+    EXPECT_EQ(calls, 3u);
+}
+
+
+TEST(Canonical, StreamToOStream) {
+
+    auto memory = CreateMemory(200 * 1024);
+    auto expected = CharArrayToCanonicalString(memory.data(), memory.size(), "> ");
+
+    std::ostringstream out;
+    EXPECT_TRUE(CharArrayToCanonicalStream(memory.data(), memory.size(), out, "> "));
+    EXPECT_EQ(out.str(), expected);
+
+    out.setstate(std::ios::badbit);
+    EXPECT_FALSE(CharArrayToCanonicalStream(memory.data(), memory.size(), out));
+}
+
+
+TEST(Canonical, StreamToFile) {
+
+    auto memory = CreateMemory(200 * 1024);
+    auto expected = CharArrayToCanonicalString(memory.data(), memory.size());
+
+    auto file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    EXPECT_TRUE(CharArrayToCanonicalStream(memory.data(), memory.size(), file));
+    std::fflush(file);
+    EXPECT_EQ(ReadFile(file), expected);
+    std::fclose(file);
+}
+
+
+TEST(Canonical, StreamToFileDescriptor) {
+
+    auto memory = CreateMemory(200 * 1024);
+    auto expected = CharArrayToCanonicalString(memory.data(), memory.size());
+
+    auto file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    EXPECT_TRUE(CharArrayToCanonicalStream(memory.data(), memory.size(), fileno(file)));
+    EXPECT_EQ(ReadFile(file), expected);
+    std::fclose(file);
+
+    EXPECT_FALSE(CharArrayToCanonicalStream(memory.data(), memory.size(), -1));
+}
+
+
+TEST(Canonical, Printable) {
+
+    char const line[] = "\x1f\x20\x7e\x7f\x80\xff\x00\x41" "abc\tdef\n";
+    auto expected = "0x0000000000000000   1f 20 7e 7f 80 ff 00 41  61 62 63 09 64 65 66 0a   |. ~\x7f...A abc.def.|\n";
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+        auto templ = CanonicalLineTemplate({});
+        std::string canonical(templ.size(), '\0');
+        DumpCanonicalLines(canonical.data(), templ, 0, line, 16, 0, 1, 0, static_cast<SimdLevel>(l));
+        EXPECT_EQ(canonical, expected) << SimdLevelToString(static_cast<SimdLevel>(l));
+    }
+}
+
+
+TEST(Canonical, AllLevels) {
+
+    for (std::uint64_t size : {0, 15, 16, 31, 32, 33, 48, 4096, 5003}) {
+
+        auto memory = CreateMemory(size);
+        for (std::string indent : {"", "\t"}) {
+
+            auto templ = CanonicalLineTemplate(indent);
+            auto lines = (size + 15) / 16;
+            std::string expected(lines * templ.size(), '\0');
+            DumpCanonicalLines(expected.data(), templ, indent.size(), memory.data(), size, 0, lines, 0,
+                               SimdLevel::kScalar);
+
+            for (unsigned int l = 1; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+
+                auto level = static_cast<SimdLevel>(l);
+                std::string canonical(expected.size(), '\0');
+                DumpCanonicalLines(canonical.data(), templ, indent.size(), memory.data(), size, 0, lines, 0, level);
+                EXPECT_EQ(canonical, expected) << SimdLevelToString(level) << " size " << size;
+
+                // a range of lines starting in the middle
+                if (lines > 3) {
+                    std::string range(3 * templ.size(), '\0');
+                    DumpCanonicalLines(
+                            range.data(), templ, indent.size(), memory.data(), size, lines - 3, 3, 0, level);
+                    EXPECT_EQ(range, expected.substr((lines - 3) * templ.size()));
+                }
+            }
+        }
+    }
+}
+
+
+TEST(Canonical, Parallel) {
+
+    auto memory = CreateMemory(3 * kParallelMinSize + 17);
+    auto expected = CharArrayToCanonicalString(memory.data(), memory.size(), "  ");
+
+    for (unsigned int threads : {1u, 2u, 3u}) {
+        ThreadPool pool{threads};
+        EXPECT_EQ(CharArrayToCanonicalStringParallel(memory.data(), memory.size(), "  ", 0, pool), expected);
+    }
+
+    std::vector<std::byte> small{std::byte{0x41}, std::byte{0x00}};
+    EXPECT_EQ(MemoryToCanonicalStringParallel(small), MemoryToCanonicalString(small));
+}
+
+
+TEST(Canonical, ParallelNonTemporal) {
+
+    // a canonical line takes more than 5 chars per byte: the result is larger than the last level cache
+    auto memory = CreateMemory(std::max(GetLastLevelCacheSize() / 4, kParallelMinSize) + 5);
+    auto expected = CharArrayToCanonicalString(memory.data(), memory.size());
+
+    ThreadPool pool{2};
+    EXPECT_EQ(CharArrayToCanonicalStringParallel(memory.data(), memory.size(), {}, 0, pool), expected);
+}
+
+TEST(Canonical, CopyNonTemporal) {
+
+    auto memory = CreateMemory(1000);
+    for (std::uint64_t offset : {0, 1, 7, 15}) {
+        for (std::uint64_t size : {0, 1, 15, 16, 17, 33, 900}) {
+            for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+                std::vector<char> copy(1000, '\0');
+                simd::CopyNonTemporal(copy.data() + offset, memory.data(), size, static_cast<SimdLevel>(l));
+                EXPECT_TRUE(std::equal(memory.data(), memory.data() + size, copy.data() + offset));
+                EXPECT_TRUE(std::all_of(copy.begin() + offset + size, copy.end(), [](char c) { return c == 0; }));
+            }
+        }
+    }
+}
+
+
+TEST(Canonical, Squeeze) {
+
+    std::string memory(0x3010, '\0');
+    std::fill(memory.begin() + 0x1000, memory.end(), 'A');
+    memory[0x1234] = 'B';
+
+    auto canonical = CharArrayToCanonicalString(memory.data(), memory.size(), {}, true);
+    auto expected =
+            "\
+0x0000000000000000   00 00 00 00 00 00 00 00  00 00 00 00 00 00 00 00   |........ ........|\n\
+*\n\
+0x0000000000001000   41 41 41 41 41 41 41 41  41 41 41 41 41 41 41 41   |AAAAAAAA AAAAAAAA|\n\
+*\n\
+0x0000000000001230   41 41 41 41 42 41 41 41  41 41 41 41 41 41 41 41   |AAAABAAA AAAAAAAA|\n\
+0x0000000000001240   41 41 41 41 41 41 41 41  41 41 41 41 41 41 41 41   |AAAAAAAA AAAAAAAA|\n\
+*\n\
+0x0000000000003000   41 41 41 41 41 41 41 41  41 41 41 41 41 41 41 41   |AAAAAAAA AAAAAAAA|\n";
+    EXPECT_EQ(canonical, expected);
+
+    // a partial last line is never squeezed
+    canonical = CharArrayToCanonicalString(memory.data(), 0x28, "  ", true);
+    expected =
+            "\
+  0x0000000000000000   00 00 00 00 00 00 00 00  00 00 00 00 00 00 00 00   |........ ........|\n\
+  *\n\
+  0x0000000000000020   00 00 00 00 00 00 00 00                            |........         |\n";
+    EXPECT_EQ(canonical, expected);
+
+    // nothing to squeeze: same as without
+    auto different = CreateMemory(5003);
+    EXPECT_EQ(CharArrayToCanonicalString(different.data(), different.size(), {}, true),
+              CharArrayToCanonicalString(different.data(), different.size()));
+}
+
+
+TEST(Canonical, SqueezeStream) {
+
+    // runs of every length in between distinct lines, streamed through tiny buffers
+    std::vector<char> memory;
+    for (std::uint64_t run = 1; run < 40; ++run) {
+        memory.insert(memory.end(), run * 16, static_cast<char>(run));
+    }
+    memory.insert(memory.end(), 9, 'x');
+    auto expected = CharArrayToCanonicalString(memory.data(), memory.size(), "> ", true);
+
+    for (std::uint64_t buffer_size : {0, 200, 1000, 64 * 1024}) {
+        std::string streamed;
+        auto sink = [&](char const * lines, std::uint64_t lines_size) {
+            streamed.append(lines, lines_size);
+            return true;
+        };
+        EXPECT_TRUE(CharArrayToCanonicalStream(memory.data(), memory.size(), sink, "> ", buffer_size, true));
+        EXPECT_EQ(streamed, expected);
+    }
+
+    // every run shows its first line and a "*", the dump ends with the partial line
+    EXPECT_EQ(std::count(expected.begin(), expected.end(), '\n'), 1 + 38 * 2 + 1);
+    EXPECT_EQ(expected.find("> *\n"), 2 * expected.find('\n') + 2);
+}
+
+
+TEST(Canonical, FindMismatch) {
+
+    auto memory = CreateMemory(1000);
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+        auto level = static_cast<SimdLevel>(l);
+        for (std::uint64_t size : {0, 1, 16, 63, 64, 65, 300, 1000}) {
+            auto copy = memory;
+            EXPECT_EQ(simd::FindMismatch(memory.data(), copy.data(), size, level), size);
+            for (std::uint64_t i : {0, 1, 15, 31, 63, 64, 200, 255, 256, 999}) {
+                if (i < size) {
+                    copy = memory;
+                    copy[i] ^= 0x10;
+                    EXPECT_EQ(simd::FindMismatch(memory.data(), copy.data(), size, level), i)
+                            << SimdLevelToString(level) << " size " << size;
+                }
+            }
+        }
+    }
+}
+
+
+TEST(Canonical, Layouts) {
+    CheckLayout<CanonicalLayoutDefault>();
+    CheckLayout<CanonicalLayout32>();
+    CheckLayout<CanonicalLayout64>();
+    CheckLayout<CanonicalLayout<32, 4, 8, false>>();
+    CheckLayout<CanonicalLayout<16, 4, 8>>();
+    CheckLayout<CanonicalLayout<16, 1, 4>>();
+    CheckLayout<CanonicalLayout<48, 16, 12, false>>();
+    CheckLayout<CanonicalLayout<64, 32, 1>>();
+}
+
+
+TEST(Canonical, LayoutLines) {
+
+    auto memory = CreateMemory(80);
+    for (std::uint64_t i = 0; i < memory.size(); ++i) {
+        memory[i] = static_cast<char>(i);
+    }
+
+    // offsets start at the base address and are cut to 8 digits, no ASCII column
+    auto canonical = CharArrayToCanonicalString<CanonicalLayout<32, 4, 8, false>>(
+            memory.data(), memory.size(), "> ", false, 0x140000000ul);
+    std::string expected =
+            "> 0x40000000   00 01 02 03  04 05 06 07  08 09 0a 0b  0c 0d 0e 0f  "
+            "10 11 12 13  14 15 16 17  18 19 1a 1b  1c 1d 1e 1f\n"
+            "> 0x40000020   20 21 22 23  24 25 26 27  28 29 2a 2b  2c 2d 2e 2f  "
+            "30 31 32 33  34 35 36 37  38 39 3a 3b  3c 3d 3e 3f\n"
+            "> 0x40000040   40 41 42 43  44 45 46 47  48 49 4a 4b  4c 4d 4e 4f  "
+            "                                                  \n";
+    EXPECT_EQ(canonical, expected);
+
+    // 64 bytes in 4 groups of 16 with ASCII column
+    canonical = CharArrayToCanonicalString<CanonicalLayout<64, 16, 4>>(memory.data(), 64, {}, false, 0x300);
+    expected =
+            "0x0300   00 01 02 03 04 05 06 07 08 09 0a 0b 0c 0d 0e 0f  "
+            "10 11 12 13 14 15 16 17 18 19 1a 1b 1c 1d 1e 1f  "
+            "20 21 22 23 24 25 26 27 28 29 2a 2b 2c 2d 2e 2f  "
+            "30 31 32 33 34 35 36 37 38 39 3a 3b 3c 3d 3e 3f   "
+            "|................ ................  !\"#$%&'()*+,-./ 0123456789:;<=>?|\n";
+    EXPECT_EQ(canonical, expected);
+
+    // the default layout is unchanged by a base address other than in the offsets
+    EXPECT_EQ(MaskOffsets<CanonicalLayoutDefault>(CharArrayToCanonicalString(memory.data(), 80, {}, false, 0x5000), {}),
+              MaskOffsets<CanonicalLayoutDefault>(CharArrayToCanonicalString(memory.data(), 80), {}));
+    EXPECT_EQ(CharArrayToCanonicalString(memory.data(), 16, {}, false, 0x5000).substr(0, 20), "0x0000000000005000  ");
+
+    // squeezed and parallel dumps take the layout and base address as well
+    std::vector<char> zeros(4 * 32, '\0');
+    using Layout = CanonicalLayout<32, 4, 8, false>;
+    EXPECT_EQ(CharArrayToCanonicalString<Layout>(zeros.data(), zeros.size(), {}, true, 0x1000),
+              "0x00001000   00 00 00 00  00 00 00 00  00 00 00 00  00 00 00 00  "
+              "00 00 00 00  00 00 00 00  00 00 00 00  00 00 00 00\n"
+              "*\n"
+              "0x00001060   00 00 00 00  00 00 00 00  00 00 00 00  00 00 00 00  "
+              "00 00 00 00  00 00 00 00  00 00 00 00  00 00 00 00\n");
+
+    auto large = CreateMemory(kParallelMinSize + 100);
+    ThreadPool pool{2};
+    EXPECT_EQ((CharArrayToCanonicalStringParallel<CanonicalLayout64>(large.data(), large.size(), {}, 0x1000, pool)),
+              CharArrayToCanonicalString<CanonicalLayout64>(large.data(), large.size(), {}, false, 0x1000));
+}
+
+
+TEST(Canonical, HexNumber) {
+
+    char hex[16];
+    for (auto [number, expected] : std::vector<std::pair<std::uint64_t, std::string>>{
+                 {0x0ul, "0000000000000000"},
+                 {0x0123456789abcdeful, "0123456789abcdef"},
+                 {0xfedcba9876543210ul, "fedcba9876543210"},
+                 {0x000000f000000000ul, "000000f000000000"},
+                 {0xfffffffffffffffful, "ffffffffffffffff"}}) {
+        HexNumberToCharArray(hex, number);
+        EXPECT_EQ(std::string(hex, 16), expected);
+    }
+
+    // counting up rewrites the changed digits only and wraps at 16 digits
+    for (std::uint64_t start : {0x0ul, 0xfff0ul, 0xfffffff0ul, 0xfffffffffffffff0ul, 0x123456789abcdef0ul}) {
+        for (std::uint64_t value : {0x10ul, 0x30ul, 0x40ul, 0x1234ul}) {
+            char expected[16];
+            HexNumberToCharArray(hex, start);
+            EXPECT_EQ(AddToHexCharArray(hex, start, value), start + value);
+            HexNumberToCharArray(expected, start + value);
+            EXPECT_EQ(std::string(hex, 16), std::string(expected, 16));
+        }
+    }
+
+    // digits above the highest byte the carry runs into are not touched
+    HexNumberToCharArray(hex, 0x1f0);
+    std::fill(hex, hex + 12, 'x');
+    EXPECT_EQ(AddToHexCharArray(hex, 0x1f0, 0x10), 0x200u);
+    EXPECT_EQ(std::string(hex, 16), "xxxxxxxxxxxx0200");
+    EXPECT_EQ(AddToHexCharArray(hex, 0x200, 0x10), 0x210u);
+    EXPECT_EQ(std::string(hex, 16), "xxxxxxxxxxxx0210");
+}
+
+
+TEST(Canonical, Offsets) {
+
+    // offsets with digits a to f, beyond 4 GiB and cut off to fewer digits
+    auto memory = CreateMemory(0x40);
+    auto canonical = CharArrayToCanonicalString(memory.data(), memory.size(), {}, false, 0xffffffe0ul);
+    auto line_size = canonical.find('\n') + 1;
+    EXPECT_EQ(canonical.substr(0, 18), "0x00000000ffffffe0");
+    EXPECT_EQ(canonical.substr(line_size, 18), "0x00000000fffffff0");
+    EXPECT_EQ(canonical.substr(2 * line_size, 18), "0x0000000100000000");
+    EXPECT_EQ(canonical.substr(3 * line_size, 18), "0x0000000100000010");
+
+    canonical = CharArrayToCanonicalString<CanonicalLayout<16, 8, 4>>(memory.data(), memory.size(), {}, false, 0xffe0);
+    line_size = canonical.find('\n') + 1;
+    EXPECT_EQ(canonical.substr(0, 6), "0xffe0");
+    EXPECT_EQ(canonical.substr(2 * line_size, 6), "0x0000");
+
+    // a range starting in the middle counts on from its own first offset
+    CanonicalView view{memory.data(), memory.size(), {}, 0xa0};
+    EXPECT_EQ(view.GetLine(3).substr(0, 18), "0x00000000000000d0");
+}
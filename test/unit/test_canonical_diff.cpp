@@ -0,0 +1,172 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+using namespace headcode::mem;
+
+
+/**
+ * @brief   Returns a single line of the canonical representation.
+ * @param   memory      the memory
+ * @param   line        the line
+ * @return  The line (including the '\n').
+ */
+static std::string CanonicalLine(std::vector<std::byte> const & memory, std::uint64_t line) {
+    auto canonical = MemoryToCanonicalString(memory);
+    auto line_size = canonical.find('\n') + 1;
+    return canonical.substr(line * line_size, line_size);
+}
+
+
+TEST(CanonicalDiff, FirstDifference) {
+
+    std::vector<std::byte> a(1000, std::byte{0x41});
+    auto b = a;
+    EXPECT_EQ(FindFirstDifference(a, b), 1000u);
+
+    for (std::uint64_t offset : {0, 1, 15, 16, 63, 64, 500, 999}) {
+        b = a;
+        b[offset] = std::byte{0x42};
+        EXPECT_EQ(FindFirstDifference(a, b), offset);
+    }
+
+    b = a;
+    b.resize(700);
+    EXPECT_EQ(FindFirstDifference(a, b), 700u);
+    EXPECT_EQ(FindFirstDifference(b, a), 700u);
+    EXPECT_EQ(FindFirstDifference(nullptr, 0, nullptr, 0), 0u);
+}
+
+
+TEST(CanonicalDiff, Equal) {
+    std::vector<std::byte> a(1000, std::byte{0x41});
+    EXPECT_TRUE(MemoryDiffToCanonicalString(a, a).empty());
+    EXPECT_TRUE(MemoryDiffToCanonicalString({}, {}).empty());
+}
+
+
+TEST(CanonicalDiff, Interleaved) {
+
+    std::vector<std::byte> a(0x40, std::byte{0x41});
+    auto b = a;
+    b[0x24] = std::byte{0x42};
+
+    auto expected = "*\n"
+                    "  " + CanonicalLine(a, 1) +
+                    "- " + CanonicalLine(a, 2) +
+                    "+ " + CanonicalLine(b, 2) +
+                    "  " + CanonicalLine(a, 3);
+    EXPECT_EQ(MemoryDiffToCanonicalString(a, b, CanonicalDiffStyle::kInterleaved, 1), expected);
+
+    // without context only the differing line is left, with skipped lines on both sides
+    expected = "> *\n"
+               "> - " + CanonicalLine(a, 2) +
+               "> + " + CanonicalLine(b, 2) +
+               "> *\n";
+    EXPECT_EQ(MemoryDiffToCanonicalString(a, b, CanonicalDiffStyle::kInterleaved, 0, "> "), expected);
+}
+
+
+TEST(CanonicalDiff, SideBySide) {
+
+    std::vector<std::byte> a(0x20, std::byte{0x41});
+    auto b = a;
+    b[0x10] = std::byte{0x00};
+
+    auto line_a = CanonicalLine(a, 1);
+    auto line_b = CanonicalLine(b, 1);
+    line_a.pop_back();
+    line_b.pop_back();
+    auto equal = CanonicalLine(a, 0);
+    equal.pop_back();
+
+    auto expected = equal + "   " + equal + "\n" + line_a + " | " + line_b + "\n";
+    EXPECT_EQ(MemoryDiffToCanonicalString(a, b, CanonicalDiffStyle::kSideBySide), expected);
+}
+
+
+TEST(CanonicalDiff, Sizes) {
+
+    std::vector<std::byte> a(0x28, std::byte{0x41});
+    std::vector<std::byte> b(0x40, std::byte{0x41});
+
+    // the partial last line of a differs from the full line of b, the last line of b has no counterpart
+    auto expected = "  " + CanonicalLine(a, 1) +
+                    "- " + CanonicalLine(a, 2) +
+                    "+ " + CanonicalLine(b, 2) +
+                    "+ " + CanonicalLine(b, 3);
+    auto diff = MemoryDiffToCanonicalString(a, b, CanonicalDiffStyle::kInterleaved, 1);
+    EXPECT_EQ(diff, "*\n" + expected);
+
+    // side by side the missing line is left blank
+    diff = MemoryDiffToCanonicalString(b, a, CanonicalDiffStyle::kSideBySide, 0);
+    auto line = CanonicalLine(b, 3);
+    line.pop_back();
+    EXPECT_EQ(diff.substr(diff.rfind("0x0000000000000030")), line + " |\n");
+}
+
+
+TEST(CanonicalDiff, Hunks) {
+
+    std::vector<std::byte> a(1 << 20);
+    for (std::uint64_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<std::byte>(i * 7);
+    }
+    auto b = a;
+    b[100 * 16 + 3] = std::byte{0x01};
+    b[105 * 16] = std::byte{0x02};
+    b[4000 * 16 + 15] = std::byte{0x03};
+
+    // lines 100 and 105 are joined into one hunk, line 4000 is another one
+    auto diff = MemoryDiffToCanonicalString(a, b);
+    std::vector<std::string> lines;
+    for (std::uint64_t pos = 0; pos < diff.size();) {
+        auto end = diff.find('\n', pos) + 1;
+        lines.push_back(diff.substr(pos, end - pos));
+        pos = end;
+    }
+
+    ASSERT_EQ(lines.size(), 1 + (3 + 6 + 2 + 3) + 1 + (3 + 2 + 3) + 1);
+    EXPECT_EQ(lines[0], "*\n");
+    EXPECT_EQ(lines[1], "  " + CanonicalLine(a, 97));
+    EXPECT_EQ(lines[4], "- " + CanonicalLine(a, 100));
+    EXPECT_EQ(lines[5], "+ " + CanonicalLine(b, 100));
+    EXPECT_EQ(lines[10], "- " + CanonicalLine(a, 105));
+    EXPECT_EQ(lines[11], "+ " + CanonicalLine(b, 105));
+    EXPECT_EQ(lines[14], "  " + CanonicalLine(a, 108));
+    EXPECT_EQ(lines[15], "*\n");
+    EXPECT_EQ(lines[19], "- " + CanonicalLine(a, 4000));
+    EXPECT_EQ(lines[20], "+ " + CanonicalLine(b, 4000));
+    EXPECT_EQ(lines.back(), "*\n");
+
+    EXPECT_EQ(FindFirstDifference(a, b), 100u * 16 + 3);
+}
+
+
+TEST(CanonicalDiff, Layout) {
+
+    std::vector<std::byte> a(0x80, std::byte{0x41});
+    auto b = a;
+    b[0x45] = std::byte{0x42};
+
+    using Layout = CanonicalLayout<32, 4, 8, false>;
+    auto canonical_a = MemoryToCanonicalString<Layout>(a);
+    auto canonical_b = MemoryToCanonicalString<Layout>(b);
+    auto line_size = canonical_a.find('\n') + 1;
+
+    auto expected = "*\n- " + canonical_a.substr(2 * line_size, line_size) + "+ " +
+                    canonical_b.substr(2 * line_size, line_size) + "*\n";
+    EXPECT_EQ(MemoryDiffToCanonicalString<Layout>(a, b, CanonicalDiffStyle::kInterleaved, 0), expected);
+}
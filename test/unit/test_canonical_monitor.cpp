@@ -0,0 +1,89 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+using namespace headcode::mem;
+
+
+TEST(CanonicalMonitor, Refresh) {
+
+    auto memory = CreateMemory(5000);
+    CanonicalMonitor monitor{"  ", 0x1000};
+
+    // the first refresh formats all lines
+    auto const & changed = monitor.Refresh(memory.data(), memory.size());
+    EXPECT_EQ(changed.size(), (5000u + 15) / 16);
+    EXPECT_EQ(monitor.GetCanonical(), CharArrayToCanonicalString(memory.data(), memory.size(), "  ", false, 0x1000));
+    EXPECT_EQ(monitor.GetLineCount(), changed.size());
+
+    // nothing changed
+    EXPECT_TRUE(monitor.Refresh(memory.data(), memory.size()).empty());
+
+    // a few bytes in lines 3, 4 and 312 (the last, partial line)
+    memory[3 * 16 + 15] = 'X';
+    memory[4 * 16] = 'Y';
+    memory[4999] = 'Z';
+    EXPECT_EQ(monitor.Refresh(memory.data(), memory.size()), (std::vector<std::uint64_t>{3, 4, 312}));
+    auto expected = CharArrayToCanonicalString(memory.data(), memory.size(), "  ", false, 0x1000);
+    EXPECT_EQ(monitor.GetCanonical(), expected);
+    EXPECT_EQ(monitor.GetLine(4), expected.substr(4 * monitor.GetLineSize(), monitor.GetLineSize()));
+    EXPECT_TRUE(monitor.GetLine(monitor.GetLineCount()).empty());
+
+    // the snapshot has been updated
+    EXPECT_TRUE(monitor.Refresh(memory.data(), memory.size()).empty());
+
+    monitor.Reset();
+    EXPECT_EQ(monitor.Refresh(memory.data(), memory.size()).size(), 313u);
+    EXPECT_EQ(monitor.GetCanonical(), expected);
+}
+
+
+TEST(CanonicalMonitor, Sizes) {
+
+    auto memory = CreateMemory(100);
+    CanonicalMonitor monitor;
+    monitor.Refresh(memory.data(), memory.size());
+
+    // growing: the partial last line and the new lines change
+    memory = CreateMemory(150);
+    EXPECT_EQ(monitor.Refresh(memory.data(), memory.size()), (std::vector<std::uint64_t>{6, 7, 8, 9}));
+    EXPECT_EQ(monitor.GetCanonical(), CharArrayToCanonicalString(memory.data(), memory.size()));
+
+    // shrinking: the new partial line and the dropped lines change
+    memory = CreateMemory(40);
+    EXPECT_EQ(monitor.Refresh(memory.data(), memory.size()),
+              (std::vector<std::uint64_t>{2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(monitor.GetCanonical(), CharArrayToCanonicalString(memory.data(), memory.size()));
+
+    std::vector<std::byte> empty;
+    EXPECT_EQ(monitor.Refresh(empty).size(), 3u);
+    EXPECT_TRUE(monitor.GetCanonical().empty());
+}
+
+
+TEST(CanonicalMonitor, Layout) {
+
+    using Layout = CanonicalLayout<32, 4, 8, false>;
+    auto memory = CreateMemory(1000);
+    BasicCanonicalMonitor<Layout> monitor;
+    monitor.Refresh(memory.data(), memory.size());
+
+    memory[100] = '\0';
+    memory[101] = '\0';
+    EXPECT_EQ(monitor.Refresh(memory.data(), memory.size()), (std::vector<std::uint64_t>{3}));
+    EXPECT_EQ(monitor.GetCanonical(), CharArrayToCanonicalString<Layout>(memory.data(), memory.size()));
+}
@@ -0,0 +1,198 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+using namespace headcode::mem;
+
+
+/**
+ * @brief   Dumps memory in a layout and parses it back.
+ * @param   memory      the memory
+ * @param   indent      indent of each line
+ */
+template <class Layout>
+static void CheckRoundTrip(std::vector<std::byte> const & memory, std::string const & indent) {
+
+    auto canonical = MemoryToCanonicalString<Layout>(memory, indent, false, 0x7000);
+    std::vector<std::byte> parsed{std::byte{0x01}};
+    std::uint64_t base_address = 0;
+    EXPECT_TRUE(CanonicalStringToMemory<Layout>(canonical, parsed, &base_address));
+    EXPECT_EQ(parsed, memory) << Layout::kBytesPerLine << " size " << memory.size() << " indent '" << indent << "'";
+    EXPECT_EQ(base_address, memory.empty() ? 0u : 0x7000u);
+}
+
+
+TEST(CanonicalParse, RoundTrip) {
+
+    for (std::uint64_t size : {0, 1, 15, 16, 17, 100, 4099, 100000}) {
+        auto memory = CreateMemory<std::byte>(size);
+        for (std::string indent : {"", "  ", "\t> "}) {
+            CheckRoundTrip<CanonicalLayoutDefault>(memory, indent);
+            CheckRoundTrip<CanonicalLayout<32, 4, 8, false>>(memory, indent);
+            CheckRoundTrip<CanonicalLayout<64, 16, 4>>(memory, indent);
+        }
+    }
+}
+
+
+TEST(CanonicalParse, Squeezed) {
+
+    std::vector<std::byte> memory(0x3010, std::byte{0x00});
+    for (std::uint64_t i = 0x1000; i < memory.size(); ++i) {
+        memory[i] = std::byte{0x41};
+    }
+    memory[0x2000] = std::byte{0x42};
+
+    auto canonical = MemoryToCanonicalString(memory, "  ", true);
+    ASSERT_NE(canonical.find("  *\n"), std::string::npos);
+    std::vector<std::byte> parsed;
+    EXPECT_TRUE(CanonicalStringToMemory(canonical, parsed));
+    EXPECT_EQ(parsed, memory);
+
+    using Layout = CanonicalLayout<32, 4, 8, false>;
+    std::vector<std::byte> zeros(4 * 32 + 7, std::byte{0x00});
+    canonical = MemoryToCanonicalString<Layout>(zeros, {}, true, 0x1000);
+    std::uint64_t base_address = 0;
+    EXPECT_TRUE(CanonicalStringToMemory<Layout>(canonical, parsed, &base_address));
+    EXPECT_EQ(parsed, zeros);
+    EXPECT_EQ(base_address, 0x1000u);
+
+    // runs of equal lines reaching the end, down to two lines which leave nothing for a "*" to stand for
+    for (std::uint64_t run = 1; run <= 4; ++run) {
+        std::vector<std::byte> tail(16 + run * 16, std::byte{0x00});
+        std::fill_n(tail.begin(), 16, std::byte{0x41});
+        canonical = MemoryToCanonicalString(tail, {}, true);
+        EXPECT_EQ(canonical.find('*') != std::string::npos, run > 2) << canonical;
+        EXPECT_TRUE(CanonicalStringToMemory(canonical, parsed)) << canonical;
+        EXPECT_EQ(parsed, tail);
+
+        using NoAscii = CanonicalLayout<16, 4, 8, false>;
+        canonical = MemoryToCanonicalString<NoAscii>(tail, {}, true);
+        EXPECT_TRUE(CanonicalStringToMemory<NoAscii>(canonical, parsed)) << canonical;
+        EXPECT_EQ(parsed, tail);
+    }
+}
+
+
+TEST(CanonicalParse, Trimmed) {
+
+    // the last line of a dump without ASCII column has trailing blanks which may have been stripped
+    using Layout = CanonicalLayout<32, 4, 8, false>;
+    auto memory = CreateMemory<std::byte>(40);
+    auto canonical = MemoryToCanonicalString<Layout>(memory);
+    canonical.erase(canonical.find_last_not_of(" \n") + 1);
+
+    std::vector<std::byte> parsed;
+    EXPECT_TRUE(CanonicalStringToMemory<Layout>(canonical, parsed));
+    EXPECT_EQ(parsed, memory);
+
+    // a missing last '\n'
+    canonical = MemoryToCanonicalString(memory);
+    canonical.pop_back();
+    EXPECT_TRUE(CanonicalStringToMemory(canonical, parsed));
+    EXPECT_EQ(parsed, memory);
+
+    // a trimmed last line following a "*" line
+    std::vector<std::byte> zeros(3 * 32 + 3, std::byte{0x00});
+    zeros.back() = std::byte{0x01};
+    canonical = MemoryToCanonicalString<Layout>(zeros, {}, true);
+    ASSERT_NE(canonical.find("*\n"), std::string::npos);
+    canonical.erase(canonical.find_last_not_of(" \n") + 1);
+    EXPECT_TRUE(CanonicalStringToMemory<Layout>(canonical, parsed));
+    EXPECT_EQ(parsed, zeros);
+}
+
+
+TEST(CanonicalParse, Invalid) {
+
+    auto memory = CreateMemory<std::byte>(64);
+    auto canonical = MemoryToCanonicalString(memory, "  ");
+    auto line_size = canonical.find('\n') + 1;
+    std::vector<std::byte> parsed;
+    std::uint64_t invalid_position = 0;
+
+    // a bad hex char in the third line, second byte of the second group
+    auto bad = canonical;
+    auto position = 2 * line_size + 2 + 21 + 9 * 3 + 1;
+    bad[position] = 'x';
+    EXPECT_FALSE(CanonicalStringToMemory(bad, parsed, nullptr, &invalid_position));
+    EXPECT_EQ(invalid_position, position);
+    EXPECT_TRUE(parsed.empty());
+
+    // an indent differing in the second line
+    bad = canonical;
+    bad[line_size] = '>';
+    EXPECT_FALSE(CanonicalStringToMemory(bad, parsed, nullptr, &invalid_position));
+    EXPECT_EQ(invalid_position, line_size);
+
+    // a line cut short before the end
+    bad = canonical;
+    bad.erase(line_size + 30, 10);
+    EXPECT_FALSE(CanonicalStringToMemory(bad, parsed, nullptr, &invalid_position));
+    EXPECT_EQ(invalid_position, line_size);
+
+    // a missing line breaks the offsets, at the first offset digit which differs
+    bad = canonical;
+    bad.erase(line_size, line_size);
+    EXPECT_FALSE(CanonicalStringToMemory(bad, parsed, nullptr, &invalid_position));
+    EXPECT_EQ(invalid_position, line_size + 2 + 2 + 14);
+    EXPECT_TRUE(parsed.empty());
+
+    // reordered lines
+    bad = canonical.substr(0, line_size) + canonical.substr(2 * line_size, line_size) +
+          canonical.substr(line_size, line_size) + canonical.substr(3 * line_size);
+    EXPECT_FALSE(CanonicalStringToMemory(bad, parsed, nullptr, &invalid_position));
+    EXPECT_EQ(invalid_position, line_size + 2 + 2 + 14);
+
+    // a "*" at the end cannot tell how many lines are repeated
+    bad = canonical + "  *\n";
+    EXPECT_FALSE(CanonicalStringToMemory(bad, parsed, nullptr, &invalid_position));
+    EXPECT_EQ(invalid_position, bad.size());
+
+    // a partial line which is not the last one
+    bad = MemoryToCanonicalString(CreateMemory<std::byte>(20)) + MemoryToCanonicalString(CreateMemory<std::byte>(16));
+    EXPECT_FALSE(CanonicalStringToMemory(bad, parsed, nullptr, &invalid_position));
+    EXPECT_EQ(invalid_position, bad.find('\n') + 1);
+
+    // no offset at all
+    EXPECT_FALSE(CanonicalStringToMemory("hello world\n", parsed, nullptr, &invalid_position));
+    EXPECT_EQ(invalid_position, 0u);
+    EXPECT_TRUE(CanonicalStringToMemory({}, parsed));
+    EXPECT_TRUE(parsed.empty());
+}
+
+
+TEST(CanonicalParse, Offsets) {
+
+    // "*" lines spanning offsets with digits a to f and wrapping short offsets
+    std::vector<std::byte> zeros(0x200, std::byte{0x00});
+    zeros.back() = std::byte{0x01};
+
+    auto canonical = MemoryToCanonicalString(zeros, {}, true, 0xaf0);
+    std::vector<std::byte> parsed;
+    EXPECT_TRUE(CanonicalStringToMemory(canonical, parsed));
+    EXPECT_EQ(parsed, zeros);
+
+    using Layout = CanonicalLayout<16, 8, 4>;
+    canonical = MemoryToCanonicalString<Layout>(zeros, {}, true, 0xff00);
+    EXPECT_NE(canonical.find("0x00f0"), std::string::npos);
+    std::uint64_t base_address = 0;
+    EXPECT_TRUE(CanonicalStringToMemory<Layout>(canonical, parsed, &base_address));
+    EXPECT_EQ(parsed, zeros);
+    EXPECT_EQ(base_address, 0xff00u);
+}
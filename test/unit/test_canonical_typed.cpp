@@ -0,0 +1,168 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+using namespace headcode::mem;
+
+
+/**
+ * @brief   Formats the typed canonical representation with printf, value by value.
+ * @param   memory          the memory
+ * @param   endian          byte order of the values
+ * @param   indent          indent of each line
+ * @param   base_address    offset shown for the first byte
+ * @return  The typed canonical representation.
+ */
+template <class T>
+static std::string ReferenceTyped(std::vector<char> const & memory,
+                                  Endian endian,
+                                  std::string const & indent,
+                                  std::uint64_t base_address) {
+
+    auto width = static_cast<int>(TypedCanonicalGeometry<T>::kWidth);
+    auto line_size = indent.size() + TypedCanonicalGeometry<T>::kLineSize;
+
+    std::string res;
+    char buffer[64];
+    for (std::uint64_t pos = 0; pos < memory.size(); pos += 16) {
+
+        std::string line = indent;
+        std::snprintf(buffer, sizeof(buffer), "0x%016" PRIx64 "  ", base_address + pos);
+        line += buffer;
+
+        for (std::uint64_t i = pos; (i < pos + 16) && (i < memory.size()); i += sizeof(T)) {
+
+            unsigned char bytes[sizeof(T)] = {};
+            for (std::uint64_t b = 0; (b < sizeof(T)) && (i + b < memory.size()); ++b) {
+                bytes[b] = static_cast<unsigned char>(memory[i + b]);
+            }
+            if (endian != Endian::kNative) {
+                std::reverse(bytes, bytes + sizeof(T));
+            }
+            T value;
+            std::memcpy(&value, bytes, sizeof(T));
+
+            if constexpr (std::is_floating_point_v<T>) {
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                *result.ptr = '\0';
+                std::string number = buffer;
+                line += " " + std::string(static_cast<std::size_t>(width) - number.size(), ' ') + number;
+            } else if constexpr (std::is_signed_v<T>) {
+                std::snprintf(buffer, sizeof(buffer), " %*" PRId64, width, static_cast<std::int64_t>(value));
+                line += buffer;
+            } else {
+                std::snprintf(buffer, sizeof(buffer), " %*" PRIu64, width, static_cast<std::uint64_t>(value));
+                line += buffer;
+            }
+        }
+
+        line.resize(line_size - 1, ' ');
+        res += line + "\n";
+    }
+
+    return res;
+}
+
+
+/**
+ * @brief   Checks a type against the reference for several sizes, both byte orders, indent and base address.
+ */
+template <class T>
+static void CheckTyped() {
+    for (std::uint64_t size : {0, 1, 3, 15, 16, 17, 31, 100, 4099}) {
+        auto memory = CreateMemory(size);
+        for (auto endian : {Endian::kLittle, Endian::kBig}) {
+            EXPECT_EQ(CharArrayToTypedCanonicalString<T>(memory.data(), memory.size(), endian),
+                      ReferenceTyped<T>(memory, endian, {}, 0));
+            EXPECT_EQ(CharArrayToTypedCanonicalString<T>(memory.data(), memory.size(), endian, "    ", 0xfff8),
+                      ReferenceTyped<T>(memory, endian, "    ", 0xfff8));
+        }
+    }
+}
+
+
+TEST(CanonicalTyped, Example) {
+
+    std::vector<std::byte> memory(48);
+    for (std::size_t i = 0; i < memory.size(); ++i) {
+        memory[i] = static_cast<std::byte>(i);
+    }
+
+    std::string expected =
+            "0x0000000000000000       1   515  1029  1543  2057  2571  3085  3599\n"
+            "0x0000000000000010    4113  4627  5141  5655  6169  6683  7197  7711\n"
+            "0x0000000000000020    8225  8739  9253  9767 10281 10795 11309 11823\n";
+    EXPECT_EQ(MemoryToTypedCanonicalString<std::uint16_t>(memory, Endian::kBig), expected);
+
+    expected = "0x0000000000000010    319951120  387323156  454695192  522067228\n";
+    std::vector<std::byte> line{memory.begin() + 16, memory.begin() + 32};
+    EXPECT_EQ(MemoryToTypedCanonicalString<std::uint32_t>(line, Endian::kLittle, {}, 16), expected);
+}
+
+
+TEST(CanonicalTyped, Types) {
+    CheckTyped<std::uint8_t>();
+    CheckTyped<std::int8_t>();
+    CheckTyped<std::uint16_t>();
+    CheckTyped<std::int16_t>();
+    CheckTyped<std::uint32_t>();
+    CheckTyped<std::int32_t>();
+    CheckTyped<std::uint64_t>();
+    CheckTyped<std::int64_t>();
+    CheckTyped<float>();
+    CheckTyped<double>();
+}
+
+
+TEST(CanonicalTyped, Limits) {
+
+    std::int64_t signed_values[] = {std::numeric_limits<std::int64_t>::min(), -1};
+    auto text = CharArrayToTypedCanonicalString<std::int64_t>(reinterpret_cast<char const *>(signed_values),
+                                                              sizeof(signed_values));
+    EXPECT_EQ(text, "0x0000000000000000   -9223372036854775808                   -1\n");
+
+    std::uint64_t unsigned_values[] = {std::numeric_limits<std::uint64_t>::max(), 0};
+    text = CharArrayToTypedCanonicalString<std::uint64_t>(reinterpret_cast<char const *>(unsigned_values),
+                                                          sizeof(unsigned_values));
+    EXPECT_EQ(text, "0x0000000000000000   18446744073709551615                    0\n");
+
+    double doubles[] = {-std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::min()};
+    text = CharArrayToTypedCanonicalString<double>(reinterpret_cast<char const *>(doubles), sizeof(doubles));
+    EXPECT_EQ(text, "0x0000000000000000                    -5e-324 -2.2250738585072014e-308\n");
+
+    float floats[] = {1.5f, -0.0f, std::numeric_limits<float>::infinity(), -1.00000075e-36f};
+    text = CharArrayToTypedCanonicalString<float>(reinterpret_cast<char const *>(floats), sizeof(floats));
+    EXPECT_EQ(text, "0x0000000000000000               1.5              -0             inf -1.00000075e-36\n");
+}
+
+
+TEST(CanonicalTyped, PartialValue) {
+
+    // a value cut off by the end of the memory is padded with zero bytes
+    char memory[] = {1, 2, 3, 4, 5};
+    EXPECT_EQ(CharArrayToTypedCanonicalString<std::uint32_t>(memory, sizeof(memory), Endian::kLittle),
+              "0x0000000000000000     67305985          5                      \n");
+    EXPECT_EQ(CharArrayToTypedCanonicalString<std::uint32_t>(memory, sizeof(memory), Endian::kBig),
+              "0x0000000000000000     16909060   83886080                      \n");
+}
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+#include <shared/create_memory.hpp>
+
+using namespace headcode::mem;
+
+
+TEST(CanonicalView, Empty) {
+
+    CanonicalView view;
+    EXPECT_EQ(view.GetLineCount(), 0u);
+    EXPECT_EQ(view.GetSize(), 0u);
+    EXPECT_TRUE(view.GetLine(0).empty());
+    EXPECT_TRUE(view.begin() == view.end());
+}
+
+
+TEST(CanonicalView, Lines) {
+
+    for (std::uint64_t size : {1, 15, 16, 17, 100, 4099}) {
+
+        auto memory = CreateMemory(size);
+        CanonicalView view{memory.data(), memory.size(), "  "};
+        auto expected = CharArrayToCanonicalString(memory.data(), memory.size(), "  ");
+
+        EXPECT_EQ(view.GetLineCount(), (size + 15) / 16);
+        EXPECT_EQ(view.GetLineCount() * view.GetLineSize(), expected.size());
+        for (std::uint64_t l = 0; l < view.GetLineCount(); ++l) {
+            EXPECT_EQ(view.GetLine(l), expected.substr(l * view.GetLineSize(), view.GetLineSize()));
+        }
+        EXPECT_TRUE(view.GetLine(view.GetLineCount()).empty());
+
+        // backwards and at random lines
+        auto last = view.GetLineCount() - 1;
+        EXPECT_EQ(view[last], expected.substr(last * view.GetLineSize()));
+        EXPECT_EQ(view[last / 2], expected.substr(last / 2 * view.GetLineSize(), view.GetLineSize()));
+        EXPECT_EQ(view[view.GetLineOf(size - 1)], expected.substr(last * view.GetLineSize()));
+    }
+}
+
+
+TEST(CanonicalView, Iterator) {
+
+    auto memory = CreateMemory(1000);
+    CanonicalView view{memory.data(), memory.size()};
+
+    std::string lines;
+    for (auto line : view) {
+        lines += line;
+    }
+    EXPECT_EQ(lines, CharArrayToCanonicalString(memory.data(), memory.size()));
+    EXPECT_EQ(static_cast<std::uint64_t>(std::distance(view.begin(), view.end())), view.GetLineCount());
+
+    // two iterators have buffers of their own
+    auto first = view.begin();
+    auto second = view.begin();
+    second += 5;
+    auto first_line = *first;
+    auto second_line = *second;
+    EXPECT_EQ(first_line, view.GetLine(0));
+    EXPECT_EQ(second_line, view.GetLine(5));
+    EXPECT_EQ(second.GetLine(), 5u);
+}
+
+
+TEST(CanonicalView, Range) {
+
+    auto memory = CreateMemory(5000);
+    std::vector<std::byte> bytes(memory.size());
+    std::transform(memory.begin(), memory.end(), bytes.begin(), [](char c) { return static_cast<std::byte>(c); });
+    CanonicalView view{bytes, "> ", 0x1000};
+    auto expected = CharArrayToCanonicalString(memory.data(), memory.size(), "> ", false, 0x1000);
+
+    std::string lines(10 * view.GetLineSize(), '\0');
+    EXPECT_EQ(view.WriteLines(lines.data(), 100, 10), lines.size());
+    EXPECT_EQ(lines, expected.substr(100 * view.GetLineSize(), lines.size()));
+
+    // a range past the end is cut off
+    auto last = view.GetLineCount() - 2;
+    EXPECT_EQ(view.WriteLines(lines.data(), last, 10), 2 * view.GetLineSize());
+    EXPECT_EQ(lines.substr(0, 2 * view.GetLineSize()), expected.substr(last * view.GetLineSize()));
+    EXPECT_EQ(view.WriteLines(lines.data(), view.GetLineCount(), 10), 0u);
+}
+
+
+TEST(CanonicalView, Layout) {
+
+    using Layout = CanonicalLayout<32, 4, 8, false>;
+    auto memory = CreateMemory(1000);
+    BasicCanonicalView<Layout> view{memory.data(), memory.size(), {}, 0x4000};
+    auto expected = CharArrayToCanonicalString<Layout>(memory.data(), memory.size(), {}, false, 0x4000);
+
+    EXPECT_EQ(view.GetLineCount(), (1000u + 31) / 32);
+    std::string lines;
+    for (auto line : view) {
+        lines += line;
+    }
+    EXPECT_EQ(lines, expected);
+    EXPECT_EQ(view.GetLine(1).substr(0, 10), "0x00004020");
+}
@@ -0,0 +1,131 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+using namespace headcode::mem;
+
+
+/**
+ * @brief   Upper case hex in groups of 3 bytes with prefix and a two char separator (no SIMD kernel).
+ */
+struct HexFormatOdd {
+    static constexpr bool kUpperCase = true;
+    static constexpr std::uint64_t kGroupSize = 3;
+    static constexpr std::string_view kPrefix{"#"};
+    static constexpr std::string_view kSeparator{"--"};
+};
+
+
+/**
+ * @brief   Formats memory the slow way: plain hex of each group pasted together.
+ * @tparam  Format      the hex format
+ * @param   memory      the memory
+ * @param   size        size of the memory
+ * @return  the formatted hex
+ */
+template <class Format>
+static std::string ReferenceFormat(char const * memory, std::uint64_t size) {
+    std::string result;
+    for (std::uint64_t i = 0; i < size; i += Format::kGroupSize) {
+        if (i > 0) {
+            result += Format::kSeparator;
+        }
+        result += Format::kPrefix;
+        auto hex = MemoryToHex(memory + i, std::min<std::uint64_t>(Format::kGroupSize, size - i));
+        if (Format::kUpperCase) {
+            for (auto & c : hex) {
+                c = static_cast<char>(std::toupper(c));
+            }
+        }
+        result += hex;
+    }
+    return result;
+}
+
+
+/**
+ * @brief   Checks a format against the reference on all SimdLevels and many sizes.
+ * @tparam  Format      the hex format
+ */
+template <class Format>
+static void CheckFormat() {
+
+    std::vector<char> memory(300);
+    for (std::size_t i = 0; i < memory.size(); ++i) {
+        memory[i] = static_cast<char>((i * 7919u) >> 3u);
+    }
+
+    for (std::uint64_t size = 0; size < memory.size(); ++size) {
+        auto expected = ReferenceFormat<Format>(memory.data(), size);
+        ASSERT_EQ(FormattedHexSize<Format>(size), expected.size());
+        for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+            auto level = static_cast<SimdLevel>(l);
+            std::string hex(expected.size(), '\0');
+            simd::HexFormat<Format>(hex.data(), memory.data(), size, level);
+            ASSERT_EQ(hex, expected) << "level: " << SimdLevelToString(level) << ", size: " << size;
+        }
+    }
+}
+
+
+TEST(HexFormat, Examples) {
+
+    char const data[] = {'\xde', '\xad', '\xbe', '\xef', '\xca', '\xfe'};
+
+    EXPECT_EQ(MemoryToFormattedHex<HexFormatPacked>(data, 6), "deadbeefcafe");
+    EXPECT_EQ(MemoryToFormattedHex<HexFormatPackedUpper>(data, 6), "DEADBEEFCAFE");
+    EXPECT_EQ(MemoryToFormattedHex<HexFormatColon>(data, 6), "de:ad:be:ef:ca:fe");
+    EXPECT_EQ(MemoryToFormattedHex<HexFormatCArray>(data, 4), "0xde, 0xad, 0xbe, 0xef");
+    EXPECT_EQ(MemoryToFormattedHex<HexFormatGrouped<2>>(data, 6), "dead beef cafe");
+    EXPECT_EQ((MemoryToFormattedHex<HexFormatGrouped<4, true>>(data, 6)), "DEADBEEF CAFE");
+    EXPECT_EQ(MemoryToFormattedHex<HexFormatOdd>(data, 5), "#DEADBE--#EFCA");
+    EXPECT_EQ(MemoryToFormattedHex<HexFormatCArray>(data, 0), "");
+
+    std::vector<std::byte> memory{std::byte{0x01}, std::byte{0x02}};
+    EXPECT_EQ(MemoryToFormattedHex<HexFormatColon>(memory), "01:02");
+}
+
+
+TEST(HexFormat, AllLevels) {
+    CheckFormat<HexFormatPacked>();
+    CheckFormat<HexFormatPackedUpper>();
+    CheckFormat<HexFormatColon>();
+    CheckFormat<HexFormatCArray>();
+    CheckFormat<HexFormatGrouped<2>>();
+    CheckFormat<HexFormatGrouped<4, true>>();
+    CheckFormat<HexFormatGrouped<8>>();
+    CheckFormat<HexFormatGrouped<16>>();
+    CheckFormat<HexFormatOdd>();
+}
+
+
+TEST(HexFormat, Buffer) {
+
+    char const data[] = {'\xde', '\xad', '\xbe', '\xef', '\xca', '\xfe'};
+    auto full = MemoryToFormattedHex<HexFormatOdd>(data, 6);
+
+    for (std::uint64_t capacity = 0; capacity <= full.size() + 2; ++capacity) {
+
+        std::string buffer(capacity + 1, '!');
+        auto converted = MemoryToFormattedHex<HexFormatOdd>(buffer.data(), capacity, data, 6);
+        auto expected = MemoryToFormattedHex<HexFormatOdd>(data, converted);
+        EXPECT_LE(expected.size(), capacity);
+        EXPECT_EQ(buffer.substr(0, expected.size()), expected) << "capacity: " << capacity;
+        EXPECT_EQ(buffer[expected.size()], '!');
+        if (converted < 6) {
+            EXPECT_GT(FormattedHexSize<HexFormatOdd>(converted + 1), capacity) << "capacity: " << capacity;
+        }
+    }
+}
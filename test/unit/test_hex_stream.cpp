@@ -0,0 +1,177 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+#include <shared/ipsum_lorem.hpp>
+
+using namespace headcode::mem;
+
+
+/**
+ * @brief   Runs a whole string through a HexDecoder in chunks.
+ * @param   decoder         the decoder
+ * @param   hex             the hex string
+ * @param   chunk_size      size of the chunks fed
+ * @return  the memory decoded
+ */
+static std::vector<std::byte> DecodeChunked(HexDecoder & decoder, std::string const & hex, std::uint64_t chunk_size) {
+
+    std::vector<std::byte> memory;
+    for (std::uint64_t offset = 0; offset < hex.size(); offset += chunk_size) {
+
+        std::string_view rest{hex.data() + offset, std::min<std::uint64_t>(chunk_size, hex.size() - offset)};
+        while (!rest.empty()) {
+            auto consumed = decoder.Decode(rest);
+            rest.remove_prefix(consumed);
+            memory.insert(memory.end(), decoder.GetOutput(), decoder.GetOutput() + decoder.GetOutputSize());
+            decoder.ClearOutput();
+            if (consumed == 0) {
+                return memory;
+            }
+        }
+    }
+    return memory;
+}
+
+
+TEST(HexStream, EncodeChunked) {
+
+    auto const & text = IPSUM_LOREM_TEXT;
+    auto expected = MemoryToHex(text.data(), text.size());
+
+    for (std::uint64_t window_size : {2u, 7u, 64u, 1000u, 100000u}) {
+        for (std::uint64_t chunk_size : {1u, 13u, 256u, 5000u}) {
+
+            HexEncoder encoder{window_size};
+            std::string hex;
+            for (std::uint64_t offset = 0; offset < text.size(); offset += chunk_size) {
+                auto data = text.data() + offset;
+                auto size = std::min<std::uint64_t>(chunk_size, text.size() - offset);
+                while (size > 0) {
+                    auto consumed = encoder.Encode(data, size);
+                    data += consumed;
+                    size -= consumed;
+                    if (encoder.GetFree() < 2) {
+                        hex.append(encoder.GetOutput(), encoder.GetOutputSize());
+                        encoder.ClearOutput();
+                    }
+                }
+            }
+            hex.append(encoder.GetOutput(), encoder.GetOutputSize());
+
+            EXPECT_EQ(hex, expected) << "window: " << window_size << ", chunk: " << chunk_size;
+            EXPECT_EQ(encoder.GetPosition(), text.size());
+            EXPECT_LE(encoder.GetWindowSize(), std::max<std::uint64_t>(window_size, 2u));
+        }
+    }
+}
+
+
+TEST(HexStream, DecodeChunked) {
+
+    auto const & text = IPSUM_LOREM_TEXT;
+    auto hex = MemoryToHex(text.data(), text.size());
+    auto expected = StringToMemory(text);
+
+    for (std::uint64_t window_size : {1u, 7u, 64u, 100000u}) {
+        for (std::uint64_t chunk_size : {1u, 3u, 13u, 256u, 5001u}) {
+            for (bool strict : {false, true}) {
+                HexDecoder decoder{window_size, strict};
+                EXPECT_EQ(DecodeChunked(decoder, hex, chunk_size), expected)
+                        << "window: " << window_size << ", chunk: " << chunk_size;
+                EXPECT_FALSE(decoder.HasPending());
+                EXPECT_TRUE(decoder.Finish());
+                EXPECT_EQ(decoder.GetPosition(), hex.size());
+            }
+        }
+    }
+}
+
+
+TEST(HexStream, DecodeDanglingNibble) {
+
+    HexDecoder decoder;
+    EXPECT_EQ(decoder.Decode("dea"), 3u);
+    EXPECT_TRUE(decoder.HasPending());
+    EXPECT_EQ(decoder.GetOutputSize(), 1u);
+    EXPECT_EQ(decoder.Decode("d"), 1u);
+    EXPECT_FALSE(decoder.HasPending());
+    EXPECT_EQ(decoder.Decode("b"), 1u);
+    EXPECT_EQ(decoder.Decode("eef"), 3u);
+    EXPECT_EQ(decoder.GetOutputSize(), 4u);
+    EXPECT_EQ(decoder.GetOutput()[0], std::byte{0xde});
+    EXPECT_EQ(decoder.GetOutput()[1], std::byte{0xad});
+    EXPECT_EQ(decoder.GetOutput()[2], std::byte{0xbe});
+    EXPECT_EQ(decoder.GetOutput()[3], std::byte{0xef});
+
+    EXPECT_TRUE(decoder.Finish());
+
+    decoder.Reset();
+    EXPECT_EQ(decoder.Decode("abc"), 3u);
+    EXPECT_TRUE(decoder.IsValid());
+    EXPECT_FALSE(decoder.Finish());
+    EXPECT_EQ(decoder.GetInvalidPosition(), 2u);
+
+    decoder.Reset();
+    EXPECT_EQ(decoder.Decode("1"), 1u);
+    EXPECT_EQ(decoder.Decode("x"), 1u);
+    EXPECT_FALSE(decoder.Finish());
+    EXPECT_EQ(decoder.GetInvalidPosition(), 1u);
+    EXPECT_EQ(decoder.GetOutput()[0], std::byte{0x10});
+}
+
+
+TEST(HexStream, DecodeCompatible) {
+
+    HexDecoder decoder;
+    EXPECT_EQ(DecodeChunked(decoder, "BAr116fx", 3), HexToMemory("BAr116fx"));
+    EXPECT_FALSE(decoder.IsValid());
+    EXPECT_EQ(decoder.GetInvalidPosition(), 2u);
+    EXPECT_FALSE(decoder.Finish());
+}
+
+
+TEST(HexStream, DecodeStrict) {
+
+    HexDecoder decoder{64, true};
+    EXPECT_TRUE(decoder.IsStrict());
+    EXPECT_EQ(decoder.Decode("0011"), 4u);
+    EXPECT_EQ(decoder.Decode("223"), 3u);
+    EXPECT_EQ(decoder.Decode("x44"), 0u);
+    EXPECT_FALSE(decoder.IsValid());
+    EXPECT_EQ(decoder.GetInvalidPosition(), 7u);
+    EXPECT_EQ(decoder.GetOutputSize(), 3u);
+    EXPECT_EQ(decoder.Decode("44"), 0u);
+
+    decoder.Reset();
+    EXPECT_EQ(decoder.Decode("0011g"), 4u);
+    EXPECT_EQ(decoder.GetInvalidPosition(), 4u);
+
+    decoder.Reset();
+    EXPECT_EQ(decoder.Decode("00112233445566778899aabbccddeeff00112233445566778899aabbccddeeff_0"), 64u);
+    EXPECT_EQ(decoder.GetInvalidPosition(), 64u);
+    EXPECT_EQ(decoder.GetOutputSize(), 32u);
+
+    // the bytes before an invalid char are written, also over stale data in a reused window
+    HexDecoder reused{4096, true};
+    EXPECT_EQ(reused.Decode(std::string(64, 'f')), 64u);
+    reused.ClearOutput();
+    EXPECT_EQ(reused.Decode(std::string(40, '0') + "g" + std::string(23, '0')), 40u);
+    EXPECT_EQ(reused.GetInvalidPosition(), 104u);
+    ASSERT_EQ(reused.GetOutputSize(), 20u);
+    for (std::uint64_t i = 0; i < reused.GetOutputSize(); ++i) {
+        EXPECT_EQ(reused.GetOutput()[i], std::byte{0x00}) << "byte " << i;
+    }
+}
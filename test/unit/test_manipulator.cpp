@@ -6,6 +6,13 @@
  * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
  */
 
+#include <array>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <headcode/mem/mem.hpp>
@@ -686,3 +693,312 @@ TEST(TestManipulator, TruncatedReadString) {
     EXPECT_EQ(s.size(), 3u);
     EXPECT_STREQ(s.c_str(), "abc");
 }
+
+
+TEST(TestManipulator, GrowthPolicies) {
+
+    EXPECT_EQ(GrowthPolicy{}.GetCapacity(0, 4), 4u);
+    EXPECT_EQ(GrowthPolicy{}.GetCapacity(100, 101), 200u);
+    EXPECT_EQ(GrowthPolicy{}.GetCapacity(100, 500), 500u);
+    EXPECT_EQ(GrowthPolicy::Geometric(1.5).GetCapacity(100, 101), 150u);
+    EXPECT_EQ(GrowthPolicy::Geometric(0.5).GetCapacity(100, 101), 101u);
+    EXPECT_EQ(GrowthPolicy::Chunk(64).GetCapacity(64, 65), 128u);
+    EXPECT_EQ(GrowthPolicy::Chunk(64).GetCapacity(0, 200), 256u);
+    EXPECT_EQ(GrowthPolicy::Chunk(0).GetCapacity(64, 65), 65u);
+    EXPECT_EQ(GrowthPolicy::Exact().GetCapacity(100, 101), 101u);
+    EXPECT_EQ(GrowthPolicy::Custom([](std::uint64_t c, std::uint64_t r) { return c + r; }).GetCapacity(100, 101),
+              201u);
+    EXPECT_EQ(GrowthPolicy::Custom([](std::uint64_t, std::uint64_t) { return 0u; }).GetCapacity(100, 101), 101u);
+    EXPECT_EQ(GrowthPolicy::Custom({}).GetCapacity(100, 101), 101u);
+}
+
+
+TEST(TestManipulator, GrowthSmallWrites) {
+
+    // count the reallocations of many small writes
+    auto count_reallocations = [](GrowthPolicy policy, std::vector<std::byte> & memory) {
+        headcode::mem::MemoryManipulator manipulator{memory, std::move(policy)};
+        std::uint64_t reallocations = 0;
+        for (std::uint32_t i = 0; i < 10'000; ++i) {
+            auto data = memory.data();
+            manipulator << i;
+            reallocations += (memory.data() != data) ? 1 : 0;
+        }
+        manipulator.Reset();
+        for (std::uint32_t i = 0; i < 10'000; ++i) {
+            std::uint32_t value = 0;
+            manipulator >> value;
+            EXPECT_EQ(value, i);
+        }
+        return reallocations;
+    };
+
+    std::vector<std::byte> geometric;
+    EXPECT_LE(count_reallocations(GrowthPolicy{}, geometric), 20u);
+    EXPECT_EQ(geometric.size(), 40'000u);
+
+    std::vector<std::byte> chunked;
+    EXPECT_LE(count_reallocations(GrowthPolicy::Chunk(4096), chunked), 10u);
+    EXPECT_EQ(chunked.capacity(), 40'960u);
+
+    std::vector<std::byte> exact;
+    EXPECT_EQ(count_reallocations(GrowthPolicy::Exact(), exact), 10'000u);
+    EXPECT_EQ(exact.capacity(), 40'000u);
+
+    std::uint64_t calls = 0;
+    std::vector<std::byte> custom;
+    auto policy = GrowthPolicy::Custom([&](std::uint64_t capacity, std::uint64_t required) {
+        ++calls;
+        return std::max(capacity * 4, required);
+    });
+    EXPECT_EQ(count_reallocations(policy, custom), calls);
+    EXPECT_LE(calls, 10u);
+}
+
+
+TEST(TestManipulator, GrowthPolicyCopied) {
+
+    std::vector<std::byte> memory;
+    headcode::mem::MemoryManipulator manipulator{memory, GrowthPolicy::Chunk(1024)};
+    headcode::mem::MemoryManipulator copy{manipulator};
+    copy << std::uint8_t{1};
+    EXPECT_EQ(memory.capacity(), 1024u);
+
+    manipulator.SetGrowthPolicy(GrowthPolicy::Exact());
+    manipulator.SetPosition(memory.size());
+    manipulator.Add(IPSUM_LOREM_TEXT.data(), 2000);
+    EXPECT_EQ(memory.capacity(), 2001u);
+}
+
+
+/**
+ * @brief   Writes a vector item by item as the manipulator did before containers were copied in bulk.
+ * @param   items           the items
+ * @param   endian_aware    endian conversion flag
+ * @return  The memory written.
+ */
+template <class T>
+static std::vector<std::byte> WriteItemByItem(std::vector<T> const & items, bool endian_aware) {
+    std::vector<std::byte> memory;
+    headcode::mem::MemoryManipulator manipulator{memory};
+    manipulator.SetEndianAware(endian_aware);
+    manipulator << static_cast<std::uint64_t>(items.size());
+    for (auto item : items) {
+        manipulator << item;
+    }
+    return memory;
+}
+
+
+/**
+ * @brief   Checks that a vector copied in bulk gives the same memory as written item by item and reads back.
+ * @param   items           the items
+ */
+template <class T>
+static void CheckBulkVector(std::vector<T> const & items) {
+    for (auto endian_aware : {false, true}) {
+        std::vector<std::byte> memory{std::byte{0xaa}, std::byte{0xbb}};
+        headcode::mem::MemoryManipulator manipulator{memory};
+        manipulator.SetEndianAware(endian_aware);
+        manipulator << items;
+        EXPECT_EQ(memory, WriteItemByItem(items, endian_aware));
+
+        std::vector<T> read{T{1}};
+        manipulator.Reset();
+        manipulator >> read;
+        EXPECT_EQ(read, items);
+        EXPECT_TRUE(manipulator.IsEOF());
+    }
+}
+
+
+TEST(TestManipulator, BulkVector) {
+
+    std::vector<std::uint32_t> numbers;
+    std::vector<double> doubles;
+    std::vector<std::int16_t> shorts;
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        numbers.push_back(i * 0x01020305u);
+        doubles.push_back(i * -1.25);
+        shorts.push_back(static_cast<std::int16_t>(i * 77));
+    }
+    CheckBulkVector(numbers);
+    CheckBulkVector(doubles);
+    CheckBulkVector(shorts);
+    CheckBulkVector(std::vector<float>{1.5f, -2.0f, 3.25f});
+    CheckBulkVector(std::vector<std::uint64_t>{0x0102030405060708ul, 0xfffffffffffffffful});
+    CheckBulkVector(std::vector<unsigned char>{1, 2, 3});
+    CheckBulkVector(std::vector<std::uint16_t>{});
+}
+
+
+TEST(TestManipulator, BulkVectorOfBool) {
+
+    std::vector<bool> bits{true, false, false, true, true};
+    std::vector<bool> read;
+
+    std::vector<std::byte> memory;
+    headcode::mem::MemoryManipulator manipulator{memory};
+    manipulator << bits;
+    manipulator.Reset();
+    manipulator >> read;
+    EXPECT_EQ(read, bits);
+    EXPECT_EQ(memory.size(), sizeof(std::uint64_t) + bits.size());
+}
+
+
+TEST(TestManipulator, BulkTruncatedVector) {
+
+    std::vector<std::byte> memory;
+    headcode::mem::MemoryManipulator manipulator{memory};
+    manipulator << std::vector<std::uint32_t>{1, 2, 3};
+    memory.resize(memory.size() - 2);
+
+    // only the items which are there completely are read
+    std::vector<std::uint32_t> read;
+    manipulator.Reset();
+    manipulator >> read;
+    EXPECT_EQ(read, (std::vector<std::uint32_t>{1, 2}));
+    EXPECT_EQ(manipulator.GetRemaining(), 2u);
+}
+
+
+TEST(TestManipulator, BulkArrays) {
+
+    std::array<std::uint32_t, 3> array{0x01020304, 0x05060708, 0x090a0b0c};
+    double c_array[2] = {0.5, -8.0};
+    std::array<std::string, 2> strings{"apple", "banana"};
+
+    std::vector<std::byte> memory;
+    headcode::mem::MemoryManipulator manipulator{memory};
+    manipulator.SetEndianAware(true);
+    manipulator << array << c_array << strings << "foo";
+
+    // arrays are written without their size, string literals are strings still
+    EXPECT_EQ(memory.size(), 3 * 4 + 2 * 8 + (8 + 5) + (8 + 6) + (8 + 3));
+    EXPECT_EQ(memory[0], std::byte{0x01});
+    EXPECT_EQ(memory[3], std::byte{0x04});
+
+    std::array<std::uint32_t, 3> array_read{};
+    double c_array_read[2] = {};
+    std::array<std::string, 2> strings_read;
+    std::string foo;
+    manipulator.Reset();
+    manipulator >> array_read >> c_array_read >> strings_read >> foo;
+    EXPECT_EQ(array_read, array);
+    EXPECT_EQ(c_array_read[0], 0.5);
+    EXPECT_EQ(c_array_read[1], -8.0);
+    EXPECT_EQ(strings_read, strings);
+    EXPECT_EQ(foo, "foo");
+
+    // an array not covered by the data left reads the whole items only
+    std::uint16_t shorts[4] = {7, 7, 7, 7};
+    manipulator.SetPosition(memory.size() - 5);
+    manipulator >> shorts;
+    EXPECT_EQ(shorts[0], 3u);
+    EXPECT_EQ(shorts[1], ('f' << 8) + 'o');
+    EXPECT_EQ(shorts[2], 7u);
+    EXPECT_EQ(shorts[3], 7u);
+}
+
+
+struct Point {
+    std::int32_t x;
+    std::int32_t y;
+};
+
+struct NotOptedIn {
+    std::int32_t x;
+};
+
+namespace headcode::mem {
+template <>
+struct IsManipulatorRaw<Point> : std::true_type {};
+}
+
+
+TEST(TestManipulator, BulkRawClasses) {
+
+    // only classes opted in are taken as they are in memory
+    static_assert(kIsManipulatorRawClass<Point>);
+    static_assert(!kIsManipulatorRawClass<NotOptedIn>);
+    static_assert(!kIsManipulatorRawClass<std::string_view>);
+    static_assert(!kIsManipulatorRawClass<std::optional<std::int32_t>>);
+    static_assert(!kIsManipulatorBulk<std::string_view>);
+
+    std::vector<Point> points{{1, 2}, {3, -4}, {-5, 6}};
+    Point single{7, 8};
+
+    std::vector<std::byte> memory;
+    headcode::mem::MemoryManipulator manipulator{memory};
+    manipulator.SetEndianAware(true);
+    manipulator << points << single;
+
+    EXPECT_EQ(memory.size(), sizeof(std::uint64_t) + 4 * sizeof(Point));
+    EXPECT_EQ(std::memcmp(memory.data() + sizeof(std::uint64_t), points.data(), 3 * sizeof(Point)), 0);
+
+    std::vector<Point> points_read;
+    Point single_read{};
+    manipulator.Reset();
+    manipulator >> points_read >> single_read;
+    ASSERT_EQ(points_read.size(), 3u);
+    EXPECT_EQ(points_read[1].x, 3);
+    EXPECT_EQ(points_read[1].y, -4);
+    EXPECT_EQ(single_read.x, 7);
+    EXPECT_EQ(single_read.y, 8);
+}
+
+
+TEST(TestManipulator, CompileTimeEndian) {
+
+    std::vector<std::byte> runtime_memory;
+    headcode::mem::MemoryManipulator runtime{runtime_memory};
+    runtime.SetEndianAware(true);
+
+    std::vector<std::byte> big_memory;
+    headcode::mem::BasicMemoryManipulator<ManipulatorEndian::kBig> big{big_memory};
+    std::vector<std::byte> little_memory;
+    headcode::mem::BasicMemoryManipulator<ManipulatorEndian::kLittle> little{little_memory};
+    std::vector<std::byte> native_memory;
+    headcode::mem::BasicMemoryManipulator<ManipulatorEndian::kNative> native{native_memory};
+
+    EXPECT_EQ(big.IsEndianAware(), Endian::kNative != Endian::kBig);
+    EXPECT_EQ(little.IsEndianAware(), Endian::kNative != Endian::kLittle);
+    EXPECT_FALSE(native.IsEndianAware());
+
+    std::vector<double> doubles{1.5, -2.25};
+    runtime << static_cast<std::uint32_t>(0x01020304) << static_cast<std::int16_t>(0x0506) << 0.5f << doubles;
+    big << static_cast<std::uint32_t>(0x01020304) << static_cast<std::int16_t>(0x0506) << 0.5f << doubles;
+    little << static_cast<std::uint32_t>(0x01020304) << static_cast<std::int16_t>(0x0506) << 0.5f << doubles;
+    native << static_cast<std::uint32_t>(0x01020304) << static_cast<std::int16_t>(0x0506) << 0.5f << doubles;
+
+    EXPECT_EQ(big_memory, runtime_memory);
+    EXPECT_EQ(big_memory[0], std::byte{0x01});
+    EXPECT_EQ(big_memory[3], std::byte{0x04});
+    EXPECT_EQ(little_memory[0], std::byte{0x04});
+    EXPECT_EQ(little_memory[3], std::byte{0x01});
+    EXPECT_EQ(little_memory[4], std::byte{0x06});
+    EXPECT_EQ(native_memory, Endian::kNative == Endian::kBig ? big_memory : little_memory);
+
+    // the size of the vector is a number in the byte order as well
+    EXPECT_EQ(big_memory[10 + 7], std::byte{2});
+    EXPECT_EQ(little_memory[10], std::byte{2});
+
+    for (auto memory : {&big_memory, &little_memory}) {
+        std::uint32_t u = 0;
+        std::int16_t i = 0;
+        float f = 0.0f;
+        std::vector<double> d;
+        if (memory == &big_memory) {
+            big.Reset();
+            big >> u >> i >> f >> d;
+        } else {
+            little.Reset();
+            little >> u >> i >> f >> d;
+        }
+        EXPECT_EQ(u, 0x01020304u);
+        EXPECT_EQ(i, 0x0506);
+        EXPECT_EQ(f, 0.5f);
+        EXPECT_EQ(d, doubles);
+    }
+}
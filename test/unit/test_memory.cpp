@@ -6,6 +6,10 @@
  * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
  */
 
+#include <array>
+#include <atomic>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <headcode/mem/mem.hpp>
@@ -147,6 +151,158 @@ TEST(Memory, HexToMemory_illegal) {
 }
 
 
+TEST(Memory, HexToMemoryUpperCase) {
+
+    std::vector<std::byte> memory{std::byte{0xab}, std::byte{0xcd}, std::byte{0xef}, std::byte{0xde}};
+    EXPECT_EQ(memory, HexToMemory("ABCDEFDE"));
+    EXPECT_EQ(memory, HexToMemory("aBcDeFdE"));
+    EXPECT_EQ(0xde, static_cast<unsigned char>(HexToByte("DE")));
+    EXPECT_EQ(0xef, static_cast<unsigned char>(HexToByte("EF")));
+}
+
+
+TEST(Memory, HexToMemoryStrict) {
+
+    std::vector<std::byte> memory;
+    std::uint64_t invalid_position = 0;
+
+    EXPECT_TRUE(HexToMemoryStrict("116f7f44BDDC108129e6f95e7e5420da", memory, &invalid_position));
+    EXPECT_STREQ(MemoryToHex(memory).c_str(), "116f7f44bddc108129e6f95e7e5420da");
+
+    EXPECT_FALSE(HexToMemoryStrict("116ffoo", memory, &invalid_position));
+    EXPECT_EQ(invalid_position, 5u);
+    EXPECT_TRUE(memory.empty());
+
+    EXPECT_FALSE(HexToMemoryStrict("BAr116fx", memory, &invalid_position));
+    EXPECT_EQ(invalid_position, 2u);
+
+    EXPECT_FALSE(HexToMemoryStrict("116", memory, &invalid_position));
+    EXPECT_EQ(invalid_position, 2u);
+
+    std::string long_hex(1000, 'a');
+    long_hex[777] = 'g';
+    EXPECT_FALSE(HexToMemoryStrict(long_hex, memory, &invalid_position));
+    EXPECT_EQ(invalid_position, 777u);
+    EXPECT_FALSE(HexToMemoryStrict(long_hex, memory));
+
+    EXPECT_TRUE(HexToMemoryStrict("", memory, &invalid_position));
+    EXPECT_TRUE(memory.empty());
+}
+
+
+TEST(Memory, ByteToHexChars) {
+
+    static_assert(ByteToHexChars(std::byte{0xa7})[0] == 'a');
+    static_assert(ByteToHexChars(std::byte{0xa7})[1] == '7');
+    static_assert(CharToHexChars(0x0f)[0] == '0');
+    static_assert(CharToHexChars(0x0f)[1] == 'f');
+
+    for (int i = 0; i < 256; ++i) {
+        auto chars = CharToHexChars(static_cast<unsigned char>(i));
+        EXPECT_EQ(std::string(chars.data(), chars.size()), MemoryToHex(std::vector<std::byte>{std::byte(i)}));
+        EXPECT_EQ(CharToHex(static_cast<unsigned char>(i)), std::string(chars.data(), chars.size()));
+        EXPECT_EQ(ByteToHex(std::byte(i)), std::string(chars.data(), chars.size()));
+    }
+}
+
+
+TEST(Memory, ByteToHexConcurrentFirstUse) {
+
+    std::vector<std::thread> threads;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 256; ++i) {
+                if (ByteToHex(std::byte(i)).size() != 2) {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(failures, 0);
+}
+
+
+TEST(Memory, MemoryToHexBuffer) {
+
+    std::string text{"The quick brown fox"};
+    char buffer[64];
+
+    EXPECT_EQ(MemoryToHex(buffer, sizeof(buffer), text.data(), text.size()), text.size() * 2);
+    EXPECT_EQ(std::string(buffer, text.size() * 2), MemoryToHex(text.data(), text.size()));
+
+    EXPECT_EQ(MemoryToHex(buffer, 7, text.data(), text.size()), 6u);
+    EXPECT_EQ(std::string(buffer, 6), "546865");
+
+    EXPECT_EQ(MemoryToHex(buffer, 0, text.data(), text.size()), 0u);
+}
+
+
+TEST(Memory, MemoryToHexAppend) {
+
+    std::string hex{"0x"};
+    EXPECT_EQ(MemoryToHex(hex, "\xde\xad", 2), 4u);
+    EXPECT_EQ(MemoryToHex(hex, "\xbe\xef", 2), 4u);
+    EXPECT_EQ(hex, "0xdeadbeef");
+
+    EXPECT_EQ(ByteToHex(hex, std::byte{0x13}), 2u);
+    EXPECT_EQ(CharToHex(hex, 0x37), 2u);
+    EXPECT_EQ(hex, "0xdeadbeef1337");
+
+    char buffer[2];
+    EXPECT_EQ(ByteToHex(buffer, sizeof(buffer), std::byte{0xa5}), 2u);
+    EXPECT_EQ(std::string(buffer, 2), "a5");
+    EXPECT_EQ(CharToHex(buffer, 1, 0x5a), 0u);
+}
+
+
+TEST(Memory, HexToMemoryBuffer) {
+
+    std::string_view hex{"deadbeefXX"};
+    std::byte buffer[8];
+
+    EXPECT_EQ(HexToMemory(buffer, sizeof(buffer), hex), 5u);
+    EXPECT_EQ(buffer[0], std::byte{0xde});
+    EXPECT_EQ(buffer[3], std::byte{0xef});
+    EXPECT_EQ(buffer[4], std::byte{0x00});
+
+    EXPECT_EQ(HexToMemory(buffer, 2, hex), 2u);
+    EXPECT_EQ(HexToMemory(buffer, 0, hex), 0u);
+}
+
+
+TEST(Memory, HexToMemoryAppend) {
+
+    std::vector<std::byte> memory{std::byte{0x01}};
+    EXPECT_EQ(HexToMemory(memory, std::string_view{"0203"}), 2u);
+    EXPECT_EQ(HexToMemory(memory, std::string_view{"04"}), 1u);
+    EXPECT_EQ(HexToMemory(memory, std::string_view{""}), 0u);
+    EXPECT_STREQ(MemoryToHex(memory).c_str(), "01020304");
+}
+
+
+TEST(Memory, MemoryToHexParallel) {
+
+    std::vector<std::byte> memory(3 * kParallelMinSize + 17);
+    for (std::size_t i = 0; i < memory.size(); ++i) {
+        memory[i] = static_cast<std::byte>(i * 7u);
+    }
+    auto expected = MemoryToHex(memory);
+
+    for (unsigned int threads : {1u, 2u, 3u}) {
+        ThreadPool pool{threads};
+        EXPECT_EQ(MemoryToHexParallel(memory, pool), expected);
+        EXPECT_EQ(HexToMemoryParallel(expected + "a", pool), memory);
+    }
+
+    EXPECT_EQ(MemoryToHexParallel("\x01\x02", 2), "0102");
+    EXPECT_EQ(HexToMemoryParallel("0102x"), HexToMemory("0102x"));
+}
+
+
 TEST(Memory, CharArrayToMemory) {
 
     auto text = "The quick brown fox jumps over the lazy dog";
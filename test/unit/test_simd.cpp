@@ -0,0 +1,231 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+using namespace headcode::mem;
+
+
+/**
+ * @brief   All SimdLevels supported on this machine.
+ * @return  the supported levels, lowest first
+ */
+static std::vector<SimdLevel> SupportedSimdLevels() {
+    std::vector<SimdLevel> levels;
+    for (unsigned int l = 0; l <= static_cast<unsigned int>(GetSimdLevel()); ++l) {
+        levels.push_back(static_cast<SimdLevel>(l));
+    }
+    return levels;
+}
+
+
+TEST(Simd, LevelNames) {
+    EXPECT_STREQ(SimdLevelToString(SimdLevel::kScalar), "scalar");
+    EXPECT_STREQ(SimdLevelToString(SimdLevel::kSSE2), "SSE2");
+    EXPECT_STREQ(SimdLevelToString(SimdLevel::kSSSE3), "SSSE3");
+    EXPECT_STREQ(SimdLevelToString(SimdLevel::kAVX2), "AVX2");
+    EXPECT_STREQ(SimdLevelToString(SimdLevel::kAVX512VBMI), "AVX512VBMI");
+    EXPECT_EQ(GetSimdLevel(), DetectSimdLevel());
+}
+
+
+TEST(Simd, HexEncodeAllLevels) {
+
+    std::vector<char> memory(1000);
+    for (std::size_t i = 0; i < memory.size(); ++i) {
+        memory[i] = static_cast<char>((i * 7919u) >> 3u);
+    }
+
+    for (std::uint64_t size = 0; size < memory.size(); size += 37) {
+
+        std::string expected(size * 2, '\0');
+        simd::HexEncodeScalar(expected.data(), reinterpret_cast<unsigned char const *>(memory.data()), size);
+
+        for (auto level : SupportedSimdLevels()) {
+            std::string hex(size * 2, '\0');
+            simd::HexEncode(hex.data(), memory.data(), size, level);
+            EXPECT_EQ(hex, expected) << "level: " << SimdLevelToString(level) << ", size: " << size;
+        }
+    }
+}
+
+
+TEST(Simd, HexEncodeAllBytes) {
+
+    std::string memory;
+    for (int i = 0; i < 256; ++i) {
+        memory.push_back(static_cast<char>(i));
+    }
+
+    for (auto level : SupportedSimdLevels()) {
+        std::string hex(memory.size() * 2, '\0');
+        simd::HexEncode(hex.data(), memory.data(), memory.size(), level);
+        for (int i = 0; i < 256; ++i) {
+            EXPECT_EQ(hex.substr(i * 2, 2), CharToHex(static_cast<unsigned char>(i)))
+                    << "level: " << SimdLevelToString(level);
+        }
+    }
+}
+
+
+TEST(Simd, HexDecodeAllLevels) {
+
+    std::string hex;
+    for (int i = 0; i < 500; ++i) {
+        hex += "0123456789abcdefABCDEF"[(i * 7) % 22];
+    }
+
+    for (std::uint64_t size = 0; size < hex.size(); size += 29) {
+
+        std::vector<unsigned char> expected(size / 2);
+        EXPECT_EQ(simd::HexDecodeScalar(expected.data(), hex.data(), size, true), size);
+
+        for (auto level : SupportedSimdLevels()) {
+            std::vector<unsigned char> memory(size / 2);
+            EXPECT_EQ(simd::HexDecode(memory.data(), hex.data(), size, true, level), size);
+            EXPECT_EQ(memory, expected) << "level: " << SimdLevelToString(level) << ", size: " << size;
+        }
+    }
+}
+
+
+TEST(Simd, HexDecodeInvalid) {
+
+    std::string const invalid_chars{"g/:@G`x \xff"};
+
+    for (std::uint64_t position = 0; position < 200; position += 3) {
+        for (auto c : invalid_chars) {
+
+            std::string hex(200, 'e');
+            hex[position] = c;
+            if (position + 50 < hex.size()) {
+                hex[position + 50] = 'z';
+            }
+
+            std::vector<unsigned char> expected(hex.size() / 2);
+            auto expected_invalid = simd::HexDecodeScalar(expected.data(), hex.data(), hex.size(), false);
+            EXPECT_EQ(expected_invalid, position);
+            EXPECT_EQ(expected[position / 2], (position & 1) ? 0xe0 : 0x0e);
+
+            for (auto level : SupportedSimdLevels()) {
+
+                std::vector<unsigned char> memory(hex.size() / 2);
+                EXPECT_EQ(simd::HexDecode(memory.data(), hex.data(), hex.size(), false, level), position);
+                EXPECT_EQ(memory, expected) << "level: " << SimdLevelToString(level);
+
+                EXPECT_EQ(simd::HexDecode(memory.data(), hex.data(), hex.size(), true, level), position)
+                        << "level: " << SimdLevelToString(level);
+            }
+        }
+    }
+}
+
+
+TEST(Simd, HexDecodeInvalidStrict) {
+
+    // strict decoding writes all pairs before the first invalid char, as the scalar version does
+    for (std::uint64_t position = 0; position < 200; ++position) {
+
+        std::string hex;
+        for (int i = 0; i < 200; ++i) {
+            hex += "0123456789abcdefABCDEF"[(i * 7) % 22];
+        }
+        hex[position] = 'g';
+
+        std::vector<unsigned char> expected(hex.size() / 2, 0xaa);
+        EXPECT_EQ(simd::HexDecodeScalar(expected.data(), hex.data(), hex.size(), true), position);
+
+        for (auto level : SupportedSimdLevels()) {
+            std::vector<unsigned char> memory(hex.size() / 2, 0xaa);
+            EXPECT_EQ(simd::HexDecode(memory.data(), hex.data(), hex.size(), true, level), position);
+            EXPECT_EQ(memory, expected) << "level: " << SimdLevelToString(level) << ", position: " << position;
+        }
+    }
+}
+
+
+/**
+ * @brief   Checks simd::ByteSwap on all levels against reversing the items one by one, copying and in place.
+ */
+template <std::uint64_t Width>
+static void CheckByteSwap() {
+
+    std::vector<char> memory(1000 * Width);
+    for (std::size_t i = 0; i < memory.size(); ++i) {
+        memory[i] = static_cast<char>((i * 7919u) >> 3u);
+    }
+
+    for (std::uint64_t count = 0; count < 1000; count += 37) {
+
+        // the items start at an odd address
+        std::vector<char> expected(memory.begin() + 1, memory.begin() + 1 + count * Width);
+        for (std::uint64_t i = 0; i < count; ++i) {
+            std::reverse(expected.begin() + i * Width, expected.begin() + (i + 1) * Width);
+        }
+
+        for (auto level : SupportedSimdLevels()) {
+            std::vector<char> swapped(count * Width + 1);
+            simd::ByteSwap<Width>(swapped.data() + 1, memory.data() + 1, count, level);
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), swapped.begin() + 1))
+                    << "level: " << SimdLevelToString(level) << ", width: " << Width << ", count: " << count;
+
+            std::vector<char> in_place(memory.begin(), memory.begin() + 1 + count * Width);
+            simd::ByteSwap<Width>(in_place.data() + 1, in_place.data() + 1, count, level);
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), in_place.begin() + 1))
+                    << "level: " << SimdLevelToString(level) << ", width: " << Width << ", count: " << count;
+        }
+    }
+}
+
+
+TEST(Simd, ByteSwapAllLevels) {
+    CheckByteSwap<2>();
+    CheckByteSwap<4>();
+    CheckByteSwap<8>();
+}
+
+
+TEST(Simd, ByteSwapNumbers) {
+
+    std::vector<double> doubles{1.5, -0.25, 1e300, 3.0, -7.0};
+    std::vector<std::uint64_t> bits(doubles.size());
+    std::vector<float> floats{1.5f, -0.25f, 1e30f, 3.0f, -7.0f};
+    std::vector<std::uint32_t> bits32(floats.size());
+
+    for (auto level : SupportedSimdLevels()) {
+        auto swapped = doubles;
+        auto data = reinterpret_cast<char *>(swapped.data());
+        simd::ByteSwap<sizeof(double)>(data, data, swapped.size(), level);
+        std::memcpy(bits.data(), swapped.data(), bits.size() * sizeof(double));
+        for (std::size_t i = 0; i < doubles.size(); ++i) {
+            std::uint64_t original;
+            std::memcpy(&original, &doubles[i], sizeof(original));
+            EXPECT_EQ(bits[i], simd::ByteSwap(original));
+        }
+        simd::ByteSwap<sizeof(double)>(data, data, swapped.size(), level);
+        EXPECT_EQ(swapped, doubles);
+
+        auto swapped_floats = floats;
+        auto data_floats = reinterpret_cast<char *>(swapped_floats.data());
+        simd::ByteSwap<sizeof(float)>(data_floats, data_floats, swapped_floats.size(), level);
+        std::memcpy(bits32.data(), swapped_floats.data(), bits32.size() * sizeof(float));
+        for (std::size_t i = 0; i < floats.size(); ++i) {
+            std::uint32_t original;
+            std::memcpy(&original, &floats[i], sizeof(original));
+            EXPECT_EQ(bits32[i], simd::ByteSwap(original));
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * This file is part of the headcode.space mem.
+ *
+ * The 'LICENSE.txt' file in the project root holds the software license.
+ * Copyright (C) 2020-2021 headcode.space e.U.  
+ * Oliver Maurhart <info@headcode.space>, https://www.headcode.space
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <headcode/mem/mem.hpp>
+
+using namespace headcode::mem;
+
+
+TEST(ThreadPool, RunAllTasks) {
+
+    for (unsigned int threads : {1u, 2u, 5u}) {
+
+        ThreadPool pool{threads};
+        EXPECT_EQ(pool.GetThreads(), threads);
+
+        for (std::uint64_t count : {0u, 1u, 3u, 1000u}) {
+            std::vector<std::atomic<int>> done(count);
+            pool.Run(count, [&](std::uint64_t i) { done[i]++; });
+            for (auto const & d : done) {
+                EXPECT_EQ(d, 1);
+            }
+        }
+    }
+}
+
+
+TEST(ThreadPool, DefaultThreads) {
+    ThreadPool pool;
+    EXPECT_EQ(pool.GetThreads(), std::max(std::thread::hardware_concurrency(), 1u));
+    EXPECT_GE(GetDefaultThreadPool().GetThreads(), 1u);
+}
+
+
+TEST(ThreadPool, ConcurrentRun) {
+
+    ThreadPool pool{3};
+    std::atomic<std::uint64_t> sum{0};
+
+    std::vector<std::thread> callers;
+    for (int c = 0; c < 4; ++c) {
+        callers.emplace_back([&] {
+            for (int r = 0; r < 50; ++r) {
+                pool.Run(10, [&](std::uint64_t i) { sum += i; });
+            }
+        });
+    }
+    for (auto & caller : callers) {
+        caller.join();
+    }
+
+    EXPECT_EQ(sum, 4u * 50u * 45u);
+}
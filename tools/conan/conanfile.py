@@ -31,3 +31,6 @@ class HcsMemConan(ConanFile):
 
     def package_id(self):
         self.info.header_only()
+
+    def package_info(self):
+        self.cpp_info.system_libs = ["pthread"]